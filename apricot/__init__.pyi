@@ -4,9 +4,23 @@ and mypy is unable to extract type information from this, we need
 to provide typing stubs so we can get MyPy type-checking in the
 rest of the codebase.
 """
+from typing import List, Optional, Tuple, overload
+
 import numpy as np
 
 
+def seed(seed: int) -> None:
+    ...
+
+
+def embedded_tables() -> List[str]:
+    ...
+
+
+def embedded_table(name: str) -> Optional[np.ndarray]:
+    ...
+
+
 class Earth:
     ...
 
@@ -16,18 +30,155 @@ class SphericalEarth(Earth):
         ...
 
 
-class ExponentialAtmosphere:
-    ...
+class Atmosphere:
+    def depth(self, altitude: np.ndarray) -> np.ndarray:
+        ...
+
+    def altitude(self, depth: np.ndarray) -> np.ndarray:
+        ...
+
+    def analytic(self) -> bool:
+        ...
+
+    @property
+    def revision(self) -> int:
+        ...
+
+
+class ExponentialAtmosphere(Atmosphere):
+    def __init__(self, rho0: float = 1.225e-3, T: float = 273):
+        ...
+
+    def density(self, altitude: np.ndarray) -> np.ndarray:
+        ...
+
+
+class LinsleyAtmosphere(Atmosphere):
+    def __init__(self, model: str = "us-standard"):
+        ...
+
+    def density(self, altitude: np.ndarray) -> np.ndarray:
+        ...
+
+    @property
+    def top(self) -> float:
+        ...
+
+
+class SoundingAtmosphere(Atmosphere):
+    def __init__(self, filename: str):
+        ...
+
+    def density(self, altitude: np.ndarray) -> np.ndarray:
+        ...
+
+    def set_time(self, time: float, interpolate: bool = True) -> None:
+        ...
+
+    @property
+    def time(self) -> float:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+
+class SlantDepthTable:
+    def __init__(
+        self,
+        atmosphere: Atmosphere,
+        radius: float = 6356.752,
+        nheights: int = 301,
+        nzeniths: int = 101,
+    ):
+        ...
+
+    def depth(self, altitude: np.ndarray, zenith: np.ndarray) -> np.ndarray:
+        ...
+
+    def distance(
+        self, altitude: np.ndarray, zenith: np.ndarray, grammage: np.ndarray
+    ) -> np.ndarray:
+        ...
+
+    def integrate(self, altitude: np.ndarray, zenith: np.ndarray) -> np.ndarray:
+        ...
+
+    @property
+    def error(self) -> float:
+        ...
+
+    @property
+    def stale(self) -> bool:
+        ...
+
+    def rebuild(self) -> None:
+        ...
+
+
+class DensityModel:
+    def density(self, radius: float, r_earth: float) -> float:
+        ...
+
+    def column(self, r0: float, r1: float, r_earth: float) -> float:
+        ...
+
+
+class LayeredDensity(DensityModel):
+    def __init__(self, filename: str):
+        ...
+
+
+class FirnDensity(DensityModel):
+    def __init__(
+        self,
+        thickness: float,
+        surface: float,
+        scale: float,
+        ice: float,
+        background: Optional[DensityModel],
+    ):
+        ...
+
+
+class VoxelDensity:
+    def __init__(self, filename: str):
+        ...
+
+    def density(self, location: np.ndarray) -> float:
+        ...
+
+    def walk(
+        self,
+        location: np.ndarray,
+        direction: np.ndarray,
+        grammage: float = np.inf,
+        length: float = np.inf,
+    ) -> Tuple[float, np.ndarray]:
+        ...
 
 
 class Source:
-    ...
+    def solid_angle(self) -> float:
+        ...
 
 
 class SphericalCapSource(Source):
+    @overload
     def __init__(self, radius: float, theta: float, center: float):
         ...
 
+    @overload
+    def __init__(
+        self,
+        target: np.ndarray,
+        cone: float,
+        radius: float,
+        theta: float,
+        center: float,
+    ):
+        ...
+
 
 class Flux:
     ...
@@ -41,6 +192,109 @@ class UniformFlux(Flux):
     ...
 
 
+class SpectrumTable:
+    @overload
+    def __init__(self, energies: List[float], flux: List[float]):
+        ...
+
+    @overload
+    def __init__(self, filename: str):
+        ...
+
+    def sample(self) -> float:
+        ...
+
+    def flux(self, energy: np.ndarray) -> np.ndarray:
+        ...
+
+    @property
+    def integral(self) -> float:
+        ...
+
+    @property
+    def min_energy(self) -> float:
+        ...
+
+    @property
+    def max_energy(self) -> float:
+        ...
+
+
+class TabulatedFlux(Flux):
+    @property
+    def spectrum(self) -> SpectrumTable:
+        ...
+
+
+class PowerLawFlux(Flux):
+    @overload
+    def __init__(self, index: float, min_energy: float, max_energy: float):
+        ...
+
+    @overload
+    def __init__(self, energies: List[float], indices: List[float]):
+        ...
+
+    @property
+    def index(self) -> float:
+        ...
+
+    @property
+    def min_energy(self) -> float:
+        ...
+
+    @property
+    def max_energy(self) -> float:
+        ...
+
+    @property
+    def energies(self) -> List[float]:
+        ...
+
+    @property
+    def indices(self) -> List[float]:
+        ...
+
+    def pdf(self, energy: np.ndarray) -> np.ndarray:
+        ...
+
+    def weight(self, energy: np.ndarray) -> np.ndarray:
+        ...
+
+
+BrokenPowerLawFlux = PowerLawFlux
+
+
+class CompositeFlux(Flux):
+    @overload
+    def __init__(self, fluxes: List[Flux], fractions: List[float]):
+        ...
+
+    @overload
+    def __init__(self, spectrum: Flux, species: List[int], fractions: List[float]):
+        ...
+
+    @overload
+    def __init__(
+        self,
+        spectrum: Flux,
+        species: List[int],
+        energies: List[float],
+        fractions: List[List[float]],
+    ):
+        ...
+
+    @staticmethod
+    def neutrinos(spectrum: Flux, ratios: List[float] = [1.0, 1.0, 1.0]) -> "CompositeFlux":
+        ...
+
+    def fraction(self, component: np.ndarray, energy: np.ndarray) -> np.ndarray:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+
 class Detector:
     ...
 
@@ -54,17 +308,111 @@ class OrbitalDetector(Detector):
         ...
 
 
+class PhysicsConfig:
+    def __init__(
+        self,
+        cross_section_model: Optional[object] = None,
+        y_factor_model: Optional[object] = None,
+        energy_loss_model: Optional[object] = None,
+    ):
+        ...
+
+    @staticmethod
+    def global_config() -> "PhysicsConfig":
+        ...
+
+    cross_section_model: str
+    y_factor_model: object
+    energy_loss_model: object
+
+
 class Propagator:
-    ...
+    physics: PhysicsConfig
 
 
 class SimplePropagator(Propagator):
-    def __init__(self, earth: Earth):
+    def __init__(self, earth: Earth, taus: bool = False, muons: bool = False):
+        ...
+
+    @property
+    def taus(self) -> bool:
+        ...
+
+    @property
+    def muons(self) -> bool:
+        ...
+
+    def propagate(self, source: Source, flux: Flux, detector: Detector, ntrials: int):
+        ...
+
+
+class UHECRPropagator(Propagator):
+    def __init__(self, earth: Earth, table: Optional[SlantDepthTable] = None):
+        ...
+
+    def propagate(self, source: Source, flux: Flux, detector: Detector, ntrials: int):
+        ...
+
+    @property
+    def table(self) -> SlantDepthTable:
+        ...
+
+
+class TauExitTable:
+    @overload
+    def __init__(
+        self,
+        earth: Earth,
+        emin: float,
+        emax: float,
+        nenergies: int,
+        angles: List[float],
+        ntrials: int,
+        nthreads: int = 0,
+    ):
+        ...
+
+    @overload
+    def __init__(self, filename: str):
+        ...
+
+    def save(self, filename: str) -> None:
+        ...
+
+    def probability(self, energy: np.ndarray, angle: np.ndarray) -> np.ndarray:
+        ...
+
+    def sample(self, energy: float, angle: float) -> Optional[float]:
+        ...
+
+    @property
+    def emin(self) -> float:
+        ...
+
+    @property
+    def emax(self) -> float:
+        ...
+
+    @property
+    def nenergies(self) -> int:
+        ...
+
+    @property
+    def angles(self) -> List[float]:
+        ...
+
+
+class TauExitPropagator(Propagator):
+    def __init__(self, earth: Earth, table: TauExitTable):
         ...
 
     def propagate(self, source: Source, flux: Flux, detector: Detector, ntrials: int):
         ...
 
+    @property
+    def table(self) -> TauExitTable:
+        ...
+
 
 class Interaction:
     pdgid: int
@@ -73,4 +421,5 @@ class Interaction:
     location: np.ndarray
     direction: np.ndarray
     weight: float
+    generation_weight: float
     altitude: float
@@ -12,6 +12,11 @@ We choose events from the full 4pi steradians - events that propagate
 away from the Earth are automatically cut. We then use the number
 of detected events to estimate the geometric acceptance.
 
+If a `cone` angle is given, directions are instead only chosen within
+this angle of the vector to ANITA, and the acceptance is scaled by the
+(smaller) solid angle of the cone. The cone must be wide enough to
+contain every detectable trajectory.
+
 """
 from typing import Optional, Union
 
@@ -36,6 +41,7 @@ def propagate(
     altitude: float,
     maxview: float,
     mode: str,
+    cone: Optional[float] = None,
     **kwargs,
 ) -> None:
     """
@@ -63,6 +69,9 @@ def propagate(
         The maximum detectable view angle in degrees.
     mode: str
         Whether to simulate 'direct', 'reflected', or 'both' event types.
+    cone: Optional[float]
+        The optional half-angle [degrees] of the cone of directions
+        around the vector to the payload. By default, all directions are used.
 
     Returns
     -------
@@ -93,9 +102,19 @@ def propagate(
     source_altitude = 150.0
 
     # we pick particles on a cap 100km above the surface
-    source = apricot.SphericalCapSource(
-        radius=Re + source_altitude, theta=theta, center=np.pi
-    )
+    if cone is None:
+        source = apricot.SphericalCapSource(
+            radius=Re + source_altitude, theta=theta, center=np.pi
+        )
+    else:
+        # with directions only pointing close to the payload
+        source = apricot.SphericalCapSource(
+            target=payload,
+            cone=np.radians(cone),
+            radius=Re + source_altitude,
+            theta=theta,
+            center=np.pi,
+        )
 
     # create a flux model that just creates (10^19) cosmic ray protons.
     flux = parsing.create_flux(particle, min_energy, max_energy, fixed_energy)
@@ -107,8 +126,8 @@ def propagate(
     # is at least as high as the source altitude
     detector.maxalt = source_altitude + 1e-3
 
-    # create a simple propagator
-    propagator = apricot.SimplePropagator(earth)
+    # create a propagator that solves for shower max directly
+    propagator = apricot.UHECRPropagator(earth)
 
     # and propagate a single particle
     interactions = propagator.propagate(source, flux, detector, ntrials)
@@ -136,6 +155,7 @@ def propagate(
         "maxview": maxview,
         "Re": Re,
         "area": area,
+        "solid_angle": source.solid_angle(),
         "maxtheta": theta,
         "source_altitude": source_altitude,
     }
@@ -182,8 +202,11 @@ def geometric_acceptance(
     # the area that we drew the particles from.
     A = np.mean(parameters.area)
 
-    # the solid angle we drew the particles from
-    Omega = 4 * np.pi
+    # the solid angle we drew the particles from (older files used 4pi)
+    if "solid_angle" in parameters:
+        Omega = np.mean(parameters.solid_angle)
+    else:
+        Omega = 4 * np.pi
 
     # and the total number of particles that we flew
     ntrials = parameters.ntrials
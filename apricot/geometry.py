@@ -9,16 +9,22 @@ import pandas as pd
 import _apricot
 import _apricot.geometry
 from _apricot.geometry import (
+    from_geodetic,
+    payload_view,
     propagate_to_sphere,
     random_cap_point,
     random_spherical_point,
     reflect_below,
     spherical_cap_area,
+    to_cartesian,
+    to_enu,
+    to_geodetic,
+    to_spherical,
 )
 
 
 def latlon(
-    events: pd.DataFrame, inplace: bool = False
+    events: pd.DataFrame, inplace: bool = False, geodetic: bool = False
 ) -> Union[np.ndarray, pd.DataFrame]:
     """
     Calculate the latitude and longitude of each event.
@@ -29,6 +35,8 @@ def latlon(
         The loaded apricot events.
     inplace: bool
         If True, add the columns to the DataFrame.
+    geodetic: bool
+        If True, return WGS84 geodetic (instead of geocentric) latitudes.
 
     Returns
     -------
@@ -36,17 +44,20 @@ def latlon(
         A (N, 2) array containing latitude and longitude [degrees].
     """
 
-    # compute the radius of these events
-    radius = np.linalg.norm(get_locations(events), axis=1)
-
-    # and the longitude
-    longitude = np.degrees(np.arctan2(events["location.y"], events["location.x"]))
+    # get the locations of each event
+    locations = get_locations(events)
 
-    # and compute the polar theta
-    theta = np.arccos(events["location.z"] / radius)
+    if geodetic:
+        # convert directly into (latitude, longitude, height)
+        coords = to_geodetic(locations)
+        latitude, longitude = coords[:, 0], coords[:, 1]
+    else:
+        # convert to (r, theta, phi)
+        spherical = to_spherical(locations)
 
-    # and convert this into a latitude
-    latitude = np.degrees(np.pi / 2.0 - theta)
+        # and convert the polar theta into a latitude
+        latitude = 90.0 - np.degrees(spherical[:, 1])
+        longitude = np.degrees(spherical[:, 2])
 
     # if we want this in-place, we add the columns
     if inplace:
@@ -98,18 +109,11 @@ def payload_elevation(
     else:
         locations = get_locations(events)
 
-    # get the vector from the payload to the interaction
-    view = locations - payload
-
-    # normalize the view vector
-    view /= np.linalg.norm(view, axis=1).reshape((-1, 1))
-
-    # and compute the dot product between view and payload
-    dot = np.einsum("ij,ij->i", payload / np.linalg.norm(payload, axis=1), view)
+    # compute the (elevation, azimuth) of each interaction from the payload
+    view = payload_view(locations, payload[0])
 
-    # and convert this into an angle in degrees and map
-    # so that the horizon is at 0 degrees
-    angle = np.degrees(np.pi / 2.0 - np.arccos(dot))
+    # and extract the elevation angle w.r.t the payload horizon
+    angle = view[:, 0]
 
     # we now calculate the off-axis view angles
     # for each of these events
@@ -128,6 +132,7 @@ def payload_elevation(
     # if we have inplace, add it to the DataFrame
     if inplace:
         events["elevation"] = angle
+        events["azimuth"] = view[:, 1]
         events["backwards"] = backward
 
     # otherwise, just return the angle's
@@ -55,6 +55,7 @@ def to_file(
     energy = np.zeros(N, dtype=np.float64)
     itype = np.zeros(N, dtype=np.int32)
     weight = np.zeros(N, dtype=np.float64)
+    generation_weight = np.zeros(N, dtype=np.float64)
     altitude = np.zeros(N, dtype=np.float64)
 
     # arrays to store the locations and directions
@@ -78,6 +79,7 @@ def to_file(
             location[i, :] = event.location
             direction[i, :] = event.direction
             weight[i] = event.weight
+            generation_weight[i] = event.generation_weight
             altitude[i] = event.altitude
 
             # and increment our array index
@@ -99,6 +101,7 @@ def to_file(
             "direction.y": np.float64,
             "direction.z": np.float64,
             "weight": np.float64,
+            "generation_weight": np.float64,
             "altitude": np.float64,
         }
 
@@ -119,6 +122,7 @@ def to_file(
                 "direction.y": direction[:, 1],
                 "direction.z": direction[:, 2],
                 "weight": weight,
+                "generation_weight": generation_weight,
                 "altitude": altitude,
             }
         )
@@ -0,0 +1,99 @@
+# Convert apricot's numeric data tables into compiled-in constexpr arrays.
+#
+# This is run as a script at build time:
+#
+#     cmake -DDATA_ROOT=<data/> -DOUTPUT=<EmbeddedTables.inc> -P EmbedData.cmake
+#
+# Every `.dat` file under DATA_ROOT/particles and DATA_ROOT/calibration
+# that is a table of numbers (with `#` comments) becomes a
+# `constexpr double` array and an entry in the `EMBEDDED` table list,
+# named by its path relative to DATA_ROOT. A first row with a
+# different number of columns (the NuTauSim header) is skipped. Files
+# that are not numeric tables, or are git-lfs pointers that have not
+# been fetched, are not embedded.
+
+# find every data table
+file(GLOB_RECURSE FILES RELATIVE ${DATA_ROOT}
+  ${DATA_ROOT}/particles/*.dat
+  ${DATA_ROOT}/calibration/*.dat)
+list(SORT FILES)
+
+# the generated arrays and the entries of the table list
+set(ARRAYS "")
+set(ENTRIES "")
+set(COUNT 0)
+
+# the whole file is processed with regular expressions, rather than
+# line-by-line, as list operations in CMake are far too slow for
+# tables with millions of rows.
+foreach(FILE ${FILES})
+
+  # read the whole file
+  file(READ ${DATA_ROOT}/${FILE} CONTENT)
+
+  # skip git-lfs pointers
+  if ("${CONTENT}" MATCHES "^version https://git-lfs")
+    message(STATUS "Not embedding ${FILE} (git-lfs pointer)")
+    continue()
+  endif()
+
+  # strip comments, separate values by one space, and remove empty lines
+  string(REGEX REPLACE "#[^\n]*" "" CONTENT "${CONTENT}")
+  string(REGEX REPLACE "[ \t\r,]+" " " CONTENT "${CONTENT}")
+  string(REGEX REPLACE " *\n[ \n]*" "\n" CONTENT "${CONTENT}")
+  string(STRIP "${CONTENT}" CONTENT)
+
+  # skip anything that is not a numeric table
+  if ("${CONTENT}" STREQUAL "" OR "${CONTENT}" MATCHES "[^-+.0-9eE \n]")
+    message(STATUS "Not embedding ${FILE} (not a numeric table)")
+    continue()
+  endif()
+
+  # the number of values in the first two rows
+  string(REGEX MATCH "^[^\n]*" HEAD "${CONTENT}")
+  string(REGEX MATCHALL "[^ ]+" FIELDS "${HEAD}")
+  list(LENGTH FIELDS NHEAD)
+  set(NCOLUMNS ${NHEAD})
+  if ("${CONTENT}" MATCHES "^[^\n]*\n([^\n]*)")
+    string(REGEX MATCHALL "[^ ]+" FIELDS "${CMAKE_MATCH_1}")
+    list(LENGTH FIELDS NCOLUMNS)
+  endif()
+
+  # skip a header row with a different number of columns
+  if (NOT NHEAD EQUAL NCOLUMNS)
+    string(FIND "${CONTENT}" "\n" END)
+    math(EXPR END "${END} + 1")
+    string(SUBSTRING "${CONTENT}" ${END} -1 CONTENT)
+  endif()
+
+  # check that every row has the same number of columns
+  string(REGEX REPLACE "[^ \n]+" "x" SHAPE "${CONTENT}\n")
+  string(REPEAT "x " ${NCOLUMNS} ROW)
+  string(REGEX REPLACE " $" "\n" ROW "${ROW}")
+  string(REPLACE "${ROW}" "" SHAPE "${SHAPE}")
+  if (NOT "${SHAPE}" STREQUAL "")
+    message(FATAL_ERROR "${FILE} has rows with different numbers of columns.")
+  endif()
+
+  # the number of rows in the table
+  string(REGEX MATCHALL "\n" NEWLINES "${CONTENT}\n")
+  list(LENGTH NEWLINES NROWS)
+
+  # and add the array and its entry
+  string(REPLACE " " ", " CONTENT "${CONTENT}")
+  string(REPLACE "\n" ",\n    " CONTENT "${CONTENT}")
+  string(APPEND ARRAYS "  // ${FILE}\n  constexpr double TABLE${COUNT}[]{\n    ${CONTENT}};\n\n")
+  string(APPEND ENTRIES
+    "    EmbeddedTable{\"${FILE}\", TABLE${COUNT}, ${NROWS}, ${NCOLUMNS}},\n")
+  message(STATUS "Embedding ${FILE} (${NROWS} x ${NCOLUMNS})")
+  math(EXPR COUNT "${COUNT} + 1")
+
+endforeach()
+
+# and write the generated file - only if it changed to avoid rebuilds
+set(CONTENT "// Generated by cmake/EmbedData.cmake - do not edit.\n\n${ARRAYS}")
+string(APPEND CONTENT
+  "  constexpr std::array<EmbeddedTable, ${COUNT}> EMBEDDED{{\n${ENTRIES}  }};\n")
+file(WRITE ${OUTPUT}.tmp "${CONTENT}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A discrete distribution that can be sampled in constant time.
+   *
+   * This is Walker's alias method (with Vose's construction). The
+   * table is built once in O(n) and each sample is one uniform
+   * random number: its integer part picks a column and its
+   * fractional part picks between the column and its alias.
+   */
+  class AliasTable final {
+
+    std::vector<double> probability_; ///< The probability of keeping each column.
+    std::vector<std::size_t> alias_;  ///< The alias of each column.
+    std::vector<double> weights_;     ///< The normalized weight of each outcome.
+
+    public:
+    /**
+     * Build a table from the (relative) weight of each outcome.
+     *
+     * @param weights    The non-negative weights; at least one must be positive.
+     */
+    AliasTable(const std::vector<double>& weights);
+
+    /**
+     * Sample a random outcome.
+     */
+    auto
+    sample() const -> std::size_t;
+
+    /**
+     * The probability of an outcome.
+     *
+     * @param i    The outcome.
+     */
+    auto
+    probability(const std::size_t i) const -> double {
+      return weights_.at(i);
+    }
+
+    /**
+     * The number of outcomes.
+     */
+    auto
+    size() const -> std::size_t {
+      return weights_.size();
+    }
+
+  }; // END: class AliasTable
+
+} // namespace apricot
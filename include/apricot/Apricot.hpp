@@ -12,4 +12,9 @@ namespace apricot {
    */
   using ParticleID = int;
 
+  /**
+   * An alias for an Earth material ID.
+   */
+  using MaterialID = int;
+
 } // namespace apricot
@@ -1,14 +1,25 @@
 #pragma once
 
+#include <cstddef>
+
 namespace apricot {
 
   /**
    * A pure base class for atmospheric models.
    *
+   * Derived models must provide the density. The vertical depth
+   * and its inverse are integrated numerically by default; models
+   * that can compute them in closed form should override them and
+   * `analytic` so that propagators can take large steps in air.
    */
   class Atmosphere {
 
     public:
+    /**
+     * The altitude of the top of the atmosphere for numerical depths [km].
+     */
+    static constexpr double TOP{150.};
+
     /**
      * The density of the atmosphere at a given altitude.
      *
@@ -19,6 +30,53 @@ namespace apricot {
      */
     virtual auto
     density(const double altitude) const -> double = 0;
-  };
+
+    /**
+     * The vertical depth of the atmosphere above a given altitude.
+     *
+     * This is the density integrated from `altitude` to the top of
+     * the atmosphere and is returned in g/cm^2.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    virtual auto
+    depth(const double altitude) const -> double;
+
+    /**
+     * The altitude at which the vertical depth reaches a given value.
+     *
+     * This is the inverse of `depth`.
+     *
+     * @param depth   The vertical depth [g/cm^2].
+     */
+    virtual auto
+    altitude(const double depth) const -> double;
+
+    /**
+     * True if `depth` and `altitude` are computed in closed form.
+     */
+    virtual auto
+    analytic() const -> bool {
+      return false;
+    }
+
+    /**
+     * A counter that changes whenever the density profile changes.
+     *
+     * Tables that are built from an atmosphere (i.e. `SlantDepthTable`)
+     * record this so that they can detect that they are out of date.
+     * This is zero for atmospheres that never change.
+     */
+    virtual auto
+    revision() const -> std::size_t {
+      return 0;
+    }
+
+    /**
+     * A default virtual destructor.
+     */
+    virtual ~Atmosphere() = default;
+
+  }; // END: class Atmosphere
 
 } // namespace apricot
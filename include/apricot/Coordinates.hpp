@@ -36,11 +36,55 @@ namespace apricot {
    */
   using Vectors = Eigen::Matrix<double, Eigen::Dynamic, 3>;
 
+  /**
+   * An alias for many geodetic coordinates.
+   *
+   * Each row is (latitude [degrees], longitude [degrees], height [km]).
+   */
+  using GeodeticCoordinates = Eigen::Matrix<double, Eigen::Dynamic, 3>;
+
+  /**
+   * A read-only view of many coordinates with arbitrary strides.
+   *
+   * This can wrap Eigen matrices, blocks, and (N, 3) NumPy arrays
+   * of either memory layout without copying.
+   */
+  using CoordinatesView = Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, 3>,
+                                     0,
+                                     Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
   /**
    * An alias for an array of scalar values.
    */
   using Array = Eigen::ArrayXd;
 
+  /**
+   * The parameters of the WGS84 reference ellipsoid.
+   */
+  namespace wgs84 {
+
+    /**
+     * The semi-major (equatorial) axis [km].
+     */
+    constexpr double A{6378.137};
+
+    /**
+     * The flattening of the ellipsoid.
+     */
+    constexpr double F{1. / 298.257223563};
+
+    /**
+     * The semi-minor (polar) axis [km].
+     */
+    constexpr double B{A * (1. - F)};
+
+    /**
+     * The square of the first eccentricity.
+     */
+    constexpr double E2{F * (2. - F)};
+
+  } // namespace wgs84
+
   /**
    * Convert degrees to radians.
    *
@@ -112,4 +156,74 @@ namespace apricot {
     return CartesianCoordinate(x, y, z);
   }
 
+  /**
+   * Convert many cartesian coordinates to spherical coordinates.
+   *
+   * Each row of the output is (r, theta, phi) where theta is the
+   * polar angle from +z and phi = atan2(y, x) is in [-pi, pi]
+   * (unlike the scalar `to_spherical` which uses atan(y / x)).
+   *
+   * @param locations   An (N, 3) array of cartesian coordinates.
+   */
+  auto
+  to_spherical_batch(const CoordinatesView& locations) -> SphericalCoordinates;
+
+  /**
+   * Convert many spherical coordinates to cartesian coordinates.
+   *
+   * @param locations   An (N, 3) array of (r, theta, phi) coordinates.
+   */
+  auto
+  to_cartesian_batch(const CoordinatesView& locations) -> CartesianCoordinates;
+
+  /**
+   * Convert many geocentric coordinates to WGS84 geodetic coordinates.
+   *
+   * This uses the exact, non-iterative solution of Heikkinen (1982)
+   * which is valid everywhere except within ~45 km of the center
+   * of the Earth.
+   *
+   * @param locations   An (N, 3) array of geocentric coordinates [km].
+   */
+  auto
+  to_geodetic(const CoordinatesView& locations) -> GeodeticCoordinates;
+
+  /**
+   * Convert many WGS84 geodetic coordinates to geocentric coordinates.
+   *
+   * @param locations   An (N, 3) array of (latitude, longitude, height).
+   */
+  auto
+  from_geodetic(const CoordinatesView& locations) -> CartesianCoordinates;
+
+  /**
+   * Convert many geocentric coordinates into a local East-North-Up frame.
+   *
+   * The frame is centered at `origin`. If `geodetic` is true, "up"
+   * is the normal to the WGS84 ellipsoid at `origin`; otherwise "up"
+   * is the geocentric radial direction (i.e. a spherical Earth).
+   *
+   * @param locations   An (N, 3) array of geocentric coordinates [km].
+   * @param origin      The geocentric origin of the local frame [km].
+   * @param geodetic    Use the ellipsoidal (true) or radial (false) vertical.
+   */
+  auto
+  to_enu(const CoordinatesView& locations,
+         const CartesianCoordinate& origin,
+         const bool geodetic = true) -> CartesianCoordinates;
+
+  /**
+   * The elevation and azimuth of many locations as seen from a payload.
+   *
+   * Each row of the output is (elevation, azimuth) in degrees where
+   * the elevation is measured from the payload's (radial) horizontal
+   * and the azimuth is measured from north towards east.
+   *
+   * @param locations   An (N, 3) array of geocentric coordinates [km].
+   * @param payload     The geocentric location of the payload [km].
+   */
+  auto
+  payload_view(const CoordinatesView& locations, const CartesianCoordinate& payload)
+      -> Eigen::Matrix<double, Eigen::Dynamic, 2>;
+
 } // namespace apricot
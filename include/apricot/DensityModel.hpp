@@ -0,0 +1,158 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include <string>
+
+namespace apricot {
+
+  /*
+   * Various standard Earth materials.
+   */
+  namespace materials {
+
+    /**
+     * Outside of any material.
+     */
+    static constexpr MaterialID Vacuum = 0;
+
+    /**
+     * The inner and outer core.
+     */
+    static constexpr MaterialID Core = 1;
+
+    /**
+     * The upper and lower mantle.
+     */
+    static constexpr MaterialID Mantle = 2;
+
+    /**
+     * Crustal rock.
+     */
+    static constexpr MaterialID Rock = 3;
+
+    /**
+     * Liquid water.
+     */
+    static constexpr MaterialID Water = 4;
+
+    /**
+     * Solid (glacial) ice.
+     */
+    static constexpr MaterialID Ice = 5;
+
+    /**
+     * Compacting snow above solid ice.
+     */
+    static constexpr MaterialID Firn = 6;
+
+    /**
+     * Unconsolidated sediment.
+     */
+    static constexpr MaterialID Sediment = 7;
+
+    /**
+     * The atmosphere.
+     */
+    static constexpr MaterialID Air = 8;
+
+  } // namespace materials
+
+  /**
+   * Convert a material name ("rock", "ice", ...) to a MaterialID.
+   *
+   * @param name    The lower-case name of the material.
+   *
+   * @returns material   The corresponding MaterialID.
+   */
+  auto
+  material_from_string(const std::string& name) -> MaterialID;
+
+  /**
+   * A pure base class for radial Earth density models.
+   *
+   * Density models describe the bulk of the Earth (below the
+   * surface) as a function of the radius normalized to the
+   * radius of the Earth along the geocentric vector to the
+   * sample location. This is the same convention used by PREM.
+   */
+  class DensityModel {
+
+    public:
+    /**
+     * The density (in g/cm^3) at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    virtual auto
+    density(const double radius, const double Rearth) const -> double = 0;
+
+    /**
+     * The material at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    virtual auto
+    material(const double radius, const double Rearth) const -> MaterialID = 0;
+
+    /**
+     * The radial column density between two radii.
+     *
+     * This returns the integral of the density from `r0` to `r1`
+     * in g/cm^3 * km (negative if r1 < r0). The default implementation
+     * uses a three-point Gauss-Legendre rule (see `integrate`); models
+     * that can do better should override this and `analytic`.
+     *
+     * @param r0        The starting radius [km].
+     * @param r1        The final radius [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    virtual auto
+    column(const double r0, const double r1, const double Rearth) const -> double;
+
+    /**
+     * True if `column` is exact for this model.
+     *
+     * When this is true, the propagator integrates the grammage of
+     * each step with `column` and can take much larger steps.
+     */
+    virtual auto
+    analytic() const -> bool {
+      return false;
+    }
+
+    /**
+     * A virtual destructor.
+     */
+    virtual ~DensityModel() = default;
+
+    protected:
+    /**
+     * Integrate a radial density profile with a three-point Gauss-Legendre rule.
+     *
+     * This is exact for polynomial profiles up to fifth order.
+     *
+     * @param density   A callable returning the density at a radius.
+     * @param r0        The starting radius [km].
+     * @param r1        The final radius [km].
+     */
+    template <typename Function>
+    static auto
+    integrate(const Function& density, const double r0, const double r1) -> double {
+
+      // the center and half-width of the interval
+      const auto center{0.5 * (r1 + r0)};
+      const auto half{0.5 * (r1 - r0)};
+
+      // the offset of the outer Gauss-Legendre nodes
+      const auto offset{half * 0.7745966692414834}; // sqrt(3/5)
+
+      // and sum the weighted nodes
+      return half * ((5. / 9.) * density(center - offset) + (8. / 9.) * density(center) +
+                     (5. / 9.) * density(center + offset));
+    }
+
+  }; // END: class DensityModel
+
+} // namespace apricot
@@ -2,6 +2,11 @@
 
 #include "apricot/Atmosphere.hpp"
 #include "apricot/Coordinates.hpp"
+#include "apricot/DensityModel.hpp"
+#include "apricot/earth/PREM.hpp"
+#include "apricot/earth/VoxelDensity.hpp"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <optional>
 
@@ -9,6 +14,8 @@ namespace apricot {
 
   /* Forward Declarations */
   class Atmosphere;
+  class DensityModel;
+  class VoxelDensity;
 
   /**
    * The base class that handles all Earth models.
@@ -21,6 +28,8 @@ namespace apricot {
   class Earth {
 
     std::shared_ptr<Atmosphere> atmosphere_{nullptr}; ///< The atmosphere model to use.
+    std::shared_ptr<DensityModel> interior_{nullptr}; ///< The interior density model (PREM if null).
+    std::shared_ptr<VoxelDensity> voxels_{nullptr};   ///< A regional voxel grid (if any).
 
     public:
     /**
@@ -43,6 +52,141 @@ namespace apricot {
     auto
     density(const CartesianCoordinate& location) const -> double;
 
+    /**
+     * The density of the Earth at a location with a known Earth radius.
+     *
+     * The concrete atmosphere type can be given as a template argument
+     * so that the atmosphere is called without virtual dispatch. It is
+     * the caller's responsibility that the atmosphere model (if any) is
+     * an instance of `AtmosphereT`.
+     *
+     * This returns the density in g/cm^3.
+     *
+     * @param location    A geocentric coordinate [km].
+     * @param Rearth      The radius of the Earth at this location [km].
+     */
+    template <typename AtmosphereT = Atmosphere>
+    auto
+    density(const CartesianCoordinate& location, const double Rearth) const -> double {
+
+      // a voxel grid replaces the radial model inside its region
+      if (voxels_ != nullptr && voxels_->contains(location)) {
+        return voxels_->density(location);
+      }
+
+      // the radius of the current point
+      const auto radius{location.norm()};
+
+      // if the location is less than the Earth radius
+      if (radius < Rearth) {
+
+        // use a custom density model if we have one
+        if (interior_ != nullptr) {
+          return interior_->density(radius, Rearth);
+        }
+
+        // otherwise default to PREM
+        return PREM::density(radius, Rearth);
+      }
+
+      // with no atmosphere model, assume zero density.
+      if (atmosphere_ == nullptr) return 0.;
+
+      // otherwise return the density of the atmosphere at this altitude
+      return static_cast<const AtmosphereT&>(*atmosphere_).density(radius - Rearth);
+    }
+
+    /**
+     * The grammage (in g/cm^2) along a straight segment.
+     *
+     * If the interior density model is analytic (see
+     * `DensityModel::analytic`), the part of the segment below the
+     * surface is integrated exactly with `DensityModel::column`.
+     * Likewise, if the atmosphere is analytic (see
+     * `Atmosphere::analytic`), the part above the surface is given
+     * by the difference in vertical depth. Both assume that the
+     * radius varies linearly along the segment (exact up to the
+     * curvature of the Earth over the segment). Otherwise, the
+     * density is evaluated at the midpoint of each part. The
+     * segment should not cross the edge of a voxel grid.
+     *
+     * @param start     The start of the segment [km].
+     * @param end       The end of the segment [km].
+     * @param Rearth    The radius of the Earth at this location [km].
+     */
+    template <typename AtmosphereT = Atmosphere>
+    auto
+    grammage(const CartesianCoordinate& start,
+             const CartesianCoordinate& end,
+             const double Rearth) const -> double {
+
+      // the length of this segment
+      const auto length{(end - start).norm()};
+
+      // the radius at the start and end of the segment
+      const auto r0{start.norm()};
+      const auto r1{end.norm()};
+
+      // check if we can integrate any part of this segment analytically
+      if ((this->analytic() || this->analytic_atmosphere()) &&
+          std::abs(r1 - r0) > 1e-6 * length) {
+
+        // the path length per unit radius along this segment
+        const auto slope{length / (r1 - r0)};
+
+        // the grammage of the part of the segment between two radii
+        const auto part{[&](const double ra, const double rb, const bool exact) -> double {
+
+          // the fraction of the segment between these radii
+          const auto fraction{(rb - ra) / (r1 - r0)};
+          if (fraction <= 0.) return 0.;
+
+          // integrate this part exactly if we can
+          if (exact) {
+            if (ra < Rearth) return 1e5 * slope * interior_->column(ra, rb, Rearth);
+            return slope * (static_cast<const AtmosphereT&>(*atmosphere_).depth(ra - Rearth) -
+                            static_cast<const AtmosphereT&>(*atmosphere_).depth(rb - Rearth));
+          }
+
+          // otherwise, use the density at the center of this part
+          const auto center{0.5 * ((ra - r0) + (rb - r0)) / (r1 - r0)};
+          return density<AtmosphereT>(start + center * (end - start), Rearth) * 1e5 *
+                 fraction * length;
+        }};
+
+        // and add the parts below and above the surface
+        return part(std::min(r0, Rearth), std::min(r1, Rearth), this->analytic()) +
+               part(std::max(r0, Rearth), std::max(r1, Rearth), this->analytic_atmosphere());
+      }
+
+      // otherwise, use the density at the midpoint of the segment
+      return density<AtmosphereT>(0.5 * (start + end), Rearth) * 1e5 * length;
+    }
+
+    /**
+     * True if the interior is integrated analytically.
+     */
+    auto
+    analytic() const -> bool {
+      return interior_ != nullptr && interior_->analytic();
+    }
+
+    /**
+     * True if the atmosphere is integrated analytically.
+     */
+    auto
+    analytic_atmosphere() const -> bool {
+      return atmosphere_ != nullptr && atmosphere_->analytic();
+    }
+
+    /**
+     * The material of the Earth at a given location.
+     *
+     * @param location    A geocentric coordinate [km].
+     */
+    auto
+    material(const CartesianCoordinate& location) const -> MaterialID;
+
     /**
      * Find the intersection of a ray with the surface.
      *
@@ -82,6 +226,43 @@ namespace apricot {
     auto
     add(const std::shared_ptr<Atmosphere>& atmosphere) -> void;
 
+    /**
+     * Get the atmosphere model of this Earth model (if any).
+     */
+    auto
+    get_atmosphere() const -> const std::shared_ptr<Atmosphere>& {
+      return atmosphere_;
+    }
+
+    /**
+     * Use a custom interior density model for this Earth model.
+     *
+     * This replaces the default PREM density model.
+     *
+     * @param interior    The interior density model to use.
+     */
+    auto
+    add(const std::shared_ptr<DensityModel>& interior) -> void;
+
+    /**
+     * Add a regional voxel density grid to this Earth model.
+     *
+     * The grid replaces the radial density model (and atmosphere)
+     * everywhere inside the grid.
+     *
+     * @param voxels    The voxel grid to use.
+     */
+    auto
+    add(const std::shared_ptr<VoxelDensity>& voxels) -> void;
+
+    /**
+     * Get the voxel density grid of this Earth model (if any).
+     */
+    auto
+    get_voxels() const -> const std::shared_ptr<VoxelDensity>& {
+      return voxels_;
+    }
+
     /**
      * Virtual destructor.
      */
@@ -0,0 +1,51 @@
+/**
+ * This file provides access to the numeric data tables that are
+ * compiled into apricot.
+ *
+ * At build time, every numeric table in /data/particles and
+ * /data/calibration is converted into a `constexpr` array (see
+ * cmake/EmbedData.cmake) so that loading a table does not need
+ * to find, open, or parse a file and apricot keeps working when
+ * the source tree is moved or deleted after installation.
+ *
+ * Tables are named by their path relative to /data, i.e.
+ * "particles/tau/tau_decay_tauola.dat", and are stored row-major.
+ * Tables that were git-lfs pointers (or not numeric) at build time
+ * are not embedded.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace apricot::data {
+
+  /**
+   * A numeric table that was compiled into the library.
+   */
+  struct EmbeddedTable {
+    const char* name;     ///< The path of the table relative to /data.
+    const double* values; ///< The row-major values of the table.
+    std::size_t rows;     ///< The number of rows in the table.
+    std::size_t columns;  ///< The number of columns in each row.
+  };
+
+  /**
+   * Find a compiled-in table by name.
+   *
+   * @param name    The path of the table relative to /data.
+   *
+   * @returns The table, or an empty optional if it was not embedded.
+   */
+  auto
+  find_table(const std::string& name) -> std::optional<EmbeddedTable>;
+
+  /**
+   * The names of every compiled-in table.
+   */
+  auto
+  table_names() -> std::vector<std::string>;
+
+} // namespace apricot::data
@@ -48,6 +48,21 @@ namespace apricot {
                    const double minphi,
                    const double maxphi) -> Vector;
 
+  /**
+   * Return a random vector inside a cone.
+   *
+   * This returns a unit-vector picked uniformly (in solid angle)
+   * within `angle` [radians] of `axis`. The cone covers a solid
+   * angle of 2\pi (1 - cos(angle)).
+   *
+   * @param axis     The axis of the cone (need not be unit-length).
+   * @param angle    The half-opening angle of the cone [radians].
+   *
+   * @returns vector    A unit-length vector inside the cone.
+   */
+  auto
+  random_cone_point(const Vector& axis, const double angle) -> Vector;
+
   /**
    * Propagate a ray to a sphere with known radius.
    *
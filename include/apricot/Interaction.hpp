@@ -69,6 +69,7 @@ namespace apricot {
     Vector direction_;             ///< The unit-length direction vector.
     double weight_;                ///< The dot-product of the sampled trial.
     double altitude_;              ///< The altitude of the interaction [km].
+    double generation_weight_{1.}; ///< The generation weight of the primary (see `Particle`).
 
     /**
      * A virtual default destructor.
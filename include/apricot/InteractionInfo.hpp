@@ -32,6 +32,21 @@ namespace apricot {
      */
     static constexpr InteractionType Decay = 3;
 
+    /**
+     * A catastrophic lepton bremsstrahlung loss.
+     */
+    static constexpr InteractionType Bremsstrahlung = 4;
+
+    /**
+     * A catastrophic lepton pair production loss.
+     */
+    static constexpr InteractionType PairProduction = 5;
+
+    /**
+     * A catastrophic lepton photonuclear loss.
+     */
+    static constexpr InteractionType Photonuclear = 6;
+
     /**
      * A cosmic ray has reached shower max.
      */
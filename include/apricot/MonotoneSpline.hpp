@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A monotone cubic interpolant of tabulated data.
+   *
+   * This is a piecewise cubic Hermite spline whose slopes are
+   * limited (Fritsch-Carlson) so that it is monotone wherever the
+   * data is monotone - unlike a natural cubic spline, it never
+   * overshoots between knots. This makes it suitable for tabulated
+   * cross sections and cumulative distributions.
+   *
+   * Beyond the first and last knots, the spline is extrapolated
+   * linearly with its slope at that knot.
+   */
+  class MonotoneSpline final {
+
+    std::vector<double> x_;     ///< The (strictly increasing) knots.
+    std::vector<double> y_;     ///< The value at each knot.
+    std::vector<double> slope_; ///< The slope at each knot.
+
+    public:
+    /**
+     * Create a spline through a set of points.
+     *
+     * @param x    The (strictly increasing) knots; at least two.
+     * @param y    The value at each knot.
+     */
+    MonotoneSpline(const std::vector<double>& x, const std::vector<double>& y);
+
+    /**
+     * Evaluate the spline.
+     *
+     * @param x    The point to evaluate the spline at.
+     */
+    auto
+    operator()(const double x) const -> double;
+
+    /**
+     * The first knot of the spline.
+     */
+    auto
+    front() const -> double {
+      return x_.front();
+    }
+
+    /**
+     * The last knot of the spline.
+     */
+    auto
+    back() const -> double {
+      return x_.back();
+    }
+
+  }; // END: class MonotoneSpline
+
+} // namespace apricot
@@ -96,11 +96,42 @@ namespace apricot {
       energy_ = energy;
     };
 
+    /**
+     * Get the generation weight of this particle.
+     */
+    auto
+    get_weight() const -> double {
+      return weight_;
+    };
+
+    /**
+     *  Set the generation weight of this particle.
+     */
+    auto
+    set_weight(const double weight) -> void {
+      weight_ = weight;
+    };
+
     /*
      * The energy of the particle [log10(eV)].
      */
     double energy_;
 
+    /**
+     * The generation weight of the particle.
+     *
+     * Fluxes that do not sample the physical spectrum set this to
+     * the inverse of their sampling density, 1 / (dP/dE) [eV], so that
+     * events can be reweighted to any spectrum downstream. This is 1
+     * for particles from unweighted fluxes.
+     *
+     * A `CompositeFlux` also divides this by the probability that it
+     * chose the particle's species (at its energy), so the weight is
+     * 1 / (P(species) dP/dE) and each species can be reweighted to its
+     * own flux.
+     */
+    double weight_{1.};
+
     /**
      *  A virtual destructor so this class is abstract.
      */
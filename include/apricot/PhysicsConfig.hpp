@@ -0,0 +1,82 @@
+#pragma once
+
+#include "apricot/particles/EnergyLossTable.hpp"
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
+#include "apricot/particles/NeutrinoYFactor.hpp"
+
+namespace apricot {
+
+  /**
+   * The physics models used by a propagation.
+   *
+   * Particles look up their models with `PhysicsConfig::current()`.
+   * This is the configuration of the propagation that is running on
+   * the calling thread or, outside of any propagation, the
+   * process-wide default (`PhysicsConfig::global()`).
+   *
+   * A propagator with its own configuration installs it for the
+   * duration of each call to `propagate`, so propagators with
+   * different models can run concurrently (on different threads)
+   * while sharing the same read-only tables.
+   */
+  struct PhysicsConfig final {
+
+    /**
+     * The (tabulated) neutrino cross section model.
+     *
+     * This can be any built-in or registered model - see
+     * NeutrinoCrossSectionTable::get.
+     */
+    const NeutrinoCrossSectionTable* cross_sections{
+        &NeutrinoCrossSectionTable::get(NeutrinoCrossSectionModel::ConnollyMiddle)};
+
+    NeutrinoYFactorModel y_factor_model{NeutrinoYFactorModel::ALLM};      ///< The inelasticity model.
+    LeptonEnergyLossModel energy_loss_model{LeptonEnergyLossModel::ALLM}; ///< The lepton energy loss model.
+
+    /**
+     * The process-wide default configuration.
+     *
+     * This is used by any thread that is not running a propagation
+     * with its own configuration.
+     */
+    static auto
+    global() -> PhysicsConfig&;
+
+    /**
+     * The configuration of the calling thread.
+     */
+    static auto
+    current() -> const PhysicsConfig&;
+
+    /**
+     * Install a configuration on the calling thread.
+     *
+     * The previous configuration of the thread is restored when the
+     * scope is destroyed. The configuration must outlive the scope.
+     */
+    class Scope final {
+
+      const PhysicsConfig* previous_; ///< The configuration that we replaced.
+
+      public:
+      /**
+       * Install a configuration on this thread.
+       *
+       * @param config    The configuration to install.
+       */
+      explicit Scope(const PhysicsConfig& config);
+
+      /**
+       * Restore the previous configuration of this thread.
+       */
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      Scope&
+      operator=(const Scope&) = delete;
+
+    }; // END: class Scope
+
+  }; // END: struct PhysicsConfig
+
+} // namespace apricot
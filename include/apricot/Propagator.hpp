@@ -3,7 +3,11 @@
 #include "apricot/Coordinates.hpp"
 #include "apricot/Interaction.hpp"
 #include "apricot/Particle.hpp"
+#include "apricot/PhysicsConfig.hpp"
+#include "apricot/earth/VoxelDensity.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <tuple>
 
 namespace apricot {
@@ -25,6 +29,12 @@ namespace apricot {
    * This propagator propagates a single particle at a
    * time from the source+flux to the detector.
    *
+   * Each propagator can carry its own physics models (cross
+   * sections, inelasticity, and energy loss). These are installed
+   * on the calling thread for the duration of `propagate`, so that
+   * propagators with different models can run concurrently. Without
+   * its own models, a propagator uses `PhysicsConfig::global()`.
+   *
    */
   class Propagator {
 
@@ -38,6 +48,26 @@ namespace apricot {
      */
     Propagator(const Earth& earth) : earth_(earth){};
 
+    /**
+     * Use a set of physics models for every propagation.
+     *
+     * @param physics    The physics models to use.
+     */
+    auto
+    set_physics(const PhysicsConfig& physics) -> void {
+      physics_ = physics;
+    }
+
+    /**
+     * The physics models used by this propagator.
+     *
+     * This is the global configuration if none have been set.
+     */
+    auto
+    get_physics() const -> const PhysicsConfig& {
+      return physics_ ? *physics_ : PhysicsConfig::global();
+    }
+
     /**
      * Propagate several particles from a Source to a Detector.
      *
@@ -46,8 +76,11 @@ namespace apricot {
      * @param detector   The Detector model used to detect particles.
      * @param N          The number of interactions to generate.
      *
+     * Derived propagators can override this to dispatch to a
+     * statically typed propagation kernel for known model types.
+     *
      */
-    auto
+    virtual auto
     propagate(Source& source, Flux& flux, const Detector& detector, const int N) const
         -> Events;
 
@@ -70,6 +103,8 @@ namespace apricot {
     virtual ~Propagator() = default;
 
     protected:
+    std::optional<PhysicsConfig> physics_; ///< The physics models of this propagator (if any).
+
     /**
      * Calculate the step size for propagation.
      *
@@ -81,6 +116,21 @@ namespace apricot {
     step_size(const ParticlePtr& particle, const CartesianCoordinate& location) const
         -> double;
 
+    /**
+     * The default step size (in km) at a normalized radius.
+     *
+     * If the Earth's interior is integrated analytically, much
+     * larger steps are taken through the ice and crust; likewise
+     * if the atmosphere is integrated analytically, much larger
+     * steps are taken through the air.
+     *
+     * @param x           The radius normalized to the local Earth radius.
+     * @param analytic    True if the interior is integrated analytically.
+     * @param air         True if the atmosphere is integrated analytically.
+     */
+    static auto
+    step_length(const double x, const bool analytic = false, const bool air = false) -> double;
+
     protected:
     /**
      * Return the starting parameters of a new trials.
@@ -93,17 +143,132 @@ namespace apricot {
     /**
      * Step a location vector to the next step and return the grammage.
      *
-     * This returns the total grammage (g/cm^2) of the step.
+     * This returns the total grammage (g/cm^2) of the step. Inside
+     * a voxel grid, the step walks the grid exactly and stops once
+     * `remaining` grammage has been crossed, in which case it returns
+     * exactly `remaining`.
      *
-     * @param earth      The earth model to propagate through.
+     * @param particle   The particle that is being processed.
      * @param location   The current location of the particle.
      * @param direction  The unit-length momentum direction.
+     * @param remaining  The grammage remaining until the next interaction.
      *
      */
     auto
     step(const ParticlePtr& particle,
          CartesianCoordinate& location,
-         Vector& direction) const -> double;
+         Vector& direction,
+         const double remaining) const -> double;
+
+    /**
+     * Step a location vector using statically typed models.
+     *
+     * This is identical to `step` with the default step size but
+     * calls the Earth and atmosphere models through their concrete
+     * types so that they can be resolved (and inlined) at compile time.
+     *
+     * @param earth      The earth model to propagate through.
+     * @param location   The current location of the particle.
+     * @param direction  The unit-length momentum direction.
+     * @param remaining  The grammage remaining until the next interaction.
+     *
+     */
+    template <typename EarthT, typename AtmosphereT>
+    static auto
+    step(const EarthT& earth,
+         CartesianCoordinate& location,
+         const Vector& direction,
+         const double remaining) -> double {
+
+      // get the step size at the current location
+      const auto length{step_length(location.norm() / earth.radius(location),
+                                    earth.analytic(),
+                                    earth.analytic_atmosphere())};
+
+      // and take the step
+      return advance<EarthT, AtmosphereT>(earth, location, direction, length, remaining);
+    }
+
+    /**
+     * Advance a location by a given length and return the grammage.
+     *
+     * The grammage is computed by `Earth::grammage`. If the interior
+     * or atmosphere is analytic, a step that reaches `remaining` is
+     * stopped at the exact interaction point and returns `remaining`. If the Earth
+     * has a voxel grid, steps that start inside the grid walk it
+     * exactly (up to `remaining` or `length`, whichever comes first)
+     * and steps that would enter the grid are shortened to stop at
+     * its edge.
+     *
+     * @param earth      The earth model to propagate through.
+     * @param location   The current location of the particle.
+     * @param direction  The unit-length momentum direction.
+     * @param length     The length of the step [km].
+     * @param remaining  The grammage remaining until the next interaction.
+     *
+     */
+    template <typename EarthT, typename AtmosphereT>
+    static auto
+    advance(const EarthT& earth,
+            CartesianCoordinate& location,
+            const Vector& direction,
+            double length,
+            const double remaining) -> double {
+
+      // check if we have a voxel grid to walk through
+      if (const auto& voxels{earth.get_voxels()}; voxels != nullptr) {
+
+        // inside the grid, walk the voxels exactly for at most this step
+        if (voxels->contains(location)) {
+          return voxels->walk(location, direction, remaining, length);
+        }
+
+        // otherwise, stop this step just inside the grid
+        length = std::min(length, voxels->entry(location, direction) + VoxelDensity::EDGE);
+      }
+
+      // the start of this step
+      const CartesianCoordinate start{location};
+
+      // step the particle to the end of the step
+      location += length * direction;
+
+      // the radius of the Earth at the midpoint of the step
+      const auto Rearth{earth.radius(0.5 * (start + location))};
+
+      // get the grammage that we travelled through
+      const auto grammage{earth.template grammage<AtmosphereT>(start, location, Rearth)};
+
+      // with analytic steps, find the exact interaction point in this step
+      if (grammage > remaining && (earth.analytic() || earth.analytic_atmosphere())) {
+
+        // the distance along the step, starting with a linear guess
+        double distance{length * remaining / grammage};
+
+        // and refine the guess with a few Newton iterations
+        for (int i = 0; i < 4; ++i) {
+
+          // the current guess at the interaction point
+          const CartesianCoordinate point{start + distance * direction};
+
+          // the density at this point - in g/cm^3 * cm/km
+          const auto density{1e5 * earth.template density<AtmosphereT>(point, Rearth)};
+          if (density <= 0.) break;
+
+          // and take a Newton step
+          const auto error{earth.template grammage<AtmosphereT>(start, point, Rearth) -
+                           remaining};
+          distance = std::clamp(distance - error / density, 0., length);
+        }
+
+        // and stop the particle at the interaction point
+        location = start + distance * direction;
+        return remaining;
+      }
+
+      // otherwise, we crossed the whole step
+      return grammage;
+    }
 
   }; // END: class Propagator
 
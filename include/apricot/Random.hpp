@@ -10,9 +10,14 @@
  * If you wish to generate other random numbers, please
  * ensure that you use this `generator` instance to ensure
  * reproducibility.
+ *
+ * Every thread has its own `generator` so that propagation (and
+ * table generation) can run on several threads at once; `set_seed`
+ * only seeds the generator of the calling thread.
  */
 #pragma once
 
+#include <mutex>
 #include <random>
 
 namespace apricot::random {
@@ -23,7 +28,26 @@ namespace apricot::random {
    * This should ONLY be used to seed the Mersenne Twister.
    * Do not use this random device directly.
    */
-  inline static std::random_device rd;
+  inline std::random_device rd;
+
+  /**
+   * A mutex that guards the random device.
+   *
+   * `std::random_device` is not thread-safe and each thread
+   * seeds its generator from it the first time it is used.
+   */
+  inline std::mutex rd_mutex;
+
+  /**
+   * Draw a seed from the random device.
+   *
+   * This is safe to call from several threads at once.
+   */
+  inline auto
+  entropy() -> std::random_device::result_type {
+    const std::lock_guard<std::mutex> lock{rd_mutex};
+    return rd();
+  }
 
   /**
    * A 64-bit Mersenne twister RNG.
@@ -31,16 +55,18 @@ namespace apricot::random {
    * Note: this is *significantly* faster than the standard
    * mt19937 generator with random performance that is almost
    * as good (there's still plenty of entropy for our application).
+   *
+   * There is one generator per thread, seeded from `entropy`.
    */
-  inline static std::mt19937_64 generator(rd());
+  inline thread_local std::mt19937_64 generator(entropy());
 
   /**
-   * Change the RNG seed.
+   * Change the RNG seed of the calling thread.
    *
    * @params seed    An integer seed.
    *
    */
-  inline static auto
+  inline auto
   set_seed(const int seed) {
     generator.seed(seed);
   }
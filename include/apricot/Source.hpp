@@ -21,6 +21,18 @@ namespace apricot {
     virtual auto
     get_origin() const -> std::pair<CartesianCoordinate, Vector> = 0;
 
+    /**
+     * The solid angle that directions are sampled from [sr].
+     *
+     * The acceptance of a detector is this solid angle times the
+     * area of the source times the (weighted) fraction of trials
+     * that are detected. By default, directions cover 4\pi sr.
+     */
+    virtual auto
+    solid_angle() const -> double {
+      return 4. * M_PI;
+    }
+
     /**
      * A virtual destructor.
      *
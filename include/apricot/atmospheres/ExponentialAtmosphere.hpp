@@ -1,6 +1,7 @@
 #pragma once
 
 #include "apricot/Atmosphere.hpp"
+#include <cmath>
 
 namespace apricot {
 
@@ -11,6 +12,9 @@ namespace apricot {
    *
    *     \rho = \rho_0 \exp { -g M h / RT }
    *
+   * The scale height, H = RT / gM, is computed once at construction
+   * so that the vertical depth, X(h) = \rho_0 H \exp { -h / H }, and
+   * its inverse are available in closed form.
    */
   class ExponentialAtmosphere final : public Atmosphere {
 
@@ -33,12 +37,17 @@ namespace apricot {
     /*
      * The sea-level density (g/cm^3).
      */
-    double rho0_;
+    const double rho0_;
 
     /*
      * The reference temperature (K).
      */
-    double T_;
+    const double T_;
+
+    /*
+     * The scale height of the atmosphere (km).
+     */
+    const double scale_;
 
     /**
      * Create an ExponentialAtmosphere from parameters.
@@ -51,7 +60,8 @@ namespace apricot {
      */
     ExponentialAtmosphere(const double rho0 = 1.225e-3, const double T = 273) :
         rho0_(rho0),
-        T_(T){};
+        T_(T),
+        scale_(R * T / (g * M)){};
 
     /**
      * The density of the atmosphere at a given altitude.
@@ -63,7 +73,35 @@ namespace apricot {
      *
      */
     auto
-    density(const double altitude) const -> double final override;
+    density(const double altitude) const -> double final override {
+      return rho0_ * std::exp(-altitude / scale_);
+    }
+
+    /**
+     * The vertical depth of the atmosphere above a given altitude.
+     *
+     * This returns the depth in g/cm^2.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    depth(const double altitude) const -> double final override;
+
+    /**
+     * The altitude at which the vertical depth reaches a given value.
+     *
+     * @param depth   The vertical depth [g/cm^2].
+     */
+    auto
+    altitude(const double depth) const -> double final override;
+
+    /**
+     * The vertical depth of this atmosphere is exact.
+     */
+    auto
+    analytic() const -> bool final override {
+      return true;
+    }
 
   }; // END: ExponentialAtmosphere
 
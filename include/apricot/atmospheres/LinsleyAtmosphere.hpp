@@ -0,0 +1,145 @@
+#pragma once
+
+#include "apricot/Atmosphere.hpp"
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace apricot {
+
+  /**
+   * A five-layer atmosphere with the parametrization of J. Linsley.
+   *
+   * This is the atmosphere model used by CORSIKA. In each of the
+   * lower four layers, the vertical depth follows an exponential
+   *
+   *     X(h) = a_i + b_i \exp { -h / c_i }
+   *
+   * and in the uppermost layer it decreases linearly
+   *
+   *     X(h) = a_5 - b_5 h / c_5
+   *
+   * until it reaches zero at the top of the atmosphere (~112.8 km).
+   * The density is the (negative) derivative of the depth so that
+   * the depth and its inverse are both available in closed form.
+   *
+   * The built-in parameter sets are:
+   *
+   *     "us-standard"          U.S. standard atmosphere (Linsley).
+   *     "south-pole-january"   South Pole in January (P. Lipari).
+   *     "south-pole-august"    South Pole in August (A. Smith & P. Lipari).
+   */
+  class LinsleyAtmosphere final : public Atmosphere {
+
+    public:
+    /**
+     * The value of a parameter in each of the five layers.
+     */
+    using Parameters = std::array<double, 5>;
+
+    private:
+    Parameters boundaries_; ///< The altitude of the bottom of each layer [km].
+    Parameters a_;          ///< The offset of the depth in each layer [g/cm^2].
+    Parameters b_;          ///< The scale of the depth in each layer [g/cm^2].
+    Parameters c_;          ///< The scale height of each layer [km].
+    Parameters depths_;     ///< The depth at the bottom of each layer [g/cm^2].
+    double top_;            ///< The altitude at which the depth reaches zero [km].
+
+    public:
+    /**
+     * Construct a LinsleyAtmosphere from a built-in parameter set.
+     *
+     * @param model    The name of the parameter set.
+     */
+    LinsleyAtmosphere(const std::string& model = "us-standard");
+
+    /**
+     * Construct a LinsleyAtmosphere from explicit parameters.
+     *
+     * The scale heights are given in cm as tabulated by CORSIKA.
+     *
+     * @param boundaries    The altitude of the bottom of each layer [km].
+     * @param a             The offset of the depth in each layer [g/cm^2].
+     * @param b             The scale of the depth in each layer [g/cm^2].
+     * @param c             The scale height of each layer [cm].
+     */
+    LinsleyAtmosphere(const Parameters& boundaries,
+                      const Parameters& a,
+                      const Parameters& b,
+                      const Parameters& c);
+
+    /**
+     * The density of the atmosphere at a given altitude.
+     *
+     * This returns density in g/cm^3.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    density(const double altitude) const -> double final override {
+
+      // above the top, there is no atmosphere
+      if (altitude >= top_) return 0.;
+
+      // the layer containing this altitude
+      const auto i{layer(altitude)};
+
+      // the uppermost layer has a constant density
+      if (i == 4) return 1e-5 * b_[4] / c_[4];
+
+      // and the lower layers are exponential - in g/cm^2/km * km/cm
+      return 1e-5 * (b_[i] / c_[i]) * std::exp(-altitude / c_[i]);
+    }
+
+    /**
+     * The vertical depth of the atmosphere above a given altitude.
+     *
+     * This returns the depth in g/cm^2.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    depth(const double altitude) const -> double final override;
+
+    /**
+     * The altitude at which the vertical depth reaches a given value.
+     *
+     * @param depth   The vertical depth [g/cm^2].
+     */
+    auto
+    altitude(const double depth) const -> double final override;
+
+    /**
+     * The vertical depth of this atmosphere is exact.
+     */
+    auto
+    analytic() const -> bool final override {
+      return true;
+    }
+
+    /**
+     * The altitude of the top of the atmosphere [km].
+     */
+    auto
+    top() const -> double {
+      return top_;
+    }
+
+    private:
+    /**
+     * The index of the layer containing a given altitude.
+     *
+     * Altitudes below the first layer belong to the first layer.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    layer(const double altitude) const -> int {
+      int i{4};
+      while (i > 0 && altitude < boundaries_[i]) --i;
+      return i;
+    }
+
+  }; // END: class LinsleyAtmosphere
+
+} // namespace apricot
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "apricot/Atmosphere.hpp"
+#include "apricot/earth/SphericalEarth.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A table of slant depth versus altitude and zenith angle.
+   *
+   * This tabulates the grammage along a straight ray from a point at
+   * a given altitude, in a direction with a given local zenith angle,
+   * to the top of the atmosphere on a curved (spherical) Earth. The
+   * flat-Earth approximation, X(h) / cos(zenith), diverges at the
+   * horizon where Earth-skimming and reflected trajectories live.
+   *
+   * The table is built once per atmosphere by integrating the density
+   * along each ray. It stores log(X) on a grid that is uniform in
+   * altitude and in sqrt(cos(zenith)), which concentrates nodes near
+   * the horizon, and interpolates it bilinearly. Rays below the
+   * horizon are reduced to upward rays by the symmetry of a ray about
+   * its tangent point, so every lookup is O(1). The largest relative
+   * interpolation error at the center of each cell is measured when
+   * the table is built (see `error`).
+   *
+   * If the atmosphere changes after the table is built (i.e.
+   * `SoundingAtmosphere::set_time`), the table is `stale` until it
+   * is rebuilt with `rebuild`.
+   *
+   * For an ellipsoidal Earth, use the local radius of curvature.
+   */
+  class SlantDepthTable final {
+
+    const std::shared_ptr<Atmosphere> atmosphere_; ///< The atmosphere that we tabulate.
+    const double Rearth_;                          ///< The radius of the Earth [km].
+    const int nheights_;                           ///< The number of altitude nodes.
+    const int nzeniths_;                           ///< The number of zenith nodes.
+    std::vector<double> table_;                    ///< log(X) at each node.
+    double error_{0.};                             ///< The maximum relative error.
+    std::size_t revision_{0};                      ///< The atmosphere revision we tabulated.
+
+    public:
+    /**
+     * The smallest depth that we tabulate [g/cm^2].
+     */
+    static constexpr double FLOOR{1e-10};
+
+    /**
+     * The precision of the distance to a grammage [km].
+     */
+    static constexpr double TOLERANCE{1e-9};
+
+    /**
+     * The maximum number of iterations to find the distance to a grammage.
+     */
+    static constexpr int MAX_ITERATIONS{60};
+
+    /**
+     * Build a slant depth table for an atmosphere.
+     *
+     * @param atmosphere    The atmosphere to tabulate.
+     * @param Rearth        The radius of the Earth [km].
+     * @param nheights      The number of altitude nodes up to `Atmosphere::TOP`.
+     * @param nzeniths      The number of zenith angle nodes up to the horizon.
+     */
+    SlantDepthTable(const std::shared_ptr<Atmosphere>& atmosphere,
+                    const double Rearth  = SphericalEarth::POLAR,
+                    const int nheights   = 301,
+                    const int nzeniths   = 101);
+
+    /**
+     * The slant depth along a ray [g/cm^2].
+     *
+     * This is the grammage from a point along a ray until the ray
+     * either leaves the atmosphere or reaches the surface.
+     *
+     * @param altitude    The altitude of the start of the ray [km].
+     * @param zenith      The local zenith angle of the ray [radians].
+     */
+    auto
+    depth(const double altitude, const double zenith) const -> double;
+
+    /**
+     * The distance along a ray at which a given grammage is reached [km].
+     *
+     * This returns infinity if the ray leaves the atmosphere, or
+     * reaches the surface, before crossing `grammage`. The tabulated
+     * slant depth is monotone along the ray, so this is solved with
+     * a few (bracketed) Newton steps whose gradient is the density.
+     *
+     * @param altitude    The altitude of the start of the ray [km].
+     * @param zenith      The local zenith angle of the ray [radians].
+     * @param grammage    The grammage to cross along the ray [g/cm^2].
+     */
+    auto
+    distance(const double altitude, const double zenith, const double grammage) const
+        -> double;
+
+    /**
+     * The slant depth along a ray by direct numerical integration [g/cm^2].
+     *
+     * This is what the table approximates; it is much slower.
+     *
+     * @param altitude    The altitude of the start of the ray [km].
+     * @param zenith      The local zenith angle of the ray [radians].
+     */
+    auto
+    integrate(const double altitude, const double zenith) const -> double;
+
+    /**
+     * The largest relative error of the table at the cell centers.
+     *
+     * This only includes cells whose slant depth is at least 1 g/cm^2.
+     */
+    auto
+    error() const -> double {
+      return error_;
+    }
+
+    /**
+     * Whether the atmosphere has changed since this table was built.
+     */
+    auto
+    stale() const -> bool {
+      return atmosphere_->revision() != revision_;
+    }
+
+    /**
+     * Re-tabulate the slant depth of the (current) atmosphere.
+     *
+     * This must not be called while the table is in use.
+     */
+    auto
+    rebuild() -> void;
+
+    private:
+    /**
+     * Integrate the slant depth at every node and measure the error.
+     */
+    auto
+    tabulate() -> void;
+
+    /**
+     * Interpolate the slant depth of an upward ray.
+     *
+     * @param altitude    The altitude of the start of the ray [km].
+     * @param cosz        The cosine of the local zenith angle (>= 0).
+     */
+    auto
+    lookup(const double altitude, const double cosz) const -> double;
+
+    /**
+     * Integrate the density along part of a ray [g/cm^2].
+     *
+     * The integration nodes are concentrated at the end of the part
+     * with the lowest altitude, where the density is largest.
+     *
+     * @param radius    The radius of the start of the ray [km].
+     * @param cosz      The cosine of the local zenith angle of the ray.
+     * @param s0        The start of the part along the ray [km].
+     * @param s1        The end of the part along the ray [km].
+     */
+    auto
+    integrate(const double radius, const double cosz, const double s0, const double s1) const
+        -> double;
+
+  }; // END: class SlantDepthTable
+
+} // namespace apricot
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "apricot/Atmosphere.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A time-dependent atmosphere built from tabulated density profiles.
+   *
+   * This loads a set of measured density profiles (e.g. monthly
+   * radiosonde or GDAS soundings), each with a time stamp, and
+   * resamples them onto a common altitude grid with a spacing of
+   * `STEP`. Between grid nodes the density is interpolated
+   * exponentially (linearly in log(density)) and the vertical depth
+   * is the exact integral of this interpolant, so that `density`,
+   * `depth`, and (up to a binary search) `altitude` cost about the
+   * same as the `ExponentialAtmosphere`. Profiles are extrapolated
+   * exponentially below their first and above their last altitude.
+   *
+   * The log(density) and cumulative depth of every profile are
+   * tabulated once at load. The profile that is used is chosen with
+   * `set_time`, which either selects the closest profile or
+   * interpolates linearly in density between the two profiles
+   * around the given time - the depth of this mixture is the same
+   * mixture of the depths of the two profiles, so `set_time` only
+   * selects tables and never rebuilds them. If a period is given
+   * (e.g. 365.25 days), times wrap around so that December
+   * interpolates into January.
+   *
+   * The active profile is shared by every user of this atmosphere,
+   * so the time should only be changed between propagation runs.
+   * Each change increments `revision()` so that tables built from
+   * the atmosphere (e.g. a `SlantDepthTable`) can detect that they
+   * are out of date.
+   *
+   * The file format is line-based; '#' starts a comment.
+   *
+   *     period <period>
+   *     profile <time>
+   *     <altitude [km]> <density [g/cm^3]>
+   *     <altitude [km]> <pressure [hPa]> <temperature [K]>
+   *
+   * Each `profile` row starts a new profile whose rows follow it in
+   * increasing altitude. Rows with three columns are converted to a
+   * density with the ideal gas law for dry air. The units of the
+   * time (and period) are up to the user.
+   */
+  class SoundingAtmosphere final : public Atmosphere {
+
+    /**
+     * A density profile tabulated on the altitude grid.
+     */
+    struct Profile {
+      std::vector<double> log_density; ///< The log(density) at each node.
+      std::vector<double> slopes;      ///< The gradient of log(density) in each cell [1/km].
+      std::vector<double> depths;      ///< The depth at each node [g/cm^2].
+
+      /**
+       * The density at an altitude within (or below) a cell [g/cm^3].
+       *
+       * @param i          The cell containing the altitude.
+       * @param altitude   Altitude in kilometers [km].
+       */
+      auto
+      density(const std::size_t i, const double altitude) const -> double {
+        return std::exp(log_density[i] + (altitude - i * STEP) * slopes[i]);
+      }
+
+      /**
+       * The vertical depth above an altitude within (or below) a cell [g/cm^2].
+       *
+       * @param i          The cell containing the altitude.
+       * @param altitude   Altitude in kilometers [km].
+       */
+      auto
+      depth(const std::size_t i, const double altitude) const -> double;
+    };
+
+    std::vector<double> times_;     ///< The time of each profile.
+    std::vector<Profile> profiles_; ///< The tables of each profile.
+    std::size_t lower_{0};          ///< The active profile (or the earlier of two).
+    std::size_t upper_{0};          ///< The later of the two interpolated profiles.
+    double weight_{0.};             ///< The weight of the later profile.
+    std::size_t revision_{0};       ///< The number of changes to the active profile.
+    double period_;                 ///< The period of the times (zero if none).
+    double time_;                   ///< The current time.
+
+    public:
+    /**
+     * The spacing of the altitude grid [km].
+     */
+    static constexpr double STEP{0.1};
+
+    /**
+     * Load a SoundingAtmosphere from a profile file.
+     *
+     * The first profile is active after loading.
+     *
+     * @param filename    The path to the profile file.
+     */
+    SoundingAtmosphere(const std::string& filename);
+
+    /**
+     * Construct a SoundingAtmosphere from tabulated profiles.
+     *
+     * The first profile (in time) is active after construction.
+     *
+     * @param times        The time of each profile.
+     * @param altitudes    The increasing altitudes of each profile [km].
+     * @param densities    The densities of each profile [g/cm^3].
+     * @param period       The period of the times (zero if not periodic).
+     */
+    SoundingAtmosphere(const std::vector<double>& times,
+                       const std::vector<std::vector<double>>& altitudes,
+                       const std::vector<std::vector<double>>& densities,
+                       const double period = 0.);
+
+    /**
+     * Choose the active profile for a given time.
+     *
+     * @param time           The time of the events to propagate.
+     * @param interpolate    If false, use the closest profile in time.
+     */
+    auto
+    set_time(const double time, const bool interpolate = true) -> void;
+
+    /**
+     * Get the time of the active profile.
+     */
+    auto
+    get_time() const -> double {
+      return time_;
+    }
+
+    /**
+     * The number of profiles in this atmosphere.
+     */
+    auto
+    size() const -> std::size_t {
+      return times_.size();
+    }
+
+    /**
+     * The number of times that the active profile has changed.
+     */
+    auto
+    revision() const -> std::size_t final override {
+      return revision_;
+    }
+
+    /**
+     * The density of the atmosphere at a given altitude.
+     *
+     * This returns density in g/cm^3.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    density(const double altitude) const -> double final override {
+
+      // above the grid, there is no atmosphere
+      if (altitude >= Atmosphere::TOP) return 0.;
+
+      // the cell containing this altitude
+      const auto i{cell(altitude)};
+
+      // interpolate exponentially within the cell
+      const auto rho{profiles_[lower_].density(i, altitude)};
+
+      // and mix in the later profile if we are between two
+      if (!(weight_ > 0.)) return rho;
+      return (1. - weight_) * rho + weight_ * profiles_[upper_].density(i, altitude);
+    }
+
+    /**
+     * The vertical depth of the atmosphere above a given altitude.
+     *
+     * This returns the depth in g/cm^2.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    depth(const double altitude) const -> double final override;
+
+    /**
+     * The altitude at which the vertical depth reaches a given value.
+     *
+     * @param depth   The vertical depth [g/cm^2].
+     */
+    auto
+    altitude(const double depth) const -> double final override;
+
+    /**
+     * The vertical depth of this atmosphere is exact.
+     */
+    auto
+    analytic() const -> bool final override {
+      return true;
+    }
+
+    private:
+    /**
+     * The index of the grid cell containing an altitude.
+     *
+     * Altitudes below the grid use the first cell.
+     *
+     * @param altitude   Altitude in kilometers [km].
+     */
+    auto
+    cell(const double altitude) const -> std::size_t {
+      if (altitude <= 0.) return 0;
+      return std::min(static_cast<std::size_t>(altitude / STEP),
+                      profiles_.front().slopes.size() - 1);
+    }
+
+    /**
+     * The vertical depth of the active (mixture of) profiles at a node [g/cm^2].
+     *
+     * @param i    The index of the node.
+     */
+    auto
+    node_depth(const std::size_t i) const -> double {
+      const auto depth{profiles_[lower_].depths[i]};
+      if (!(weight_ > 0.)) return depth;
+      return (1. - weight_) * depth + weight_ * profiles_[upper_].depths[i];
+    }
+
+    /**
+     * Resample a tabulated profile onto the altitude grid.
+     *
+     * @param altitudes    The increasing altitudes of the profile [km].
+     * @param densities    The densities of the profile [g/cm^3].
+     */
+    static auto
+    resample(const std::vector<double>& altitudes, const std::vector<double>& densities)
+        -> Profile;
+
+    /**
+     * Sort the profiles by time and activate the first one.
+     */
+    auto
+    initialize() -> void;
+
+  }; // END: class SoundingAtmosphere
+
+} // namespace apricot
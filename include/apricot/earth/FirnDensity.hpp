@@ -0,0 +1,139 @@
+#pragma once
+
+#include "apricot/DensityModel.hpp"
+#include <memory>
+
+namespace apricot {
+
+  /**
+   * An ice sheet with an exponential (Schytt) firn profile.
+   *
+   * This models an ice sheet of a given thickness at the surface
+   * of the Earth whose density increases with depth, z, as
+   *
+   *     rho(z) = rho_ice - (rho_ice - rho_surface) * exp(-z / z0)
+   *
+   * Below the ice sheet, the density is given by a background
+   * radial model (PREM if none is given). Since the profile only
+   * depends on depth, the column density through the ice is
+   * computed analytically so that the propagator can cross the
+   * ice sheet in a few large steps.
+   *
+   * The default parameters approximate the South Pole: 2.835 km
+   * of ice, a surface density of 0.359 g/cm^3, and a scale depth
+   * of 65 m so that the pore close-off density (0.83 g/cm^3) is
+   * reached at about 120 m.
+   */
+  class FirnDensity final : public DensityModel {
+
+    const double thickness_;                         ///< The thickness of the ice sheet [km].
+    const double surface_;                           ///< The density at the surface [g/cm^3].
+    const double scale_;                             ///< The e-folding depth of the firn [km].
+    const double ice_;                               ///< The density of solid ice [g/cm^3].
+    const std::shared_ptr<DensityModel> background_; ///< The model below the ice (PREM if null).
+
+    public:
+    /**
+     * The default thickness of the ice sheet [km].
+     */
+    static constexpr double THICKNESS{2.835};
+
+    /**
+     * The default density at the surface [g/cm^3].
+     */
+    static constexpr double SURFACE{0.359};
+
+    /**
+     * The default e-folding depth of the firn [km].
+     */
+    static constexpr double SCALE{0.065};
+
+    /**
+     * The default density of solid ice [g/cm^3].
+     */
+    static constexpr double ICE{0.917};
+
+    /**
+     * The density at which firn becomes ice (pore close-off) [g/cm^3].
+     */
+    static constexpr double CLOSEOFF{0.83};
+
+    /**
+     * Construct a new firn and ice density model.
+     *
+     * @param thickness    The thickness of the ice sheet [km].
+     * @param surface      The density at the surface [g/cm^3].
+     * @param scale        The e-folding depth of the firn [km].
+     * @param ice          The density of solid ice [g/cm^3].
+     * @param background   The density model below the ice (PREM if null).
+     */
+    FirnDensity(const double thickness                          = FirnDensity::THICKNESS,
+                const double surface                            = FirnDensity::SURFACE,
+                const double scale                              = FirnDensity::SCALE,
+                const double ice                                = FirnDensity::ICE,
+                const std::shared_ptr<DensityModel>& background = nullptr);
+
+    /**
+     * The density (in g/cm^3) at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    density(const double radius, const double Rearth) const -> double final override;
+
+    /**
+     * The material at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    material(const double radius, const double Rearth) const -> MaterialID final override;
+
+    /**
+     * The radial column density between two radii [g/cm^3 * km].
+     *
+     * This is exact within the ice sheet; the background model is
+     * integrated with its own `column` (or `PREM::column`).
+     *
+     * @param r0        The starting radius [km].
+     * @param r1        The final radius [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    column(const double r0, const double r1, const double Rearth) const
+        -> double final override;
+
+    /**
+     * The column density through the ice sheet is exact, so this
+     * is analytic if the background model (or PREM) is as well.
+     */
+    auto
+    analytic() const -> bool final override {
+      return background_ == nullptr || background_->analytic();
+    }
+
+    private:
+    /**
+     * The density of the background model at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    background(const double radius, const double Rearth) const -> double;
+
+    /**
+     * The column density of the background model between two radii.
+     *
+     * @param r0        The starting radius [km].
+     * @param r1        The final radius [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    background_column(const double r0, const double r1, const double Rearth) const -> double;
+
+  }; // END: class FirnDensity
+
+} // namespace apricot
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "apricot/DensityModel.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A single spherical shell of a LayeredDensity model.
+   *
+   * The density within the shell is a cubic polynomial in the
+   * normalized radius, x = radius / Rearth, exactly like PREM.
+   */
+  struct Layer final {
+
+    double outer_;                   ///< The outer radius of this shell [km].
+    MaterialID material_;            ///< The material of this shell.
+    std::array<double, 4> coeffs_;   ///< The polynomial coefficients in x.
+
+    /**
+     * Construct a new Layer.
+     *
+     * @param outer      The outer radius of this shell [km].
+     * @param material   The material of this shell.
+     * @param coeffs     The polynomial coefficients {c0, c1, c2, c3}.
+     */
+    Layer(const double outer,
+          const MaterialID material,
+          const std::array<double, 4>& coeffs) :
+        outer_(outer),
+        material_(material),
+        coeffs_(coeffs){};
+
+  }; // END: struct Layer
+
+  /**
+   * A user-defined radial density model made of spherical shells.
+   *
+   * The model is loaded from a simple text file and then compiled
+   * into sorted arrays of normalized shell boundaries, polynomial
+   * coefficients, and material IDs. A guide table over the normalized
+   * radius gives the shell index in O(1) so that a lookup costs about
+   * the same as the hard-coded PREM model.
+   *
+   * The file format is line-based; '#' starts a comment.
+   *
+   *     reference <radius [km]>
+   *     layer <outer radius [km]> <material> <c0> [c1] [c2] [c3]
+   *     point <radius [km]> <material> <density [g/cm^3]>
+   *
+   * `reference` is the Earth radius at which the boundaries are
+   * given (default: 6356.755 km). `layer` rows define a shell whose
+   * density is c0 + c1*x + c2*x^2 + c3*x^3 with x = radius / Rearth.
+   * A run of consecutive `point` rows defines a tabulated profile that
+   * is compiled into piecewise-linear shells between the points; the
+   * first point is extended inwards to the previous shell boundary.
+   * Shells must be given from the center outwards.
+   */
+  class LayeredDensity final : public DensityModel {
+
+    std::vector<double> boundaries_;                ///< The normalized outer radii.
+    std::vector<std::array<double, 4>> coeffs_;     ///< The polynomial coefficients.
+    std::vector<MaterialID> materials_;             ///< The material of each shell.
+    std::vector<std::size_t> guide_;                ///< The first shell in each guide bin.
+
+    /**
+     * The number of bins in the guide table over x in [0, 1].
+     */
+    static constexpr std::size_t NGUIDE{4096};
+
+    public:
+    /**
+     * The default reference radius [km].
+     */
+    static constexpr double REFERENCE{6356.755};
+
+    /**
+     * Construct a LayeredDensity from a layer file.
+     *
+     * @param filename    The path to the layer file.
+     */
+    LayeredDensity(const std::string& filename);
+
+    /**
+     * Construct a LayeredDensity from a list of layers.
+     *
+     * @param layers      The shells ordered from the center outwards.
+     * @param reference   The Earth radius at which the layers are given [km].
+     */
+    LayeredDensity(const std::vector<Layer>& layers,
+                   const double reference = LayeredDensity::REFERENCE);
+
+    /**
+     * The density (in g/cm^3) at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto __attribute__((hot))
+    density(const double radius, const double Rearth) const -> double final override;
+
+    /**
+     * The material at a given radius.
+     *
+     * @param radius    The radius within the Earth [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    material(const double radius, const double Rearth) const -> MaterialID final override;
+
+    /**
+     * The exact radial column density between two radii [g/cm^3 * km].
+     *
+     * @param r0        The starting radius [km].
+     * @param r1        The final radius [km].
+     * @param Rearth    The radius *of* the Earth at this location [km].
+     */
+    auto
+    column(const double r0, const double r1, const double Rearth) const
+        -> double final override;
+
+    /**
+     * The column density through the shells is exact.
+     */
+    auto
+    analytic() const -> bool final override {
+      return true;
+    }
+
+    /**
+     * The number of compiled shells in this model.
+     */
+    auto
+    size() const -> std::size_t {
+      return boundaries_.size() - 1; // ignore the outer vacuum shell
+    }
+
+    private:
+    /**
+     * Compile a list of layers into the shell lookup arrays.
+     *
+     * @param layers      The shells ordered from the center outwards.
+     * @param reference   The Earth radius at which the layers are given [km].
+     */
+    auto
+    compile(const std::vector<Layer>& layers, const double reference) -> void;
+
+    /**
+     * Return the index of the shell containing a normalized radius.
+     *
+     * This returns size() (the vacuum shell) if the radius is outside
+     * every shell.
+     *
+     * @param x    The normalized radius.
+     */
+    auto
+    find_shell(const double x) const -> std::size_t;
+
+  }; // END: class LayeredDensity
+
+} // namespace apricot
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "apricot/Apricot.hpp"
+
 namespace apricot::PREM {
 
   ///
@@ -15,4 +17,28 @@ namespace apricot::PREM {
   auto __attribute__((hot)) density(const double radius, const double Rearth = 6356.799)
       -> double;
 
+  ///
+  /// \brief Return the PREM material at a given radius in km.
+  ///
+  /// This uses the same shell boundaries as PREM::density.
+  ///
+  /// @param radius    The radius within the Earth [km].
+  /// @param r_earth   The radius *of* the Earth at this location [km]
+  ///
+  auto
+  material(const double radius, const double Rearth = 6356.799) -> MaterialID;
+
+  ///
+  /// \brief Compute the exact PREM column density between two radii.
+  ///
+  /// This integrates the PREM polynomials shell-by-shell and returns
+  /// the result in g/cm^3 * km (negative if r1 < r0).
+  ///
+  /// @param r0        The starting radius [km].
+  /// @param r1        The final radius [km].
+  /// @param r_earth   The radius *of* the Earth at this location [km]
+  ///
+  auto
+  column(const double r0, const double r1, const double Rearth = 6356.799) -> double;
+
 } // namespace apricot::PREM
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "apricot/Coordinates.hpp"
+#include "apricot/DensityModel.hpp"
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A 3D voxel grid of densities over a bounded region.
+   *
+   * The grid is an axis-aligned box in geocentric cartesian
+   * coordinates that is divided into nx * ny * nz equal voxels, each
+   * with a constant density and material. It is layered on top of the
+   * radial density model of an Earth (see `Earth::add`) so that the
+   * grid replaces the radial model inside the box.
+   *
+   * Rays are integrated through the grid exactly, one voxel at a time,
+   * using the voxel traversal of Amanatides & Woo (1987) so that the
+   * cost of a step scales with the number of voxels that it crosses.
+   *
+   * The file format is line-based; '#' starts a comment.
+   *
+   *     origin <x> <y> <z>
+   *     spacing <dx> <dy> <dz>
+   *     shape <nx> <ny> <nz>
+   *     fill <material> <density [g/cm^3]>
+   *     voxel <i> <j> <k> <material> <density [g/cm^3]>
+   *
+   * `origin` is the minimum corner of the grid and `spacing` the size
+   * of each voxel [km]. `fill` sets every voxel that is not given by a
+   * `voxel` row (default: vacuum). `origin`, `spacing`, and `shape` must
+   * come before any `fill` or `voxel` rows.
+   */
+  class VoxelDensity final {
+
+    Vector origin_;                      ///< The minimum corner of the grid [km].
+    Vector upper_;                       ///< The maximum corner of the grid [km].
+    Vector spacing_;                     ///< The size of a single voxel [km].
+    std::array<int, 3> shape_;           ///< The number of voxels along each axis.
+    std::vector<double> densities_;      ///< The density in each voxel [g/cm^3].
+    std::vector<MaterialID> materials_;  ///< The material in each voxel.
+
+    public:
+    /**
+     * The distance that rays are stepped across the edge of the grid [km].
+     *
+     * This guarantees that a ray that is clipped to the edge of the
+     * grid ends up on the correct side of it.
+     */
+    static constexpr double EDGE{1e-9};
+
+    /**
+     * Construct a VoxelDensity from a voxel file.
+     *
+     * @param filename    The path to the voxel file.
+     */
+    VoxelDensity(const std::string& filename);
+
+    /**
+     * Construct a VoxelDensity from flattened voxel arrays.
+     *
+     * The arrays are indexed by i + nx * (j + ny * k).
+     *
+     * @param origin      The minimum corner of the grid [km].
+     * @param spacing     The size of a single voxel [km].
+     * @param shape       The number of voxels along each axis.
+     * @param densities   The density in each voxel [g/cm^3].
+     * @param materials   The material in each voxel.
+     */
+    VoxelDensity(const Vector& origin,
+                 const Vector& spacing,
+                 const std::array<int, 3>& shape,
+                 const std::vector<double>& densities,
+                 const std::vector<MaterialID>& materials);
+
+    /**
+     * Check whether a location is inside the grid.
+     *
+     * @param location    A geocentric coordinate [km].
+     */
+    auto
+    contains(const CartesianCoordinate& location) const -> bool {
+      return (location.array() >= origin_.array()).all() &&
+             (location.array() < upper_.array()).all();
+    }
+
+    /**
+     * The density (in g/cm^3) at a location inside the grid.
+     *
+     * @param location    A geocentric coordinate inside the grid [km].
+     */
+    auto
+    density(const CartesianCoordinate& location) const -> double {
+      return densities_[index(location)];
+    }
+
+    /**
+     * The material at a location inside the grid.
+     *
+     * @param location    A geocentric coordinate inside the grid [km].
+     */
+    auto
+    material(const CartesianCoordinate& location) const -> MaterialID {
+      return materials_[index(location)];
+    }
+
+    /**
+     * The distance along a ray to the entry point of the grid.
+     *
+     * This returns zero if the location is inside the grid and
+     * infinity if the ray never enters the grid.
+     *
+     * @param location    The start of the ray [km].
+     * @param direction   The unit-length direction of the ray.
+     */
+    auto
+    entry(const CartesianCoordinate& location, const Vector& direction) const -> double;
+
+    /**
+     * Walk a ray through the grid one voxel at a time.
+     *
+     * This walks from `location` along `direction` until either
+     * `grammage` has been accumulated, in which case it stops at the
+     * exact point inside the final voxel and returns `grammage`, or
+     * until the ray leaves the grid, in which case it stops just
+     * outside the grid and returns the grammage that was crossed,
+     * or until it has travelled `length`, in which case it stops
+     * there and returns the grammage that was crossed. `location` is
+     * updated to the end point of the walk.
+     *
+     * @param location    The start of the ray inside the grid [km].
+     * @param direction   The unit-length direction of the ray.
+     * @param grammage    The maximum grammage to accumulate [g/cm^2].
+     * @param length      The maximum distance to walk [km].
+     */
+    auto
+    walk(CartesianCoordinate& location,
+         const Vector& direction,
+         const double grammage,
+         const double length = std::numeric_limits<double>::infinity()) const -> double;
+
+    /**
+     * The number of voxels along each axis.
+     */
+    auto
+    shape() const -> const std::array<int, 3>& {
+      return shape_;
+    }
+
+    /**
+     * The total number of voxels in the grid.
+     */
+    auto
+    size() const -> std::size_t {
+      return densities_.size();
+    }
+
+    private:
+    /**
+     * Check the grid parameters and compute the upper corner.
+     */
+    auto
+    validate() -> void;
+
+    /**
+     * The flattened index of the voxel containing a location.
+     *
+     * @param location    A geocentric coordinate inside the grid [km].
+     */
+    auto
+    index(const CartesianCoordinate& location) const -> std::size_t;
+
+  }; // END: class VoxelDensity
+
+} // namespace apricot
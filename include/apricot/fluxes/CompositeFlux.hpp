@@ -0,0 +1,155 @@
+#pragma once
+
+#include "apricot/AliasTable.hpp"
+#include "apricot/Flux.hpp"
+#include "apricot/Particle.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A flux that is a mixture of several components.
+   *
+   * This has two modes:
+   *
+   *   1. A mixture of complete fluxes (i.e. `UniformProtonFlux`
+   *      and `UniformIronFlux`) with a fixed fraction of each.
+   *      Each trial picks a component and returns its particle.
+   *
+   *   2. A single energy spectrum with an energy-dependent
+   *      composition. Each trial samples an energy from the
+   *      spectrum and then picks the species at that energy.
+   *      The fractions are tabulated at a set of energies and
+   *      linearly interpolated between them.
+   *
+   * In both modes, the component is chosen with an alias table
+   * so each choice is O(1) for any number of components. Fractions
+   * are normalized (at each energy) so they can be given as
+   * relative intensities. The generation weight of each particle
+   * is the weight of the component (or spectrum) that it was
+   * sampled from divided by the fraction of its component (at its
+   * energy), so each species can be reweighted to its own flux.
+   */
+  class CompositeFlux final : public Flux {
+
+    public:
+    /**
+     * A function that creates a species of particle at an energy [log10(eV)].
+     */
+    using Species = std::function<ParticlePtr(const LogEnergy)>;
+
+    private:
+    std::vector<std::shared_ptr<const Flux>> fluxes_; ///< The component fluxes (mode 1).
+    std::shared_ptr<const Flux> spectrum_;            ///< The energy spectrum (mode 2).
+    std::vector<Species> species_;                    ///< The species of each component (mode 2).
+    std::vector<LogEnergy> energies_;                 ///< The tabulated energies [log10(eV)].
+    std::vector<AliasTable> tables_;                  ///< The composition at each energy.
+
+    public:
+    /**
+     * Mix several fluxes with a fixed fraction of each.
+     *
+     * @param fluxes       The component fluxes.
+     * @param fractions    The (relative) fraction of each component.
+     */
+    CompositeFlux(const std::vector<std::shared_ptr<const Flux>>& fluxes,
+                  const std::vector<double>& fractions);
+
+    /**
+     * Sample energies from a spectrum and species from a fixed composition.
+     *
+     * @param spectrum     The flux that energies (and weights) are sampled from.
+     * @param species      The species of each component.
+     * @param fractions    The (relative) fraction of each species.
+     */
+    CompositeFlux(const std::shared_ptr<const Flux>& spectrum,
+                  const std::vector<Species>& species,
+                  const std::vector<double>& fractions);
+
+    /**
+     * Sample energies from a spectrum and species from an energy-dependent composition.
+     *
+     * @param spectrum     The flux that energies (and weights) are sampled from.
+     * @param species      The species of each component.
+     * @param energies     The (strictly increasing) energies of the composition [log10(eV)].
+     * @param fractions    The (relative) fraction of each species at each energy.
+     */
+    CompositeFlux(const std::shared_ptr<const Flux>& spectrum,
+                  const std::vector<Species>& species,
+                  const std::vector<LogEnergy>& energies,
+                  const std::vector<std::vector<double>>& fractions);
+
+    /**
+     * Sample neutrinos from a spectrum with fixed flavor ratios.
+     *
+     * Each neutrino is created by `Neutrino::from_generation`.
+     *
+     * @param spectrum    The flux that energies (and weights) are sampled from.
+     * @param ratios      The (relative) fraction of electron, muon, and tau neutrinos.
+     */
+    static auto
+    neutrinos(const std::shared_ptr<const Flux>& spectrum,
+              const std::vector<double>& ratios = {1., 1., 1.}) -> CompositeFlux;
+
+    /**
+     * The species of one of the built-in particles.
+     *
+     * @param pdgid    The PDG ID of the particle.
+     */
+    static auto
+    species(const ParticleID pdgid) -> Species;
+
+    /**
+     * Return the next particle from this flux model.
+     */
+    auto
+    get_particle() const -> std::unique_ptr<Particle> final override;
+
+    /**
+     * The (normalized) fraction of a component at an energy.
+     *
+     * @param component    The index of the component.
+     * @param energy       The energy [log10(eV)].
+     */
+    auto
+    fraction(const std::size_t component, const LogEnergy energy) const -> double;
+
+    /**
+     * The number of components in this flux.
+     */
+    auto
+    size() const -> std::size_t {
+      return tables_.front().size();
+    }
+
+    /**
+     * A virtual destructor.
+     */
+    virtual ~CompositeFlux() = default;
+
+    private:
+    /**
+     * Choose the composition table for an energy.
+     *
+     * Between two tabulated energies, this picks the upper table
+     * with a probability that grows linearly across the interval
+     * so the sampled fractions are linearly interpolated.
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    table(const LogEnergy energy) const -> const AliasTable&;
+
+    /**
+     * The interval that contains an energy and the position in it.
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    locate(const LogEnergy energy) const -> std::pair<std::size_t, double>;
+
+  }; // END: class CompositeFlux
+
+} // namespace apricot
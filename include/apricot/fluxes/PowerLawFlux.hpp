@@ -0,0 +1,166 @@
+#pragma once
+
+#include "apricot/Flux.hpp"
+#include "apricot/Particle.hpp"
+#include <memory>
+#include <vector>
+
+namespace apricot {
+
+  /* An alias for energies in log10(eV) */
+  using LogEnergy = double;
+
+  /**
+   * A (broken) power-law energy spectrum, dN/dE ∝ E^-γ.
+   *
+   * The spectrum is a sequence of power laws that are continuous
+   * at each break energy. The cumulative distribution of each
+   * segment is known in closed form so each sample is one uniform
+   * random number, a search over the (few) segments, and an
+   * analytic inversion within the segment.
+   *
+   * The spectrum is zero outside of the first and last energies.
+   */
+  class PowerLawSpectrum final {
+
+    std::vector<LogEnergy> energies_; ///< The energy of each break [log10(eV)].
+    std::vector<double> indices_;     ///< The spectral index, γ, of each segment.
+    std::vector<double> amplitudes_;  ///< ln(dN/dE) at the start of each segment.
+    std::vector<double> cdf_;         ///< The normalized cumulative spectrum at each break.
+    double total_{0.};                ///< The integral of the spectrum over energy.
+
+    public:
+    /**
+     * Create a broken power-law spectrum.
+     *
+     * @param energies    The (strictly increasing) break energies [log10(eV)].
+     * @param indices     The spectral index, γ, between each pair of energies.
+     */
+    PowerLawSpectrum(const std::vector<LogEnergy>& energies, const std::vector<double>& indices);
+
+    /**
+     * Sample a random energy from the spectrum [log10(eV)].
+     */
+    auto
+    sample() const -> LogEnergy;
+
+    /**
+     * The probability density of sampling an energy, dP/dE [1/eV].
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    pdf(const LogEnergy energy) const -> double;
+
+    /**
+     * The generation weight of an energy, 1 / (dP/dE) [eV].
+     *
+     * This is zero outside of the spectrum as these
+     * energies are never generated.
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    weight(const LogEnergy energy) const -> double;
+
+    /**
+     * The break energies of the spectrum [log10(eV)].
+     */
+    auto
+    get_energies() const -> const std::vector<LogEnergy>& {
+      return energies_;
+    }
+
+    /**
+     * The spectral index of each segment.
+     */
+    auto
+    get_indices() const -> const std::vector<double>& {
+      return indices_;
+    }
+
+    private:
+    /**
+     * The index of the segment that contains an energy.
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    segment(const LogEnergy energy) const -> std::size_t;
+
+    /**
+     * ln(dP/dE) at an energy within the spectrum [ln(1/eV)].
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    log_pdf(const LogEnergy energy) const -> double;
+
+  }; // END: class PowerLawSpectrum
+
+  /**
+   * Produce a flux of one particle type with a (broken) power-law spectrum.
+   *
+   * Each particle carries its generation weight, 1 / (dP/dE),
+   * so events can be reweighted to any other spectrum.
+   *
+   * The template argument specifies the particle type
+   * that is generated at each trial.
+   *
+   */
+  template <typename ParticleType> class PowerLawFlux final : public Flux {
+
+    public:
+    /**
+     * The spectrum that we sample energies from.
+     */
+    const PowerLawSpectrum spectrum_;
+
+    /**
+     * Sample a particle species from a power-law spectrum.
+     *
+     * @param index         The spectral index, γ, of dN/dE ∝ E^-γ.
+     * @param min_energy    The minimum particle energy in log10(eV).
+     * @param max_energy    The maximum particle energy in log10(eV).
+     */
+    PowerLawFlux(const double index, const LogEnergy min_energy, const LogEnergy max_energy) :
+        PowerLawFlux({min_energy, max_energy}, {index}){};
+
+    /**
+     * Sample a particle species from a broken power-law spectrum.
+     *
+     * @param energies    The (strictly increasing) break energies in log10(eV).
+     * @param indices     The spectral index, γ, between each pair of energies.
+     */
+    PowerLawFlux(const std::vector<LogEnergy>& energies, const std::vector<double>& indices) :
+        spectrum_(energies, indices){};
+
+    /**
+     * Return the next particle from this flux model.
+     */
+    auto
+    get_particle() const -> std::unique_ptr<Particle> final override {
+
+      // choose a random energy
+      const LogEnergy energy{spectrum_.sample()};
+
+      // and create the particle with its generation weight
+      auto particle{std::make_unique<ParticleType>(energy)};
+      particle->set_weight(spectrum_.weight(energy));
+
+      return particle;
+    }
+
+    /**
+     * A virtual destructor.
+     */
+    virtual ~PowerLawFlux() = default;
+
+  }; // END: class PowerLawFlux
+
+  /**
+   * A broken power-law flux is a power-law flux with several segments.
+   */
+  template <typename ParticleType> using BrokenPowerLawFlux = PowerLawFlux<ParticleType>;
+
+} // namespace apricot
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "apricot/Flux.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace apricot {
+
+  /* Forward declarations */
+  class Particle;
+
+  /* An alias for energies in log10(eV) */
+  using LogEnergy = double;
+
+  /**
+   * A tabulated energy spectrum, dN/dE, that can be sampled.
+   *
+   * The spectrum is interpolated as a power law between adjacent
+   * points (or linearly in log10(E) if either point is zero) so
+   * the cumulative distribution in log10(E) of each interval is
+   * known in closed form. This is built once at construction and
+   * each sample is one uniform random number, a binary search for
+   * the interval, and an analytic inversion within the interval.
+   *
+   * The spectrum is zero outside of the tabulated energies.
+   */
+  class SpectrumTable final {
+
+    std::vector<LogEnergy> energies_; ///< The energy of each point [log10(eV)].
+    std::vector<double> densities_;   ///< dN/dlog10(E) at each point.
+    std::vector<double> cdf_;         ///< The normalized cumulative spectrum at each point.
+    double total_{0.};                ///< The integral of the spectrum over energy.
+
+    public:
+    /**
+     * Tabulate a spectrum.
+     *
+     * @param energies    The (strictly increasing) energies [log10(eV)].
+     * @param flux        The (non-negative) flux, dN/dE, at each energy.
+     */
+    SpectrumTable(const std::vector<LogEnergy>& energies, const std::vector<double>& flux);
+
+    /**
+     * Load a spectrum from a file.
+     *
+     * Each row contains a (strictly increasing) energy [log10(eV)]
+     * and the flux, dN/dE, at that energy in any units. Comments
+     * begin with '#'.
+     *
+     * @param filename    The file to load.
+     */
+    SpectrumTable(const std::string& filename);
+
+    /**
+     * Sample a random energy from the spectrum [log10(eV)].
+     */
+    auto
+    sample() const -> LogEnergy;
+
+    /**
+     * Evaluate the interpolated flux, dN/dE.
+     *
+     * @param energy    The energy [log10(eV)].
+     */
+    auto
+    flux(const LogEnergy energy) const -> double;
+
+    /**
+     * The integral of the flux over all tabulated energies.
+     */
+    auto
+    integral() const -> double {
+      return total_;
+    }
+
+    /**
+     * The smallest tabulated energy [log10(eV)].
+     */
+    auto
+    get_min_energy() const -> LogEnergy {
+      return energies_.front();
+    }
+
+    /**
+     * The largest tabulated energy [log10(eV)].
+     */
+    auto
+    get_max_energy() const -> LogEnergy {
+      return energies_.back();
+    }
+
+    private:
+    /**
+     * Build the cumulative spectrum.
+     *
+     * @param energies    The (strictly increasing) energies [log10(eV)].
+     * @param flux        The (non-negative) flux, dN/dE, at each energy.
+     */
+    auto
+    compile(const std::vector<LogEnergy>& energies, const std::vector<double>& flux) -> void;
+
+    /**
+     * The integral of dN/dlog10(E) over an interval.
+     *
+     * @param i    The index of the interval.
+     */
+    auto
+    segment(const std::size_t i) const -> double;
+
+  }; // END: class SpectrumTable
+
+  /**
+   * Produce a flux of one particle type from a tabulated spectrum.
+   *
+   * The template argument specifies the particle type
+   * that is generated at each trial.
+   *
+   */
+  template <typename ParticleType> class TabulatedFlux final : public Flux {
+
+    public:
+    /**
+     * The spectrum that we sample energies from.
+     */
+    const std::shared_ptr<const SpectrumTable> spectrum_;
+
+    /**
+     * Sample a particle species from a spectrum file.
+     *
+     * @param filename    The file of `<log10(E/eV)> <dN/dE>` rows.
+     */
+    TabulatedFlux(const std::string& filename) :
+        spectrum_(std::make_shared<const SpectrumTable>(filename)){};
+
+    /**
+     * Sample a particle species from a (shared) spectrum.
+     *
+     * @param spectrum    The spectrum to sample energies from.
+     */
+    TabulatedFlux(const std::shared_ptr<const SpectrumTable>& spectrum) : spectrum_(spectrum){};
+
+    /**
+     * Return the next particle from this flux model.
+     */
+    auto
+    get_particle() const -> std::unique_ptr<Particle> final override {
+      return std::make_unique<ParticleType>(spectrum_->sample());
+    }
+
+    /**
+     * A virtual destructor.
+     */
+    virtual ~TabulatedFlux() = default;
+
+  }; // END: class TabulatedFlux
+
+} // namespace apricot
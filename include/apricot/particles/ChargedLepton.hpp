@@ -4,16 +4,12 @@
 #include "apricot/InteractionInfo.hpp"
 #include "apricot/Particle.hpp"
 #include "apricot/particles/Decayable.hpp"
+#include "apricot/particles/EnergyLossTable.hpp"
 #include "apricot/particles/TauDecayTable.hpp"
 #include <cmath>
 
 namespace apricot {
 
-  /**
-   * The supported energy loss models for charged leptons.
-   */
-  enum class LeptonEnergyLossModel { BDHM, Soyez, ALLM, BS };
-
   /**
    * An abstract base class for all charged leptons.
    *
@@ -78,13 +74,6 @@ namespace apricot {
      */
     const double mass_;
 
-    /**
-     * The model to use for leptonic energy loss.
-     *
-     * This is set for all instances of the ChargedLepton classes.
-     */
-    inline static auto energy_loss_model{LeptonEnergyLossModel::ALLM};
-
   }; // END: class ChargedLepton
 
   /**
@@ -168,12 +157,14 @@ namespace apricot {
     /**
      * Return the next interaction that this muon will experience.
      *
-     * Since we use a continuous energy loss model for the muon-matter
-     * interactions, our only 'discrete' Muon interaction is a decay.
-     * This currently always returns a Muon decay with a randomly
+     * This samples the next catastrophic (bremsstrahlung, pair
+     * production, or photonuclear) loss from the `StochasticLossTable`
+     * of the current energy loss model. Losses below the table's vcut
+     * are continuous. If the muon ranges out before its next
+     * catastrophic loss, this returns a Muon decay with a randomly
      * sampled lifetime.
      *
-     * @returns A default InteractionInfo instance (no interaction).
+     * @returns The type and grammage of the next catastrophic loss.
      */
     auto
     get_interaction() const -> InteractionInfo final override;
@@ -240,8 +231,8 @@ namespace apricot {
     /**
      * Get the decay products of a Tau decay.
      *
-     * This uses a TauDecayTable to sample random tau decay's
-     * produced using TAUOLA.
+     * This samples a random decay from the shared TauDecayTable
+     * (see `TauDecayTable::get`), by default produced using TAUOLA.
      *
      * @returns   A randomly chosen particle from a tau decay.
      */
@@ -268,12 +259,6 @@ namespace apricot {
      */
     static constexpr double lifetime_{2.903e-4};
 
-    private:
-    /**
-     * A TauDecayTable to produce random tau decays.
-     */
-    inline static const TauDecayTable decaytable_;
-
   }; // END: class Tau
 
 } // namespace apricot
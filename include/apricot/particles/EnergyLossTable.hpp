@@ -0,0 +1,169 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * The supported energy loss models for charged leptons.
+   *
+   * These select the photonuclear contribution to the energy loss.
+   */
+  enum class LeptonEnergyLossModel { BDHM, Soyez, ALLM, BS };
+
+  /**
+   * Continuous energy loss and range tables for a charged lepton.
+   *
+   * A UHE lepton loses energy in matter at a rate
+   *
+   *     -dE/dX = alpha + beta(E) E
+   *
+   * where alpha is the ionization loss and beta(E) is the sum of the
+   * bremsstrahlung, pair production, and photonuclear coefficients.
+   * This tabulates beta(E) on a uniform grid in log10(energy) and
+   * integrates it, once, into the continuous-slowing-down range
+   * X(E) - the grammage for the lepton to slow from E down to EMIN.
+   * The energy after crossing any grammage X is then the inverse of
+   * X(E) - X, so that energy loss over a step is a single table
+   * lookup rather than an integration.
+   *
+   * The built-in beta(E) are smooth fits (quadratic in
+   * log10(E/GeV)) to the standard rock coefficients of taus and muons
+   * for each photonuclear model, and are accurate to ~10-20% for
+   * 1e3 < E < 1e13 GeV; tables of beta(E) can also be loaded from a
+   * file with rows of `<log10(E/eV)> <beta [cm^2/g]>`. Energies are
+   * clamped to [EMIN, EMAX].
+   */
+  class EnergyLossTable final {
+
+    double alpha_;               ///< The ionization loss [eV cm^2/g].
+    std::vector<double> betas_;  ///< beta(E) at each node [cm^2/g].
+    std::vector<double> ranges_; ///< The range, X(E), at each node [g/cm^2].
+
+    public:
+    /**
+     * The smallest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMIN{9.};
+
+    /**
+     * The largest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMAX{22.};
+
+    /**
+     * The number of intervals in the energy grid.
+     */
+    static constexpr int NBINS{1300};
+
+    /**
+     * The default ionization loss in standard rock [eV cm^2/g].
+     */
+    static constexpr double ALPHA{2e6};
+
+    /**
+     * Tabulate the built-in energy loss of a lepton.
+     *
+     * @param id       The PDG ID of the lepton (a muon or a tau).
+     * @param model    The photonuclear energy loss model.
+     */
+    EnergyLossTable(const ParticleID id, const LeptonEnergyLossModel model);
+
+    /**
+     * Tabulate beta(E) loaded from a file.
+     *
+     * @param filename    The file of `<log10(E/eV)> <beta [cm^2/g]>` rows.
+     * @param alpha       The ionization loss [eV cm^2/g].
+     */
+    EnergyLossTable(const std::string& filename, const double alpha = ALPHA);
+
+    /**
+     * Tabulate beta(E) given at every node of the energy grid.
+     *
+     * @param betas    beta(E) at each of the NBINS + 1 nodes [cm^2/g].
+     * @param alpha    The ionization loss [eV cm^2/g].
+     */
+    EnergyLossTable(std::vector<double> betas, const double alpha = ALPHA);
+
+    /**
+     * Get the shared table for a lepton and energy loss model.
+     *
+     * The tables are built the first time that any is requested.
+     *
+     * @param id       The PDG ID of the lepton (a muon or a tau).
+     * @param model    The photonuclear energy loss model.
+     */
+    static auto
+    get(const ParticleID id, const LeptonEnergyLossModel model) -> const EnergyLossTable&;
+
+    /**
+     * The built-in contributions to beta(E) of a lepton [cm^2/g].
+     *
+     * The fits are valid from 1e12 to 1e22 eV and are held constant
+     * outside of this range. The quadratic photonuclear fits have a
+     * minimum between 1e13 and 1e15 eV; below it they are held at
+     * their minimum so that beta(E) never decreases with energy.
+     *
+     * @param id        The PDG ID of the lepton (a muon or a tau).
+     * @param model     The photonuclear energy loss model.
+     * @param energy    The lepton energy [log10(eV)].
+     *
+     * @returns The bremsstrahlung + pair production and the photonuclear beta.
+     */
+    static auto
+    contributions(const ParticleID id, const LeptonEnergyLossModel model, const LogEnergy energy)
+        -> std::pair<double, double>;
+
+    /**
+     * The energy loss coefficient, beta(E) [cm^2/g].
+     *
+     * @param energy    The lepton energy [log10(eV)].
+     */
+    auto
+    beta(const LogEnergy energy) const -> double;
+
+    /**
+     * The grammage for a lepton to slow down to EMIN [g/cm^2].
+     *
+     * @param energy    The lepton energy [log10(eV)].
+     */
+    auto
+    range(const LogEnergy energy) const -> double;
+
+    /**
+     * The energy of a lepton after crossing some grammage [log10(eV)].
+     *
+     * This returns EMIN if the lepton ranges out.
+     *
+     * @param energy      The initial lepton energy [log10(eV)].
+     * @param grammage    The grammage crossed by the lepton [g/cm^2].
+     */
+    auto
+    energy(const LogEnergy energy, const double grammage) const -> LogEnergy;
+
+    /**
+     * The grammage for a lepton to slow between two energies [g/cm^2].
+     *
+     * @param initial    The initial lepton energy [log10(eV)].
+     * @param final      The final lepton energy [log10(eV)].
+     */
+    auto
+    grammage(const LogEnergy initial, const LogEnergy final) const -> double {
+      return range(initial) - range(final);
+    }
+
+    private:
+    /**
+     * Tabulate beta(E) and integrate the range table.
+     *
+     * @param betas    beta(E) at each node [cm^2/g].
+     */
+    auto
+    initialize(std::vector<double> betas) -> void;
+
+  }; // END: class EnergyLossTable
+
+} // namespace apricot
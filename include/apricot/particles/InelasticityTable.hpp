@@ -0,0 +1,127 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include "apricot/particles/NeutrinoYFactor.hpp"
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * Sample the inelasticity, y, of neutrino interactions.
+   *
+   * This tabulates the inverse of the cumulative distribution of a
+   * differential distribution, dN/dy, at a set of quantiles for every
+   * node of a uniform grid in log10(energy). The tables are built
+   * once (see `get`) and are only read afterwards, so they can be
+   * shared between threads. Each draw picks one of the two energy
+   * nodes around the energy (with the linear interpolation weight)
+   * and interpolates its quantiles, so sampling is O(1).
+   *
+   * The tables for the y-factor models use the shape
+   *
+   *     dN/dy ~ 1 / (y + c),  0 <= y <= 1,
+   *
+   * which is peaked at low y with a long tail to high y, with c chosen
+   * at every energy so that the mean is <y> from `y_factor`.
+   *
+   * The energy of the outgoing lepton is (1 - y) of the neutrino
+   * energy; the rest is deposited in the hadronic shower.
+   */
+  class InelasticityTable final {
+
+    std::vector<double> quantiles_; ///< The inverse CDF at each energy node.
+
+    public:
+    /**
+     * A differential distribution, dN/dy(energy [log10(eV)], y).
+     *
+     * This does not need to be normalized.
+     */
+    using Distribution = std::function<double(const LogEnergy, const double)>;
+
+    /**
+     * The smallest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMIN{15.};
+
+    /**
+     * The largest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMAX{22.};
+
+    /**
+     * The number of intervals in the energy grid.
+     */
+    static constexpr int NENERGIES{70};
+
+    /**
+     * The number of intervals in the quantile grid.
+     */
+    static constexpr int NQUANTILES{1024};
+
+    /**
+     * Tabulate an arbitrary differential distribution.
+     *
+     * @param distribution    The distribution, dN/dy, to tabulate.
+     */
+    InelasticityTable(const Distribution& distribution);
+
+    /**
+     * Tabulate the distribution for a y-factor model.
+     *
+     * @param model    The y-factor model that gives <y>.
+     */
+    InelasticityTable(const NeutrinoYFactorModel model);
+
+    /**
+     * Get the shared table for a y-factor model.
+     *
+     * Each table is built the first time it is requested.
+     *
+     * @param model    The y-factor model.
+     */
+    static auto
+    get(const NeutrinoYFactorModel model) -> const InelasticityTable&;
+
+    /**
+     * Sample an inelasticity at a given energy.
+     *
+     * Energies outside of [EMIN, EMAX] use the closest table.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    sample(const LogEnergy energy) const -> double;
+
+    /**
+     * The mean inelasticity of the table at a given energy.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    mean(const LogEnergy energy) const -> double;
+
+    private:
+    /**
+     * Interpolate the inverse CDF of an energy node.
+     *
+     * @param node    The index of the energy node.
+     * @param u       A quantile in [0, 1].
+     */
+    auto
+    quantile(const int node, const double u) const -> double {
+
+      // the fractional index of this quantile
+      const auto x{u * NQUANTILES};
+      const auto j{std::min(static_cast<int>(x), NQUANTILES - 1)};
+
+      // and interpolate linearly between the two quantiles
+      const auto* q{&quantiles_[node * (NQUANTILES + 1) + j]};
+      return q[0] + (x - j) * (q[1] - q[0]);
+    }
+
+  }; // END: class InelasticityTable
+
+} // namespace apricot
@@ -2,6 +2,8 @@
 
 #include "apricot/Particle.hpp"
 #include "apricot/particles/NeutrinoCrossSection.hpp"
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
+#include "apricot/particles/NeutrinoYFactor.hpp"
 #include <memory>
 
 namespace apricot {
@@ -29,6 +31,20 @@ namespace apricot {
     auto
     get_interaction() const -> InteractionInfo final override;
 
+    ///
+    /// \brief Sample the inelasticity (y) of an interaction at this energy.
+    ///
+    auto
+    sample_inelasticity() const -> double;
+
+    ///
+    /// \brief Sample the energy of the outgoing lepton in log10(eV).
+    ///
+    /// The lepton carries (1 - y) of the neutrino energy.
+    ///
+    auto
+    sample_lepton_energy() const -> LogEnergy;
+
     ///
     /// \brief Return a random neutrino from an energy and flavor.
     ///
@@ -43,11 +59,6 @@ namespace apricot {
     ///
     virtual ~Neutrino() = default;
 
-    ///
-    /// \brief The neutrino cross section model to use.
-    ///
-    inline static auto cross_section_model{NeutrinoCrossSectionModel::ConnollyMiddle};
-
   }; // END: class Neutrino
 
   ///
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "apricot/Apricot.hpp"
+#include "apricot/Coordinates.hpp"
 #include "apricot/Particle.hpp"
 
 namespace apricot {
@@ -10,6 +11,13 @@ namespace apricot {
    */
   using LogGrammage = double;
 
+  /**
+   * A read-only view of many energies in log10(eV).
+   *
+   * This wraps Eigen arrays and contiguous NumPy arrays without copying.
+   */
+  using EnergiesView = Eigen::Ref<const Array>;
+
   ///
   /// \brief Neutrino Cross Section Models
   ///
@@ -40,4 +48,22 @@ namespace apricot {
   auto __attribute__((hot)) neutral_current(const NeutrinoCrossSectionModel model,
                                             const LogEnergy energy) -> LogGrammage;
 
+  ///
+  /// \brief Get the charged current cross section at many energies in log10(eV).
+  ///
+  /// NOTE: This returns the cross-sections in log10(g/cm^2).
+  ///
+  auto
+  charged_current(const NeutrinoCrossSectionModel model, const EnergiesView& energies)
+      -> Array;
+
+  ///
+  /// \brief Get the neutral current cross section at many energies in log10(eV).
+  ///
+  /// NOTE: This returns the cross-sections in log10(g/cm^2).
+  ///
+  auto
+  neutral_current(const NeutrinoCrossSectionModel model, const EnergiesView& energies)
+      -> Array;
+
 } // namespace apricot
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "apricot/MonotoneSpline.hpp"
+#include "apricot/particles/NeutrinoCrossSection.hpp"
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * A precomputed table of neutrino interaction lengths.
+   *
+   * This tabulates the total (CC + NC) interaction length and the
+   * charged current branching ratio of a cross section model on a
+   * uniform grid in log10(energy) and interpolates them linearly, so
+   * that sampling an interaction needs one table lookup and a single
+   * exponential draw rather than evaluating (and exponentiating) both
+   * parametrizations. The grid spacing of 0.01 in log10(eV) keeps the
+   * relative interpolation error below ~1e-4.
+   *
+   * Energies outside of [EMIN, EMAX] are evaluated directly.
+   *
+   * Tables are either built from one of the built-in parametrizations
+   * (`NeutrinoCrossSectionModel`) or from tabulated charged and neutral
+   * current cross sections, e.g. loaded from a file, that are
+   * interpolated with a monotone spline in log10(cross section) vs.
+   * log10(energy). Both are sampled through the same grid so
+   * tabulated models are exactly as fast as the built-in ones.
+   *
+   * Every table is registered by name: there is one (read-only) table
+   * per built-in model, registered under the name of the model and built
+   * on first use, and any number of tabulated models can be added with
+   * `add` or `load` and then retrieved with `get`.
+   */
+  class NeutrinoCrossSectionTable final {
+
+    std::string name_;                               ///< The name of this model.
+    std::optional<NeutrinoCrossSectionModel> model_; ///< The built-in model (if any).
+    std::optional<MonotoneSpline> charged_;          ///< The tabulated CC cross section.
+    std::optional<MonotoneSpline> neutral_;          ///< The tabulated NC cross section.
+    std::vector<double> lengths_;                    ///< The total interaction length [g/cm^2].
+    std::vector<double> fractions_;                  ///< The charged current fraction.
+
+    public:
+    /**
+     * The smallest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMIN{12.};
+
+    /**
+     * The largest tabulated energy [log10(eV)].
+     */
+    static constexpr LogEnergy EMAX{22.};
+
+    /**
+     * The number of intervals in the energy grid.
+     */
+    static constexpr int NBINS{1000};
+
+    /**
+     * Tabulate a neutrino cross section model.
+     *
+     * @param model    The cross section model to tabulate.
+     */
+    NeutrinoCrossSectionTable(const NeutrinoCrossSectionModel model);
+
+    /**
+     * Tabulate a model from its charged and neutral current cross sections.
+     *
+     * The cross sections are per nucleon of an isoscalar target. Beyond
+     * the tabulated energies they are extrapolated as a power law.
+     *
+     * @param name        The name of this model.
+     * @param energies    The (increasing) energies of the table [log10(eV)].
+     * @param charged     The charged current cross section at each energy [cm^2].
+     * @param neutral     The neutral current cross section at each energy [cm^2].
+     */
+    NeutrinoCrossSectionTable(const std::string& name,
+                              const std::vector<LogEnergy>& energies,
+                              const std::vector<double>& charged,
+                              const std::vector<double>& neutral);
+
+    /**
+     * Get the shared table for a cross section model.
+     *
+     * Each table is built the first time it is requested.
+     *
+     * @param model    The cross section model.
+     */
+    static auto
+    get(const NeutrinoCrossSectionModel model) -> const NeutrinoCrossSectionTable&;
+
+    /**
+     * Get a registered model by name.
+     *
+     * The built-in models are registered under their names
+     * (i.e. "ConnollyMiddle").
+     *
+     * @param name    The name of the model.
+     */
+    static auto
+    get(const std::string& name) -> const NeutrinoCrossSectionTable&;
+
+    /**
+     * Register a tabulated cross section model.
+     *
+     * This replaces any model with the same name; replaced models
+     * are kept alive so references to them remain valid.
+     *
+     * @param name        The name of the new model.
+     * @param energies    The (increasing) energies of the table [log10(eV)].
+     * @param charged     The charged current cross section at each energy [cm^2].
+     * @param neutral     The neutral current cross section at each energy [cm^2].
+     *
+     * @returns The registered model.
+     */
+    static auto
+    add(const std::string& name,
+        const std::vector<LogEnergy>& energies,
+        const std::vector<double>& charged,
+        const std::vector<double>& neutral) -> const NeutrinoCrossSectionTable&;
+
+    /**
+     * Load and register a tabulated cross section model from a file.
+     *
+     * Each row of the file contains the energy [log10(eV)] and the
+     * charged and neutral current neutrino cross sections [cm^2],
+     * optionally followed by the charged and neutral current
+     * anti-neutrino cross sections; as apricot does not distinguish
+     * neutrinos from anti-neutrinos, these are then averaged.
+     * Everything after a '#' is a comment.
+     *
+     * @param name        The name of the new model.
+     * @param filename    The file to load.
+     *
+     * @returns The registered model.
+     */
+    static auto
+    load(const std::string& name, const std::string& filename)
+        -> const NeutrinoCrossSectionTable&;
+
+    /**
+     * The names of every registered model.
+     */
+    static auto
+    names() -> std::vector<std::string>;
+
+    /**
+     * The total interaction length and charged current fraction.
+     *
+     * The interaction length is returned in g/cm^2.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    lookup(const LogEnergy energy) const -> std::pair<double, double> {
+
+      // outside of the table, we evaluate the model directly
+      if (!(energy >= EMIN && energy < EMAX)) return evaluate(energy);
+
+      // the fractional index of this energy
+      const auto x{(energy - EMIN) * (NBINS / (EMAX - EMIN))};
+      const auto i{static_cast<std::size_t>(x)};
+      const auto f{x - i};
+
+      // and interpolate linearly between the two nodes
+      return {lengths_[i] + f * (lengths_[i + 1] - lengths_[i]),
+              fractions_[i] + f * (fractions_[i + 1] - fractions_[i])};
+    }
+
+    /**
+     * The total interaction length [g/cm^2].
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    interaction_length(const LogEnergy energy) const -> double {
+      return lookup(energy).first;
+    }
+
+    /**
+     * The fraction of interactions that are charged current.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    charged_fraction(const LogEnergy energy) const -> double {
+      return lookup(energy).second;
+    }
+
+    /**
+     * The charged current cross section [log10(cm^2)].
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    charged_current(const LogEnergy energy) const -> LogGrammage;
+
+    /**
+     * The neutral current cross section [log10(cm^2)].
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    neutral_current(const LogEnergy energy) const -> LogGrammage;
+
+    /**
+     * Get the built-in cross section model of this table (if any).
+     */
+    auto
+    get_model() const -> std::optional<NeutrinoCrossSectionModel> {
+      return model_;
+    }
+
+    /**
+     * Get the name of the model of this table.
+     */
+    auto
+    get_name() const -> const std::string& {
+      return name_;
+    }
+
+    private:
+    /**
+     * Evaluate the model at every node of the energy grid.
+     */
+    auto
+    tabulate() -> void;
+
+    /**
+     * Evaluate the interaction length and charged current fraction directly.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     */
+    auto
+    evaluate(const LogEnergy energy) const -> std::pair<double, double>;
+
+  }; // END: class NeutrinoCrossSectionTable
+
+} // namespace apricot
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "apricot/Apricot.hpp"
+#include "apricot/particles/NeutrinoCrossSection.hpp"
 
 namespace apricot {
 
@@ -22,4 +23,13 @@ namespace apricot {
   auto
   y_factor(const LogEnergy energy, const NeutrinoYFactorModel& model) -> double;
 
+  ///
+  /// \brief Evaluate the y-factor for a neutrino at many energies.
+  ///
+  /// @param energies  The energies in log10(eV).
+  /// @param model     The neutrino y-factor model to use.
+  ///
+  auto
+  y_factor(const EnergiesView& energies, const NeutrinoYFactorModel& model) -> Array;
+
 } // namespace apricot
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include "apricot/InteractionInfo.hpp"
+#include "apricot/particles/EnergyLossTable.hpp"
+#include <array>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * The radiative processes that produce catastrophic lepton energy losses.
+   */
+  enum class LossProcess { Bremsstrahlung, PairProduction, Photonuclear };
+
+  /**
+   * Continuous and stochastic energy loss tables for a charged lepton.
+   *
+   * Each radiative process, p, loses a fraction v of the lepton
+   * energy with an (energy-weighted) spectrum v dN/dv ~ phi_p(v) and
+   * contributes beta_p(E) to the total energy loss. Losses with
+   * v < vcut are frequent and small and are treated as a continuous
+   * loss, beta_c(E) = sum_p beta_p(E) g_p, where g_p is the fraction
+   * of phi_p below vcut. Losses with v > vcut are sampled one at a
+   * time as catastrophic losses, which occur at a total rate (per unit
+   * grammage) of R(E) = sum_p beta_p(E) h_p.
+   *
+   * Since the lepton slows down continuously between catastrophic
+   * losses, we also tabulate the cumulative number of losses, T(E),
+   * that a lepton would experience while slowing down from E to EMIN.
+   * The next loss then occurs at the energy E* where T(E*) = T(E) - t,
+   * for an exponentially distributed t, so finding the next loss is
+   * one random number and one table inversion. The process is chosen
+   * in proportion to its rate at E* and v is drawn from a per-process
+   * inverse CDF table in log(v).
+   *
+   * The spectral shapes are approximate: (4/3)(1 - v) + v^2 for
+   * bremsstrahlung, (1 - v) / v for pair production, and
+   * 1 - v + v^2 / 2 for photonuclear losses. The built-in
+   * bremsstrahlung + pair production coefficients are split between
+   * the two processes in a fixed ratio.
+   */
+  class StochasticLossTable final {
+
+    public:
+    /**
+     * The number of radiative processes.
+     */
+    static constexpr std::size_t NPROCESSES{3};
+
+    /**
+     * The number of quantiles in each loss fraction table.
+     */
+    static constexpr std::size_t NQUANTILES{256};
+
+    /**
+     * The default fraction of the lepton energy above which losses are stochastic.
+     */
+    static constexpr double VCUT{1e-2};
+
+    /**
+     * The fraction of the bremsstrahlung + pair production loss due to bremsstrahlung.
+     */
+    static constexpr double BREMSSTRAHLUNG{0.4};
+
+    private:
+    /**
+     * A table with one entry per process.
+     */
+    template <typename T>
+    using PerProcess = std::array<T, NPROCESSES>;
+
+    double vcut_;                                     ///< The stochastic loss threshold.
+    EnergyLossTable continuous_;                      ///< The continuous loss below vcut.
+    PerProcess<std::vector<double>> rates_;           ///< Each rate at each node [cm^2/g].
+    std::vector<double> depths_;                      ///< The number of losses, T(E), at each node.
+    PerProcess<std::array<double, NQUANTILES>> logv_; ///< The quantiles of ln(v) of each process.
+
+    public:
+    /**
+     * Tabulate the built-in energy losses of a lepton.
+     *
+     * @param id       The PDG ID of the lepton (a muon or a tau).
+     * @param model    The photonuclear energy loss model.
+     * @param vcut     The fraction of the lepton energy above which losses are stochastic.
+     */
+    StochasticLossTable(const ParticleID id,
+                        const LeptonEnergyLossModel model,
+                        const double vcut = VCUT);
+
+    /**
+     * Get the shared table for a lepton and energy loss model.
+     *
+     * The tables are built the first time that any is requested.
+     *
+     * @param id       The PDG ID of the lepton (a muon or a tau).
+     * @param model    The photonuclear energy loss model.
+     */
+    static auto
+    get(const ParticleID id, const LeptonEnergyLossModel model) -> const StochasticLossTable&;
+
+    /**
+     * The continuous energy loss table (losses below vcut).
+     */
+    auto
+    continuous() const -> const EnergyLossTable& {
+      return continuous_;
+    }
+
+    /**
+     * The fraction of the lepton energy above which losses are stochastic.
+     */
+    auto
+    get_vcut() const -> double {
+      return vcut_;
+    }
+
+    /**
+     * The rate of catastrophic losses by one process [cm^2/g].
+     *
+     * @param process    The radiative process.
+     * @param energy     The lepton energy [log10(eV)].
+     */
+    auto
+    rate(const LossProcess process, const LogEnergy energy) const -> double;
+
+    /**
+     * The total rate of catastrophic losses [cm^2/g].
+     *
+     * @param energy    The lepton energy [log10(eV)].
+     */
+    auto
+    rate(const LogEnergy energy) const -> double;
+
+    /**
+     * Sample the energy at which the next catastrophic loss occurs.
+     *
+     * This returns EnergyLossTable::EMIN if the lepton ranges out first.
+     *
+     * @param energy    The current lepton energy [log10(eV)].
+     *
+     * @returns The lepton energy immediately before the loss [log10(eV)].
+     */
+    auto
+    next_loss(const LogEnergy energy) const -> LogEnergy;
+
+    /**
+     * Sample the process responsible for a catastrophic loss.
+     *
+     * @param energy    The lepton energy at the loss [log10(eV)].
+     */
+    auto
+    sample_process(const LogEnergy energy) const -> LossProcess;
+
+    /**
+     * Sample the fraction of the lepton energy lost in a catastrophic loss.
+     *
+     * @param process    The process responsible for this loss.
+     *
+     * @returns The fraction, v, in [vcut, 1].
+     */
+    auto
+    sample_fraction(const LossProcess process) const -> double;
+
+    /**
+     * The interaction type of a radiative process.
+     *
+     * @param process    The radiative process.
+     */
+    static auto
+    interaction(const LossProcess process) -> InteractionType;
+
+  }; // END: class StochasticLossTable
+
+} // namespace apricot
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "apricot/Apricot.hpp"
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace apricot {
 
@@ -73,65 +78,207 @@ namespace apricot {
   };
 
   /**
-   * Read and sample from a file of sampled tau decays.
+   * The binning of a tau decay table in tau energy and polarization.
+   */
+  struct TauDecayBinning {
+    int nenergies{1};      ///< The number of (uniform) bins in log10(E).
+    LogEnergy emin{15.};   ///< The lower edge of the first energy bin [log10(eV)].
+    LogEnergy emax{21.};   ///< The upper edge of the last energy bin [log10(eV)].
+    int npolarizations{1}; ///< The number of (uniform) bins in polarization in [-1, 1].
+  };
+
+  /**
+   * Read and sample from a table of sampled tau decays.
    *
-   * This class reads tau decays stored in NuTauSim-format and provides
-   * methods to randomly sample simulations from this format.
-   * See /data/particle/tauola for more information on the format
-   * or see https://github.com/harmscho/NuTauSim for the original code.
+   * Each row of a table is one decay simulation showing the fraction
+   * of the tau energy transferred to (in order) the tau neutrino,
+   * muon neutrino, electron neutrino, hadronic, muon, and electron
+   * components, along with a weight.
    *
-   * Each row of the datafile corresponds to a different decay simulation
-   * showing the fractional energy transferred to the neutrino, leptonic,
-   * and hadronic components.
+   * Tables can be binned in the (log10) tau energy and in the tau
+   * polarization, in which case each draw only samples the rows of
+   * the bin containing the tau. Every bin stores a Walker alias table
+   * of its rows (built when the table is written), so a draw is a
+   * single uniform random number and two reads however large the
+   * table is.
+   *
+   * Tables are usually stored in a binary file that is memory-mapped
+   * when it is opened, so opening even a very large table costs
+   * (almost) nothing and rows are only paged in when they are
+   * sampled. Binary tables are written by `write` or converted from
+   * the NuTauSim text format (see /data/particles/tau) with `convert`;
+   * text files can also be opened directly, in which case they are
+   * parsed into memory as a single, uniformly-weighted bin.
+   *
+   * The table used for the decays of every `Tau` is loaded the first
+   * time it is needed (see `get`), from the copy of the TAUOLA table
+   * that is compiled into the library, and can be replaced at runtime
+   * with `set_default` or the APRICOT_TAU_DECAY_TABLE environment variable.
    */
   class TauDecayTable final {
 
+    public:
+    /**
+     * The number of decay components in each row.
+     */
+    static constexpr std::size_t NPARTICLES{6};
+
+    /**
+     * The fractional energy of each component in a decay.
+     */
+    using State = std::array<double, NPARTICLES>;
+
+    /**
+     * The binning of a table in tau energy and polarization.
+     */
+    using Binning = TauDecayBinning;
+
+    /**
+     * One row of a table as it is stored in a binary file.
+     */
+    struct Row {
+      float fractions[NPARTICLES]; ///< The fractional energy of each component.
+      float probability;           ///< The probability of keeping this row in the alias table.
+      std::uint32_t alias;         ///< The alias of this row within its bin.
+    };
+
     private:
-    static constexpr size_t nstates_{
-        1000}; ///< The number of final states in the decay table
-    static constexpr size_t nparticles_{
-        6}; ///< The number of particles in each energy state
-    const std::string filename_{"tau_decay_tauola.dat"};
-    const std::array<double, nstates_ * nparticles_>
-        finalstates_; ///< The array containing all the finalstates
+    Binning binning_;                          ///< The energy and polarization bins.
+    std::size_t nstates_{0};                   ///< The number of rows in the table.
+    const std::uint64_t* offsets_{nullptr};    ///< The first row of each bin (and the end).
+    const Row* rows_{nullptr};                 ///< The rows of every bin.
+    std::vector<std::uint64_t> owned_offsets_; ///< The offsets of a table parsed from text.
+    std::vector<Row> owned_rows_;              ///< The rows of a table parsed from text.
+    void* mapping_{nullptr};                   ///< The memory-mapped binary file (if any).
+    std::size_t size_{0};                      ///< The size of the memory mapping [bytes].
 
+    public:
     /**
-     * Load the tau decay table from the file.
+     * Open a tau decay table from a binary or NuTauSim text file.
      *
-     * The filename is given by this->filename_. This is currently
-     * fixed at compile time but could easily be modified to load
-     * arbitrary files.
+     * @param filename    The file to open.
+     */
+    TauDecayTable(const std::string& filename);
+
+    /**
+     * Create a single-bin tau decay table in memory.
      *
-     * @returns The final state array loaded from the file.
+     * @param states     The fractional energies of each decay.
+     * @param weights    The weight of each decay (empty for uniform weights).
      */
+    TauDecayTable(const std::vector<State>& states, const std::vector<double>& weights = {});
+
+    /**
+     * Tables own their memory mapping so they are not copyable.
+     */
+    TauDecayTable(const TauDecayTable&) = delete;
     auto
-    load_decay_table() const -> decltype(finalstates_);
+    operator=(const TauDecayTable&) -> TauDecayTable& = delete;
 
     /**
-     * Return a random row-entry from the decay file.
+     * Unmap the table.
+     */
+    ~TauDecayTable();
+
+    /**
+     * Get the table used for the decays of taus.
      *
-     * @returns A raw array of fraction energies.
+     * This is loaded the first time that it is requested from the
+     * APRICOT_TAU_DECAY_TABLE environment variable (if set), else
+     * the TAUOLA table compiled into the library (see EmbeddedData.hpp),
+     * else the TAUOLA table in /data/particles/tau.
      */
-    auto
-    random_state() const -> std::array<double, nparticles_>;
+    static auto
+    get() -> const TauDecayTable&;
 
-    public:
     /**
-     * Load a decay table from a file.
+     * Replace the table used for the decays of taus.
      *
-     * Currently, this loads from the file this->filename_.
+     * Tables that have been replaced are kept alive, so references
+     * returned by `get` remain valid.
      *
+     * @param filename    The binary or text table to use.
      */
-    TauDecayTable() : finalstates_(load_decay_table()){};
+    static auto
+    set_default(const std::string& filename) -> void;
 
     /**
-     * Return a random decay state from the file.
+     * Write a binary tau decay table.
      *
-     * @returns A random entry from the tau decay file.
+     * `energies` and `polarizations` (one per state) are only used,
+     * and are then required, if the table is binned in them. Every
+     * bin must contain at least one state.
+     *
+     * @param filename         The file to write.
+     * @param states           The fractional energies of each decay.
+     * @param weights          The weight of each decay (empty for uniform weights).
+     * @param energies         The tau energy of each decay [log10(eV)].
+     * @param polarizations    The tau polarization of each decay.
+     * @param binning          The energy and polarization bins.
+     */
+    static auto
+    write(const std::string& filename,
+          const std::vector<State>& states,
+          const std::vector<double>& weights       = {},
+          const std::vector<LogEnergy>& energies   = {},
+          const std::vector<double>& polarizations = {},
+          const Binning& binning                   = Binning{}) -> void;
+
+    /**
+     * Convert a NuTauSim text table into a binary table.
+     *
+     * @param text      The NuTauSim text table to read.
+     * @param binary    The binary table to write.
+     */
+    static auto
+    convert(const std::string& text, const std::string& binary) -> void;
+
+    /**
+     * Return a random decay state from the table.
+     *
+     * @param energy          The energy of the tau [log10(eV)].
+     * @param polarization    The polarization of the tau in [-1, 1].
+     *
+     * @returns A random decay from the bin containing the tau.
+     */
+    auto
+    random_final_state(const LogEnergy energy = 18., const double polarization = -1.) const
+        -> TauDecayProducts;
+
+    /**
+     * The number of decays in this table.
+     */
+    auto
+    size() const -> std::size_t {
+      return nstates_;
+    }
+
+    /**
+     * The energy and polarization bins of this table.
      */
     auto
-    random_final_state() const -> TauDecayProducts;
+    get_binning() const -> const Binning& {
+      return binning_;
+    }
+
+    private:
+    /**
+     * Store states as the single bin of this table.
+     *
+     * @param states     The fractional energies of each decay.
+     * @param weights    The weight of each decay.
+     */
+    auto
+    adopt(const std::vector<State>& states, const std::vector<double>& weights) -> void;
+
+    /**
+     * Parse a NuTauSim text table into a single bin.
+     *
+     * @param filename    The text file to parse.
+     */
+    static auto
+    parse(const std::string& filename) -> std::vector<State>;
 
-  }; // END: class DecayTable final
+  }; // END: class TauDecayTable
 
 } // namespace apricot
@@ -2,6 +2,7 @@
 
 #include "apricot/InteractionInfo.hpp"
 #include "apricot/Particle.hpp"
+#include "apricot/particles/XmaxDistribution.hpp"
 #include <memory>
 
 namespace apricot {
@@ -25,24 +26,49 @@ namespace apricot {
     /**
      * Get the next interaction for this particle.
      *
-     * This uses a quadratic fit to telescope array data.
-     * See data/calibrations/Xmax.
+     * The grammage of shower max is sampled from the distribution
+     * of Xmax at this energy (see `get_Xmax_distribution`).
      */
     auto
     get_interaction() const -> InteractionInfo final override {
 
       // return an interaction at shower max
-      return InteractionInfo(interactions::ShowerMax, get_Xmax(energy_));
+      return InteractionInfo(interactions::ShowerMax, sample_Xmax(energy_));
     }
 
     /**
-     * Calculate the grammage at showe max
+     * Calculate the mean grammage at shower max.
+     *
+     * This uses a quadratic fit to telescope array data.
+     * See data/calibrations/Xmax.
      */
     static auto
     get_Xmax(const LogEnergy energy) -> double {
       return T::a_ * energy * energy + T::b_ * energy + T::c_;
     }
 
+    /**
+     * Sample a random grammage of shower max.
+     */
+    static auto
+    sample_Xmax(const LogEnergy energy) -> double {
+      return get_Xmax_distribution().sample(energy);
+    }
+
+    /**
+     * Get the distribution of the grammage of shower max.
+     *
+     * This is a Gumbel distribution with the mean of `get_Xmax`
+     * and an RMS of `T::sigma_` that is tabulated the first time
+     * that it is requested.
+     */
+    static auto
+    get_Xmax_distribution() -> const XmaxDistribution& {
+      static const auto distribution{XmaxDistribution::gumbel(
+          &UHECR::get_Xmax, [](const LogEnergy) { return T::sigma_; })};
+      return distribution;
+    }
+
     /**
      * Return the particle's PDG ID.
      */
@@ -88,6 +114,10 @@ namespace apricot {
     static constexpr double b_{244.91536};
     static constexpr double c_{-1989.9836};
 
+    // the RMS of Xmax around its mean at ~10 EeV from
+    // air shower simulations [g/cm^2]
+    static constexpr double sigma_{57.};
+
     /**
      * Construct an UHECR proton from an energy [log10(eV)].
      */
@@ -106,6 +136,10 @@ namespace apricot {
     static constexpr double b_{374.29550};
     static constexpr double c_{-3269.18886};
 
+    // the RMS of Xmax around its mean at ~10 EeV from
+    // air shower simulations [g/cm^2]
+    static constexpr double sigma_{42.};
+
     /**
      * Construct an UHECR helium from an energy [log10(eV)].
      */
@@ -124,6 +158,10 @@ namespace apricot {
     static constexpr double b_{-66.0359};
     static constexpr double c_{836.2584};
 
+    // the RMS of Xmax around its mean at ~10 EeV from
+    // air shower simulations [g/cm^2]
+    static constexpr double sigma_{28.};
+
     /**
      * Construct an UHECR nitrogen from an energy [log10(eV)].
      */
@@ -143,6 +181,10 @@ namespace apricot {
     static constexpr double b_{-136.00973};
     static constexpr double c_{1471.62867};
 
+    // the RMS of Xmax around its mean at ~10 EeV from
+    // air shower simulations [g/cm^2]
+    static constexpr double sigma_{20.};
+
     /**
      * Construct an UHECR iron from an energy [log10(eV)].
      */
@@ -165,6 +207,9 @@ namespace apricot {
     static constexpr double b_{1034.4526};
     static constexpr double c_{-9435.8754};
 
+    // the (approximate) measured RMS of Xmax around its mean [g/cm^2]
+    static constexpr double sigma_{50.};
+
     /**
      * Construct a mixed UHECR from an energy [log10(eV)].
      */
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace apricot {
+
+  /**
+   * The distribution of the grammage of shower max (Xmax) with energy.
+   *
+   * The distribution at each node of an energy grid is stored as a
+   * table of its inverse CDF at NQUANTILES evenly-spaced quantiles,
+   * so sampling Xmax is one uniform random number and a bilinear
+   * interpolation in energy and quantile. Beyond the outermost
+   * quantiles (and energies) the table is clamped.
+   *
+   * Tables are either built from a parameterized (Gumbel) distribution
+   * whose mean and RMS are functions of energy, or from a set of
+   * simulated showers (i.e. a file of energies and Xmax's), in which
+   * case the showers at each distinct energy are used as the
+   * empirical distribution at that energy.
+   */
+  class XmaxDistribution final {
+
+    public:
+    /**
+     * The number of quantiles stored at each energy.
+     */
+    static constexpr std::size_t NQUANTILES{256};
+
+    private:
+    std::vector<LogEnergy> energies_; ///< The energy of each node [log10(eV)].
+    std::vector<double> quantiles_;   ///< The NQUANTILES quantiles at each node [g/cm^2].
+    double inverse_step_{0.};         ///< 1 / the node spacing if the nodes are uniform (else 0).
+
+    public:
+    /**
+     * Build a distribution from a set of showers.
+     *
+     * Showers are grouped by energy and each distinct energy
+     * becomes a node of the table.
+     *
+     * @param energies    The energy of each shower [log10(eV)].
+     * @param xmax        The grammage of shower max of each shower [g/cm^2].
+     */
+    XmaxDistribution(const std::vector<LogEnergy>& energies, const std::vector<double>& xmax);
+
+    /**
+     * Load a distribution from a file of showers.
+     *
+     * Each row contains the energy [log10(eV)] and Xmax [g/cm^2] of
+     * one shower. Files in data/calibration/Xmax, which contain one
+     * (mean) Xmax per energy, give a distribution without fluctuations.
+     *
+     * @param filename    The file to load.
+     */
+    XmaxDistribution(const std::string& filename);
+
+    /**
+     * Build a Gumbel distribution with an energy-dependent mean and RMS.
+     *
+     * @param mean         The mean Xmax at an energy [g/cm^2].
+     * @param sigma        The RMS of Xmax at an energy [g/cm^2].
+     * @param emin         The lowest energy in the table [log10(eV)].
+     * @param emax         The highest energy in the table [log10(eV)].
+     * @param nenergies    The number of energies in the table.
+     */
+    static auto
+    gumbel(const std::function<double(LogEnergy)>& mean,
+           const std::function<double(LogEnergy)>& sigma,
+           const LogEnergy emin = 16.,
+           const LogEnergy emax = 21.,
+           const int nenergies  = 51) -> XmaxDistribution;
+
+    /**
+     * Evaluate the inverse CDF of Xmax.
+     *
+     * @param energy         The energy of the primary [log10(eV)].
+     * @param probability    The quantile in [0, 1].
+     *
+     * @returns The Xmax at this quantile [g/cm^2].
+     */
+    auto
+    quantile(const LogEnergy energy, const double probability) const -> double;
+
+    /**
+     * Sample a random Xmax.
+     *
+     * @param energy    The energy of the primary [log10(eV)].
+     *
+     * @returns A random Xmax at this energy [g/cm^2].
+     */
+    auto
+    sample(const LogEnergy energy) const -> double;
+
+    /**
+     * The energy of each node of the table [log10(eV)].
+     */
+    auto
+    get_energies() const -> const std::vector<LogEnergy>& {
+      return energies_;
+    }
+
+    private:
+    /**
+     * Construct an empty distribution.
+     */
+    XmaxDistribution() = default;
+
+    /**
+     * Build the quantile table from a set of showers.
+     *
+     * @param energies    The energy of each shower [log10(eV)].
+     * @param xmax        The grammage of shower max of each shower [g/cm^2].
+     */
+    auto
+    compile(const std::vector<LogEnergy>& energies, const std::vector<double>& xmax) -> void;
+
+  }; // END: class XmaxDistribution
+
+} // namespace apricot
@@ -20,14 +20,75 @@ namespace apricot {
    * detectable. This propagator does not continue propagating
    * particles after their first propagation.
    *
+   * When propagating many particles, the propagator checks whether
+   * the Earth, atmosphere, detector, and source are one of the
+   * built-in concrete model types and, if so, runs a propagation
+   * kernel that is instantiated for exactly those types so that the
+   * per-step model calls are resolved at compile time. Any other
+   * combination falls back to the (virtual) generic kernel.
+   *
+   * If tau transport is enabled, a tau neutrino whose charged current
+   * interaction is not detectable produces a tau that is propagated
+   * in the same pass. The tau loses energy continuously (using the
+   * range tables of `EnergyLossTable`) and decays after a random
+   * proper time; its decay is saved if it is detectable, unless the
+   * tau is cut by the detector or ranges out first.
+   *
+   * If muon transport is enabled, a muon neutrino whose charged
+   * current interaction is not detectable produces a muon that is
+   * propagated in the same pass. The muon loses energy continuously
+   * below the vcut of `StochasticLossTable` and each catastrophic
+   * loss above it is saved, with the energy of the loss, if the muon
+   * is detectable at that location. The muon is transported until it
+   * is cut by the detector or ranges out.
+   *
    */
   class SimplePropagator final : public Propagator {
 
+    const bool taus_;  ///< True if we transport taus from tau neutrino interactions.
+    const bool muons_; ///< True if we transport muons from muon neutrino interactions.
+
     public:
     /**
      * Construct a SimplePropagator.
+     *
+     * @param earth    The Earth model to use for propagation.
+     * @param taus     If true, transport taus from tau neutrino interactions.
+     * @param muons    If true, transport muons from muon neutrino interactions.
+     */
+    SimplePropagator(const Earth& earth, const bool taus = false, const bool muons = false) :
+        Propagator(earth),
+        taus_(taus),
+        muons_(muons) {}
+
+    /**
+     * True if this propagator transports taus.
      */
-    SimplePropagator(const Earth& earth) : Propagator(earth) {}
+    auto
+    get_taus() const -> bool {
+      return taus_;
+    }
+
+    /**
+     * True if this propagator transports muons.
+     */
+    auto
+    get_muons() const -> bool {
+      return muons_;
+    }
+
+    /**
+     * Propagate several particles from a Source to a Detector.
+     *
+     * @param source     The Source model to generate particle tracks.
+     * @param flux       The Flux model to generate particles
+     * @param detector   The Detector model used to detect particles.
+     * @param N          The number of interactions to generate.
+     *
+     */
+    auto
+    propagate(Source& source, Flux& flux, const Detector& detector, const int N) const
+        -> Events final override;
 
     /**
      * Propagate a single particle from a Source to a Detector.
@@ -47,6 +108,98 @@ namespace apricot {
      */
     ~SimplePropagator(){};
 
+    private:
+    /**
+     * Propagate a single particle with statically typed models.
+     *
+     * Instantiating this with the abstract base classes gives the
+     * generic (virtual) kernel.
+     *
+     * @param earth      The Earth model to use for propagation.
+     * @param source     The Source model to generate particle tracks.
+     * @param flux       The Flux model to generate particles
+     * @param detector   The Detector model used to detect particles.
+     *
+     */
+    template <typename EarthT,
+              typename AtmosphereT,
+              typename DetectorT,
+              typename SourceT,
+              typename FluxT>
+    auto
+    trial(const EarthT& earth, SourceT& source, FluxT& flux, const DetectorT& detector) const
+        -> InteractionTree;
+
+    /**
+     * Transport a tau until it decays, ranges out, or is cut.
+     *
+     * If the tau decays at a detectable location, the decay is added to `tree`.
+     *
+     * @param earth      The Earth model to use for propagation.
+     * @param detector   The Detector model used to detect particles.
+     * @param energy     The initial energy of the tau [log10(eV)].
+     * @param location   The location where the tau was created.
+     * @param direction  The unit-length direction of the tau.
+     * @param weight     The weight of this trial.
+     * @param tree       The tree to add the decay to.
+     *
+     */
+    template <typename EarthT, typename AtmosphereT, typename DetectorT>
+    auto
+    transport(const EarthT& earth,
+              const DetectorT& detector,
+              const LogEnergy energy,
+              CartesianCoordinate location,
+              Vector direction,
+              const double weight,
+              InteractionTree& tree) const -> void;
+
+    /**
+     * Transport a muon until it ranges out or is cut.
+     *
+     * Every detectable catastrophic loss is added to `tree`.
+     *
+     * @param earth      The Earth model to use for propagation.
+     * @param detector   The Detector model used to detect particles.
+     * @param energy     The initial energy of the muon [log10(eV)].
+     * @param location   The location where the muon was created.
+     * @param direction  The unit-length direction of the muon.
+     * @param weight     The weight of this trial.
+     * @param tree       The tree to add the losses to.
+     *
+     */
+    template <typename EarthT, typename AtmosphereT, typename DetectorT>
+    auto
+    transport_muon(const EarthT& earth,
+                   const DetectorT& detector,
+                   const LogEnergy energy,
+                   CartesianCoordinate location,
+                   Vector direction,
+                   const double weight,
+                   InteractionTree& tree) const -> void;
+
+    /**
+     * Propagate several particles with statically typed models.
+     *
+     * @param earth      The Earth model to use for propagation.
+     * @param source     The Source model to generate particle tracks.
+     * @param flux       The Flux model to generate particles
+     * @param detector   The Detector model used to detect particles.
+     * @param N          The number of interactions to generate.
+     *
+     */
+    template <typename EarthT,
+              typename AtmosphereT,
+              typename DetectorT,
+              typename SourceT,
+              typename FluxT>
+    auto
+    kernel(const EarthT& earth,
+           SourceT& source,
+           FluxT& flux,
+           const DetectorT& detector,
+           const int N) const -> Events;
+
   }; // END: class Propagator
 
 } // namespace apricot
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "apricot/Propagator.hpp"
+#include "apricot/propagators/TauExitTable.hpp"
+#include <memory>
+
+namespace apricot {
+
+  /* Forward Declarations */
+  class Flux;
+  class Earth;
+  class Source;
+  class Particle;
+  class Detector;
+
+  /**
+   * Propagate tau neutrinos with tabulated tau exit probabilities.
+   *
+   * Rather than stepping each neutrino through the Earth, this
+   * propagator finds where the trajectory of each tau neutrino
+   * enters and exits the surface, and samples an exiting tau (if
+   * any) from a `TauExitTable` at the emergence angle of the chord.
+   * The tau then decays in the air after a random decay length
+   * (energy losses in the air are neglected) and the decay is saved
+   * if it is detectable. Each trial is therefore a single O(1) draw.
+   *
+   * Particles that are not tau neutrinos, and trajectories that do
+   * not cross the Earth, are never detected.
+   */
+  class TauExitPropagator final : public Propagator {
+
+    std::shared_ptr<TauExitTable> table_; ///< The tau exit tables.
+
+    public:
+    /**
+     * Construct a TauExitPropagator.
+     *
+     * @param earth    The Earth model used for the surface.
+     * @param table    The tau exit tables (generated for `earth`).
+     */
+    TauExitPropagator(const Earth& earth, const std::shared_ptr<TauExitTable>& table);
+
+    // propagate several particles with the default loop
+    using Propagator::propagate;
+
+    /**
+     * Propagate a single particle from a Source to a Detector.
+     *
+     * @param source     The Source model to generate particle tracks.
+     * @param flux       The Flux model to generate particles
+     * @param detector   The Detector model used to detect particles.
+     *
+     */
+    auto
+    propagate(Source& source, Flux& flux, const Detector& detector) const
+        -> InteractionTree final override;
+
+    /**
+     * Get the tau exit tables used by this propagator.
+     */
+    auto
+    get_table() const -> const std::shared_ptr<TauExitTable>& {
+      return table_;
+    }
+
+  }; // END: class TauExitPropagator
+
+} // namespace apricot
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "apricot/Apricot.hpp"
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace apricot {
+
+  /* Forward Declarations */
+  class Earth;
+
+  /**
+   * Tables of the exit probability and exit energy of taus.
+   *
+   * For a tau neutrino of energy E that crosses the Earth along a
+   * chord that emerges from the surface at an elevation angle
+   * (the emergence angle), this tabulates the probability that a
+   * tau exits the surface and the distribution of its energy at the
+   * surface - the same quantities tabulated by NuTauSim.
+   *
+   * The tables are generated by Monte Carlo on a uniform grid in
+   * log10(E) and a given list of emergence angles. For each angle,
+   * the column depth along the chord (from `Earth::grammage`) is
+   * tabulated once, so each trial only samples the neutrino
+   * interactions (with `NeutrinoCrossSectionTable` and
+   * `InelasticityTable`) and walks the tau through this column with
+   * continuous energy losses (`EnergyLossTable`) until it decays,
+   * ranges out, or exits. Tau regeneration (the tau neutrino from a
+   * tau decay inside the Earth) is not included. The cells of the
+   * table are generated in parallel; each cell is seeded from the
+   * generator of the calling thread so the tables are reproducible.
+   *
+   * The exit energies of each cell are stored as the inverse of
+   * their cumulative distribution at NQUANTILES + 1 quantiles.
+   * Tables can be saved to, and loaded from, a compact binary file
+   * (in the native byte order):
+   *
+   *     char[8]    "APTAUEX1"
+   *     uint32     the number of energies, angles, and quantiles
+   *     float64    the smallest and largest energy [log10(eV)]
+   *     float64    the emergence angles [degrees]
+   *     float32    the exit probability [energy][angle]
+   *     float32    the exit energy quantiles [energy][angle][quantile]
+   */
+  class TauExitTable final {
+
+    LogEnergy emin_;                 ///< The smallest neutrino energy [log10(eV)].
+    LogEnergy emax_;                 ///< The largest neutrino energy [log10(eV)].
+    int nenergies_;                  ///< The number of energy nodes.
+    int nquantiles_;                 ///< The number of intervals in each inverse CDF.
+    std::vector<double> angles_;     ///< The emergence angles [degrees].
+    std::vector<float> probability_; ///< The exit probability of each cell.
+    std::vector<float> quantiles_;   ///< The exit energy quantiles of each cell [log10(eV)].
+
+    public:
+    /**
+     * The default number of intervals in each inverse CDF.
+     */
+    static constexpr int NQUANTILES{128};
+
+    /**
+     * Generate the tables for an Earth model.
+     *
+     * @param earth       The Earth model that the neutrinos cross.
+     * @param emin        The smallest neutrino energy [log10(eV)].
+     * @param emax        The largest neutrino energy [log10(eV)].
+     * @param nenergies   The number of energy nodes (at least two).
+     * @param angles      The increasing emergence angles [degrees].
+     * @param ntrials     The number of neutrinos thrown in each cell.
+     * @param nthreads    The number of threads (0 uses every core).
+     */
+    TauExitTable(const Earth& earth,
+                 const LogEnergy emin,
+                 const LogEnergy emax,
+                 const int nenergies,
+                 const std::vector<double>& angles,
+                 const int ntrials,
+                 const int nthreads = 0);
+
+    /**
+     * Load the tables from a binary file.
+     *
+     * @param filename    The file written by `save`.
+     */
+    TauExitTable(const std::string& filename);
+
+    /**
+     * Save the tables to a binary file.
+     *
+     * @param filename    The file to write.
+     */
+    auto
+    save(const std::string& filename) const -> void;
+
+    /**
+     * The probability that a tau exits the surface.
+     *
+     * This is interpolated bilinearly in log10(E) and angle; energies
+     * and angles outside of the table use the closest cell.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     * @param angle     The emergence angle [degrees].
+     */
+    auto
+    probability(const LogEnergy energy, const double angle) const -> double;
+
+    /**
+     * Sample the energy of an exiting tau.
+     *
+     * This picks one of the four cells around (energy, angle) with
+     * its bilinear weight, decides whether a tau exits with the exit
+     * probability of that cell, and samples its exit energy, so the
+     * draw is O(1). This returns std::nullopt if no tau exits.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     * @param angle     The emergence angle [degrees].
+     */
+    auto
+    sample(const LogEnergy energy, const double angle) const -> std::optional<LogEnergy>;
+
+    /**
+     * The smallest neutrino energy in the table [log10(eV)].
+     */
+    auto
+    get_emin() const -> LogEnergy {
+      return emin_;
+    }
+
+    /**
+     * The largest neutrino energy in the table [log10(eV)].
+     */
+    auto
+    get_emax() const -> LogEnergy {
+      return emax_;
+    }
+
+    /**
+     * The number of energy nodes in the table.
+     */
+    auto
+    get_nenergies() const -> int {
+      return nenergies_;
+    }
+
+    /**
+     * The emergence angles in the table [degrees].
+     */
+    auto
+    get_angles() const -> const std::vector<double>& {
+      return angles_;
+    }
+
+    private:
+    /**
+     * The fractional indices of an energy and an angle in the table.
+     *
+     * @param energy    The neutrino energy [log10(eV)].
+     * @param angle     The emergence angle [degrees].
+     */
+    auto
+    locate(const LogEnergy energy, const double angle) const
+        -> std::tuple<int, double, int, double>;
+
+    /**
+     * Check that the table has a valid shape.
+     */
+    auto
+    validate() const -> void;
+
+  }; // END: class TauExitTable
+
+} // namespace apricot
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "apricot/Propagator.hpp"
+#include "apricot/atmospheres/SlantDepthTable.hpp"
+#include <memory>
+
+namespace apricot {
+
+  /* Forward Declarations */
+  class Flux;
+  class Earth;
+  class Source;
+  class Particle;
+  class Detector;
+
+  /**
+   * Propagate cosmic rays directly to shower maximum.
+   *
+   * Rather than stepping through the atmosphere, this propagator
+   * inverts a curved-Earth slant depth table (see `SlantDepthTable`)
+   * along the straight trajectory of each particle to find the point
+   * at which its interaction grammage (Xmax for a UHECR) is reached.
+   * The detector is then checked once at this point.
+   *
+   * Particles only interact in the atmosphere: trajectories that
+   * leave the atmosphere, or reach the surface, before crossing
+   * their interaction grammage are not detected. Voxel grids and
+   * the interior of the Earth are ignored.
+   *
+   * The table is not rebuilt when the atmosphere changes (i.e.
+   * `SoundingAtmosphere::set_time`); propagating with a stale table
+   * throws, so call `get_table()->rebuild()` after changing it.
+   */
+  class UHECRPropagator final : public Propagator {
+
+    std::shared_ptr<SlantDepthTable> table_; ///< The slant depth of the atmosphere.
+
+    public:
+    /**
+     * Construct a UHECRPropagator.
+     *
+     * If no table is given, one is built for the atmosphere of
+     * `earth` using the radius of the Earth at the North Pole.
+     *
+     * @param earth    The Earth model (with an atmosphere) to propagate through.
+     * @param table    The slant depth table of the atmosphere.
+     */
+    UHECRPropagator(const Earth& earth, const std::shared_ptr<SlantDepthTable>& table = nullptr);
+
+    // propagate several particles with the default loop
+    using Propagator::propagate;
+
+    /**
+     * Propagate a single particle from a Source to a Detector.
+     *
+     * @param source     The Source model to generate particle tracks.
+     * @param flux       The Flux model to generate particles
+     * @param detector   The Detector model used to detect particles.
+     *
+     */
+    auto
+    propagate(Source& source, Flux& flux, const Detector& detector) const
+        -> InteractionTree final override;
+
+    /**
+     * Get the slant depth table used by this propagator.
+     */
+    auto
+    get_table() const -> const std::shared_ptr<SlantDepthTable>& {
+      return table_;
+    }
+
+  }; // END: class UHECRPropagator
+
+} // namespace apricot
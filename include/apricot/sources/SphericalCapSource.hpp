@@ -3,6 +3,7 @@
 #include "apricot/Coordinates.hpp"
 #include "apricot/Source.hpp"
 #include <cmath>
+#include <optional>
 
 namespace apricot {
 
@@ -16,6 +17,13 @@ namespace apricot {
    * 100 km above Antarctic. Direction vectors are picked uniformly
    * from 4\pi steradians.
    *
+   * If a target (i.e. a payload) is given, direction vectors are
+   * instead picked uniformly within a cone around the vector from
+   * each origin to the target. Trajectories outside the cone are
+   * never sampled so the cone must contain every detectable
+   * direction; the smaller solid angle of the cone is reported by
+   * `solid_angle()` so acceptance estimates are unchanged.
+   *
    */
   class SphericalCapSource final : public Source {
 
@@ -36,6 +44,16 @@ namespace apricot {
      */
     const double center_;
 
+    /**
+     * The point that directions are aimed at (if any).
+     */
+    const std::optional<CartesianCoordinate> target_;
+
+    /**
+     * The half-opening angle of the cone of directions [radians].
+     */
+    const double cone_{M_PI};
+
     /**
      * Create a SphericalCapSource.
      *
@@ -51,6 +69,22 @@ namespace apricot {
         theta_(theta),
         center_(center) {}
 
+    /**
+     * Create a SphericalCapSource whose directions point at a target.
+     *
+     * @param target    The geocentric location to aim directions at [km].
+     * @param cone      The half-opening angle of the cone of directions [radians].
+     * @param radius    The radius of the spherical cap [km].
+     * @param theta     The half-opening angle of the cap [radians].
+     * @param center    The central angle of the spherical cap.
+     *
+     */
+    SphericalCapSource(const CartesianCoordinate& target,
+                       const double cone,
+                       const double radius = 6356.755,
+                       const double theta  = M_PI / 16.,
+                       const double center = (15 / 16.) * M_PI);
+
     /**
      * Choose a random point on the surface of the cap.
      */
@@ -63,6 +97,12 @@ namespace apricot {
     auto
     get_origin() const -> std::pair<CartesianCoordinate, Vector> final override;
 
+    /**
+     * The solid angle that directions are sampled from [sr].
+     */
+    auto
+    solid_angle() const -> double final override;
+
   }; // END: class SphericalCapSource
 
 } // namespace apricot
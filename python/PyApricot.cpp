@@ -1,4 +1,7 @@
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "apricot/EmbeddedData.hpp"
 #include "apricot/Random.hpp"
 
 namespace py = pybind11;
@@ -13,11 +16,13 @@ void Py_Neutrino(py::module&);
 void Py_Detector(py::module&);
 void Py_Geometry(py::module&);
 void Py_Atmosphere(py::module&);
+void Py_DensityModel(py::module&);
 void Py_Propagator(py::module&);
 void Py_Interaction(py::module&);
 void Py_ChargedLepton(py::module&);
 void Py_NeutrinoYFactor(py::module&);
 void Py_NeutrinoCrossSection(py::module&);
+void Py_PhysicsConfig(py::module&);
 
 // create our Python module
 PYBIND11_MODULE(_apricot, m) {
@@ -39,13 +44,27 @@ PYBIND11_MODULE(_apricot, m) {
   Py_Propagator(m); // Propagator.hpp
   Py_Interaction(m); // Interaction.hpp
   Py_Atmosphere(m); // Atmosphere.hpp
+  Py_DensityModel(m); // DensityModel.hpp
   Py_ChargedLepton(m); // ChargedLepton.hpp
   Py_NeutrinoYFactor(m); // NeutrinoYFactor.hpp
   Py_NeutrinoCrossSection(m); // NeutrinoCrossSection.hpp
+  Py_PhysicsConfig(m); // PhysicsConfig.hpp
 
   // and expose a function for changing the random number seed
   m.def("seed", &apricot::random::set_seed,
         py::arg("seed"),
         "Set the RNG seed.");
 
+  // and the data tables that are compiled into the library
+  m.def("embedded_tables", &apricot::data::table_names,
+        "The names of the data tables compiled into apricot.");
+  m.def("embedded_table",
+        [](const std::string& name) -> std::optional<py::array_t<double>> {
+          const auto table{apricot::data::find_table(name)};
+          if (!table) return std::nullopt;
+          return py::array_t<double>({table->rows, table->columns}, table->values);
+        },
+        py::arg("name"),
+        "Get a copy of a data table compiled into apricot (or None).");
+
 }
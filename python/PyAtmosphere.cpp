@@ -1,7 +1,11 @@
 #include "apricot/atmospheres/ExponentialAtmosphere.hpp"
+#include "apricot/atmospheres/LinsleyAtmosphere.hpp"
+#include "apricot/atmospheres/SlantDepthTable.hpp"
+#include "apricot/atmospheres/SoundingAtmosphere.hpp"
 #include <memory>
 #include <pybind11/numpy.h> // add support for numpy
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 using namespace apricot;
@@ -9,10 +13,24 @@ using namespace apricot;
 void
 Py_Atmosphere(py::module& m) {
 
-  // Earth
-  py::class_<Atmosphere, std::shared_ptr<Atmosphere>>(m, "Atmosphere");
+  // Atmosphere
+  py::class_<Atmosphere, std::shared_ptr<Atmosphere>>(m, "Atmosphere")
+      .def("depth",
+           py::vectorize(&Atmosphere::depth),
+           py::arg("altitude"),
+           "The vertical depth [g/cm^2] above a given altitude [km].")
+      .def("altitude",
+           py::vectorize(&Atmosphere::altitude),
+           py::arg("depth"),
+           "The altitude [km] at a given vertical depth [g/cm^2].")
+      .def("analytic",
+           &Atmosphere::analytic,
+           "True if the vertical depth is computed in closed form.")
+      .def_property_readonly("revision",
+                             &Atmosphere::revision,
+                             "A counter that changes whenever the density profile changes.");
 
-  // SphericalEarth
+  // ExponentialAtmosphere
   py::class_<ExponentialAtmosphere, Atmosphere,
              std::shared_ptr<ExponentialAtmosphere>>(m, "ExponentialAtmosphere")
       .def(py::init<const double, const double>(),
@@ -27,4 +45,91 @@ Py_Atmosphere(py::module& m) {
            py::vectorize(&ExponentialAtmosphere::density),
            py::arg("altitudes"),
            "The density of the atmosphere at several altitudes [km].");
+
+  // LinsleyAtmosphere
+  py::class_<LinsleyAtmosphere, Atmosphere, std::shared_ptr<LinsleyAtmosphere>>(
+      m, "LinsleyAtmosphere")
+      .def(py::init<const std::string&>(),
+           py::arg("model") = "us-standard",
+           "Create a five-layer Linsley atmosphere from a built-in parameter set.")
+      .def(py::init<const LinsleyAtmosphere::Parameters&,
+                    const LinsleyAtmosphere::Parameters&,
+                    const LinsleyAtmosphere::Parameters&,
+                    const LinsleyAtmosphere::Parameters&>(),
+           py::arg("boundaries"),
+           py::arg("a"),
+           py::arg("b"),
+           py::arg("c"),
+           "Create a five-layer Linsley atmosphere from CORSIKA-style parameters.")
+      .def("density",
+           py::vectorize(&LinsleyAtmosphere::density),
+           py::arg("altitude"),
+           "The density of the atmosphere at a given altitude [km].")
+      .def_property_readonly("top",
+                             &LinsleyAtmosphere::top,
+                             "The altitude of the top of the atmosphere [km].");
+
+  // SoundingAtmosphere
+  py::class_<SoundingAtmosphere, Atmosphere, std::shared_ptr<SoundingAtmosphere>>(
+      m, "SoundingAtmosphere")
+      .def(py::init<const std::string&>(),
+           py::arg("filename"),
+           "Load a time-dependent atmosphere from a file of density profiles.")
+      .def(py::init<const std::vector<double>&,
+                    const std::vector<std::vector<double>>&,
+                    const std::vector<std::vector<double>>&,
+                    const double>(),
+           py::arg("times"),
+           py::arg("altitudes"),
+           py::arg("densities"),
+           py::arg("period") = 0.,
+           "Create a time-dependent atmosphere from tabulated density profiles.")
+      .def("density",
+           py::vectorize(&SoundingAtmosphere::density),
+           py::arg("altitude"),
+           "The density of the atmosphere at a given altitude [km].")
+      .def("set_time",
+           &SoundingAtmosphere::set_time,
+           py::arg("time"),
+           py::arg("interpolate") = true,
+           "Choose the active profile for a given time.")
+      .def_property_readonly("time",
+                             &SoundingAtmosphere::get_time,
+                             "The time of the active profile.")
+      .def("__len__", &SoundingAtmosphere::size);
+
+  // SlantDepthTable
+  py::class_<SlantDepthTable, std::shared_ptr<SlantDepthTable>>(m, "SlantDepthTable")
+      .def(py::init<const std::shared_ptr<Atmosphere>&, const double, const int, const int>(),
+           py::arg("atmosphere"),
+           py::arg("radius")   = SphericalEarth::POLAR,
+           py::arg("nheights") = 301,
+           py::arg("nzeniths") = 101,
+           "Tabulate the slant depth of an atmosphere on a curved Earth.")
+      .def("depth",
+           py::vectorize(&SlantDepthTable::depth),
+           py::arg("altitude"),
+           py::arg("zenith"),
+           "The slant depth [g/cm^2] along a ray from an altitude [km] at a zenith angle [rad].")
+      .def("distance",
+           py::vectorize(&SlantDepthTable::distance),
+           py::arg("altitude"),
+           py::arg("zenith"),
+           py::arg("grammage"),
+           "The distance [km] along a ray at which a grammage [g/cm^2] is reached.")
+      .def("integrate",
+           py::vectorize(py::overload_cast<const double, const double>(
+               &SlantDepthTable::integrate, py::const_)),
+           py::arg("altitude"),
+           py::arg("zenith"),
+           "The slant depth [g/cm^2] along a ray by direct numerical integration.")
+      .def_property_readonly("error",
+                             &SlantDepthTable::error,
+                             "The largest relative error of the table at the cell centers.")
+      .def_property_readonly("stale",
+                             &SlantDepthTable::stale,
+                             "True if the atmosphere has changed since the table was built.")
+      .def("rebuild",
+           &SlantDepthTable::rebuild,
+           "Re-tabulate the slant depth of the current atmosphere.");
 }
@@ -1,7 +1,12 @@
 #include "apricot/Particle.hpp"
+#include "apricot/PhysicsConfig.hpp"
 #include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/particles/EnergyLossTable.hpp"
+#include "apricot/particles/StochasticLossTable.hpp"
+#include "apricot/particles/TauDecayTable.hpp"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 using namespace apricot;
@@ -9,8 +14,125 @@ using namespace apricot;
 void
 Py_ChargedLepton(py::module& m) {
 
+  // LeptonEnergyLossModel
+  py::enum_<LeptonEnergyLossModel>(m, "LeptonEnergyLossModel")
+    .value("BDHM", LeptonEnergyLossModel::BDHM)
+    .value("Soyez", LeptonEnergyLossModel::Soyez)
+    .value("ALLM", LeptonEnergyLossModel::ALLM)
+    .value("BS", LeptonEnergyLossModel::BS);
+
+  // EnergyLossTable
+  py::class_<EnergyLossTable>(m, "EnergyLossTable")
+    .def(py::init<const ParticleID, const LeptonEnergyLossModel>(),
+         py::arg("id"), py::arg("model"),
+         "Tabulate the built-in energy loss of a muon or tau.")
+    .def(py::init<const std::string&, const double>(),
+         py::arg("filename"), py::arg("alpha") = EnergyLossTable::ALPHA,
+         "Tabulate beta(E) loaded from a file.")
+    .def_static("get", &EnergyLossTable::get,
+                py::return_value_policy::reference, py::arg("id"), py::arg("model"),
+                "Get the shared table for a lepton and energy loss model.")
+    .def("beta", py::vectorize(&EnergyLossTable::beta), py::arg("energy"),
+         "The energy loss coefficient, beta(E) [cm^2/g], at energies in log10(eV).")
+    .def("range", py::vectorize(&EnergyLossTable::range), py::arg("energy"),
+         "The grammage [g/cm^2] for a lepton to slow down to EMIN.")
+    .def("energy", py::vectorize(&EnergyLossTable::energy),
+         py::arg("energy"), py::arg("grammage"),
+         "The energy [log10(eV)] of a lepton after crossing some grammage [g/cm^2].");
+
+  // LossProcess
+  py::enum_<LossProcess>(m, "LossProcess")
+    .value("Bremsstrahlung", LossProcess::Bremsstrahlung)
+    .value("PairProduction", LossProcess::PairProduction)
+    .value("Photonuclear", LossProcess::Photonuclear);
+
+  // StochasticLossTable
+  py::class_<StochasticLossTable>(m, "StochasticLossTable")
+    .def(py::init<const ParticleID, const LeptonEnergyLossModel, const double>(),
+         py::arg("id"), py::arg("model"), py::arg("vcut") = StochasticLossTable::VCUT,
+         "Tabulate the continuous and stochastic energy losses of a muon or tau.")
+    .def_static("get", &StochasticLossTable::get,
+                py::return_value_policy::reference, py::arg("id"), py::arg("model"),
+                "Get the shared table for a lepton and energy loss model.")
+    .def_property_readonly("continuous", &StochasticLossTable::continuous,
+                           py::return_value_policy::reference_internal,
+                           "The continuous energy loss table (losses below vcut).")
+    .def_property_readonly("vcut", &StochasticLossTable::get_vcut)
+    .def("rate",
+         py::vectorize(py::overload_cast<const LogEnergy>(&StochasticLossTable::rate,
+                                                          py::const_)),
+         py::arg("energy"),
+         "The total rate [cm^2/g] of catastrophic losses at energies in log10(eV).")
+    .def("rate",
+         py::overload_cast<const LossProcess, const LogEnergy>(&StochasticLossTable::rate,
+                                                               py::const_),
+         py::arg("process"), py::arg("energy"),
+         "The rate [cm^2/g] of catastrophic losses by one process.")
+    .def("next_loss", &StochasticLossTable::next_loss, py::arg("energy"),
+         "Sample the energy [log10(eV)] at the next catastrophic loss (EMIN if none).")
+    .def("sample_process", &StochasticLossTable::sample_process, py::arg("energy"),
+         "Sample the process responsible for a catastrophic loss.")
+    .def("sample_fraction", &StochasticLossTable::sample_fraction, py::arg("process"),
+         "Sample the fraction of the lepton energy lost in a catastrophic loss.");
+
+  // TauDecayProducts
+  py::class_<TauDecayProducts>(m, "TauDecayProducts")
+    .def_readonly("nu_e", &TauDecayProducts::nu_e)
+    .def_readonly("nu_mu", &TauDecayProducts::nu_muon)
+    .def_readonly("nu_tau", &TauDecayProducts::nu_tau)
+    .def_readonly("hadronic", &TauDecayProducts::hadronic)
+    .def_readonly("electron", &TauDecayProducts::electron)
+    .def_readonly("muon", &TauDecayProducts::muon)
+    .def("__repr__", &TauDecayProducts::to_string);
+
+  // TauDecayBinning
+  py::class_<TauDecayBinning>(m, "TauDecayBinning")
+    .def(py::init([](const int nenergies, const LogEnergy emin, const LogEnergy emax,
+                     const int npolarizations) {
+           return TauDecayBinning{nenergies, emin, emax, npolarizations};
+         }),
+         py::arg("nenergies") = 1, py::arg("emin") = 15., py::arg("emax") = 21.,
+         py::arg("npolarizations") = 1,
+         "Bin a tau decay table in log10(energy) and polarization.")
+    .def_readwrite("nenergies", &TauDecayBinning::nenergies)
+    .def_readwrite("emin", &TauDecayBinning::emin)
+    .def_readwrite("emax", &TauDecayBinning::emax)
+    .def_readwrite("npolarizations", &TauDecayBinning::npolarizations);
+
+  // TauDecayTable
+  py::class_<TauDecayTable, std::shared_ptr<TauDecayTable>>(m, "TauDecayTable")
+    .def(py::init<const std::string&>(), py::arg("filename"),
+         "Open a binary or NuTauSim text tau decay table.")
+    .def(py::init<const std::vector<TauDecayTable::State>&, const std::vector<double>&>(),
+         py::arg("states"), py::arg("weights") = std::vector<double>{},
+         "Create a tau decay table from a list of decay states.")
+    .def_static("get", &TauDecayTable::get, py::return_value_policy::reference,
+                "Get the table used for the decays of taus.")
+    .def_static("set_default", &TauDecayTable::set_default, py::arg("filename"),
+                "Replace the table used for the decays of taus.")
+    .def_static("write", &TauDecayTable::write,
+                py::arg("filename"), py::arg("states"),
+                py::arg("weights") = std::vector<double>{},
+                py::arg("energies") = std::vector<LogEnergy>{},
+                py::arg("polarizations") = std::vector<double>{},
+                py::arg("binning") = TauDecayBinning{},
+                "Write a binary tau decay table.")
+    .def_static("convert", &TauDecayTable::convert, py::arg("text"), py::arg("binary"),
+                "Convert a NuTauSim text table into a binary table.")
+    .def("random_final_state", &TauDecayTable::random_final_state,
+         py::arg("energy") = 18., py::arg("polarization") = -1.,
+         "Return a random decay of a tau with an energy [log10(eV)] and polarization.")
+    .def_property_readonly("binning", &TauDecayTable::get_binning)
+    .def("__len__", &TauDecayTable::size);
+
   // Charged leptons
-  py::class_<ChargedLepton, Particle>(m, "ChargedLepton");
+  py::class_<ChargedLepton, Particle>(m, "ChargedLepton")
+    .def_property_static("energy_loss_model",
+        [](py::object) { return PhysicsConfig::global().energy_loss_model; },
+        [](py::object, const LeptonEnergyLossModel model) {
+            PhysicsConfig::global().energy_loss_model = model;
+        },
+        "The global model to use for leptonic energy loss.");
 
   // Electron
   py::class_<Electron, ChargedLepton>(m, "Electron")
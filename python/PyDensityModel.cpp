@@ -0,0 +1,174 @@
+#include "apricot/DensityModel.hpp"
+#include "apricot/earth/FirnDensity.hpp"
+#include "apricot/earth/LayeredDensity.hpp"
+#include "apricot/earth/VoxelDensity.hpp"
+#include <limits>
+#include <memory>
+#include <optional>
+#include <pybind11/eigen.h> // add support for Eigen
+#include <pybind11/numpy.h> // add support for numpy
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h> // add support for C++ STL
+
+namespace py = pybind11;
+using namespace apricot;
+
+void
+Py_DensityModel(py::module& m) {
+
+  // create a submodule to wrap material IDs
+  auto material             = m.def_submodule("materials");
+  material.attr("Vacuum")   = pybind11::int_(materials::Vacuum);
+  material.attr("Core")     = pybind11::int_(materials::Core);
+  material.attr("Mantle")   = pybind11::int_(materials::Mantle);
+  material.attr("Rock")     = pybind11::int_(materials::Rock);
+  material.attr("Water")    = pybind11::int_(materials::Water);
+  material.attr("Ice")      = pybind11::int_(materials::Ice);
+  material.attr("Firn")     = pybind11::int_(materials::Firn);
+  material.attr("Sediment") = pybind11::int_(materials::Sediment);
+  material.attr("Air")      = pybind11::int_(materials::Air);
+
+  // DensityModel
+  py::class_<DensityModel, std::shared_ptr<DensityModel>>(m, "DensityModel")
+      .def("density",
+           &DensityModel::density,
+           py::arg("radius"),
+           py::arg("r_earth") = LayeredDensity::REFERENCE,
+           "The density of the Earth at a radius [km].")
+      .def("density",
+           py::vectorize(&DensityModel::density),
+           py::arg("radius"),
+           py::arg("r_earth") = LayeredDensity::REFERENCE,
+           "The density of the Earth at many radii [km].")
+      .def("material",
+           &DensityModel::material,
+           py::arg("radius"),
+           py::arg("r_earth") = LayeredDensity::REFERENCE,
+           "The material of the Earth at a radius [km].")
+      .def("column",
+           &DensityModel::column,
+           py::arg("r0"),
+           py::arg("r1"),
+           py::arg("r_earth") = LayeredDensity::REFERENCE,
+           "The radial column density between two radii [g/cm^3 * km].")
+      .def_property_readonly("analytic", &DensityModel::analytic);
+
+  // Layer
+  py::class_<Layer>(m, "Layer")
+      .def(py::init<const double, const MaterialID, const std::array<double, 4>&>(),
+           py::arg("outer"),
+           py::arg("material"),
+           py::arg("coeffs"),
+           "Create a polynomial shell for a LayeredDensity model.")
+      .def_readonly("outer", &Layer::outer_)
+      .def_readonly("material", &Layer::material_)
+      .def_readonly("coeffs", &Layer::coeffs_);
+
+  // LayeredDensity
+  py::class_<LayeredDensity, DensityModel, std::shared_ptr<LayeredDensity>>(
+      m, "LayeredDensity")
+      .def(py::init<const std::string&>(),
+           py::arg("filename"),
+           "Load a layered density model from a file.")
+      .def(py::init<const std::vector<Layer>&, const double>(),
+           py::arg("layers"),
+           py::arg("reference") = LayeredDensity::REFERENCE,
+           "Create a layered density model from a list of layers.")
+      .def("__len__", &LayeredDensity::size)
+      .def("__repr__", [](const LayeredDensity& self) -> std::string {
+        return "LayeredDensity(" + std::to_string(self.size()) + " shells)";
+      });
+
+  // FirnDensity
+  py::class_<FirnDensity, DensityModel, std::shared_ptr<FirnDensity>>(m, "FirnDensity")
+      .def(py::init<const double,
+                    const double,
+                    const double,
+                    const double,
+                    const std::shared_ptr<DensityModel>&>(),
+           py::arg("thickness")  = FirnDensity::THICKNESS,
+           py::arg("surface")    = FirnDensity::SURFACE,
+           py::arg("scale")      = FirnDensity::SCALE,
+           py::arg("ice")        = FirnDensity::ICE,
+           py::arg("background") = py::none(),
+           "Create an ice sheet with an exponential firn profile.");
+
+  // VoxelDensity
+  py::class_<VoxelDensity, std::shared_ptr<VoxelDensity>>(m, "VoxelDensity")
+      .def(py::init<const std::string&>(),
+           py::arg("filename"),
+           "Load a voxel density grid from a file.")
+      .def(py::init([](const Vector& origin,
+                       const Vector& spacing,
+                       const py::array_t<double, py::array::f_style | py::array::forcecast>&
+                           densities,
+                       const std::optional<py::array_t<MaterialID,
+                                                       py::array::f_style |
+                                                           py::array::forcecast>>& materials) {
+             // the grid must be three dimensional
+             if (densities.ndim() != 3) {
+               throw std::invalid_argument("VoxelDensity: densities must be a 3D array.");
+             }
+
+             // the shape of the grid
+             const std::array<int, 3> shape{{static_cast<int>(densities.shape(0)),
+                                             static_cast<int>(densities.shape(1)),
+                                             static_cast<int>(densities.shape(2))}};
+
+             // copy the (column-major) densities into a flat vector
+             const std::vector<double> rho(densities.data(),
+                                           densities.data() + densities.size());
+
+             // and use the materials if we were given them
+             std::vector<MaterialID> ids(rho.size(), materials::Rock);
+             if (materials) {
+               if (materials->size() != densities.size()) {
+                 throw std::invalid_argument(
+                     "VoxelDensity: materials must have the same shape as densities.");
+               }
+               ids.assign(materials->data(), materials->data() + materials->size());
+             }
+
+             return std::make_shared<VoxelDensity>(origin, spacing, shape, rho, ids);
+           }),
+           py::arg("origin"),
+           py::arg("spacing"),
+           py::arg("densities"),
+           py::arg("materials") = py::none(),
+           "Create a voxel grid from a 3D array of densities [g/cm^3].")
+      .def("contains",
+           &VoxelDensity::contains,
+           py::arg("location"),
+           "Check whether a location is inside the grid [km].")
+      .def("density",
+           &VoxelDensity::density,
+           py::arg("location"),
+           "The density inside the grid at a location [km].")
+      .def("material",
+           &VoxelDensity::material,
+           py::arg("location"),
+           "The material inside the grid at a location [km].")
+      .def(
+          "walk",
+          [](const VoxelDensity& self,
+             const CartesianCoordinate& location,
+             const Vector& direction,
+             const double grammage,
+             const double length) -> std::pair<double, CartesianCoordinate> {
+            // copy the location as it is updated by the walk
+            CartesianCoordinate end{location};
+
+            // walk through the grid
+            const auto crossed{self.walk(end, direction, grammage, length)};
+
+            // and return the grammage and the final location
+            return std::make_pair(crossed, end);
+          },
+          py::arg("location"),
+          py::arg("direction"),
+          py::arg("grammage") = std::numeric_limits<double>::infinity(),
+          py::arg("length")   = std::numeric_limits<double>::infinity(),
+          "Walk a ray through the grid and return the grammage and end point.")
+      .def_property_readonly("shape", &VoxelDensity::shape)
+      .def("__len__", &VoxelDensity::size);
+}
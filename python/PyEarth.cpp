@@ -1,7 +1,9 @@
 #include "apricot/Atmosphere.hpp"
 #include "apricot/Coordinates.hpp"
+#include "apricot/DensityModel.hpp"
 #include "apricot/Earth.hpp"
 #include "apricot/earth/SphericalEarth.hpp"
+#include "apricot/earth/VoxelDensity.hpp"
 #include <pybind11/eigen.h> // add support for Eigen
 #include <pybind11/numpy.h> // add support for numpy
 #include <pybind11/pybind11.h>
@@ -17,7 +19,7 @@ Py_Earth(py::module& m) {
   // Earth
   py::class_<Earth>(m, "Earth")
       .def("density",
-           &Earth::density,
+           py::overload_cast<const CartesianCoordinate&>(&Earth::density, py::const_),
            py::arg("location"),
            "The density of the Earth at a location [km].")
       .def(
@@ -35,10 +37,32 @@ Py_Earth(py::module& m) {
             return out;
           },
           "The density of the Earth at several locations [km].")
+      .def(
+          "grammage",
+          [](const Earth& earth,
+             const CartesianCoordinate& start,
+             const CartesianCoordinate& end) -> double {
+            return earth.grammage(start, end, earth.radius(0.5 * (start + end)));
+          },
+          py::arg("start"),
+          py::arg("end"),
+          "The grammage along a straight segment [g/cm^2].")
+      .def("material",
+           &Earth::material,
+           py::arg("location"),
+           "The material of the Earth at a location [km].")
       .def("add",
            py::overload_cast<const std::shared_ptr<Atmosphere>&>(&Earth::add),
            py::arg("atmosphere"),
-           "Add an atmosphere model to this Earth model.");
+           "Add an atmosphere model to this Earth model.")
+      .def("add",
+           py::overload_cast<const std::shared_ptr<DensityModel>&>(&Earth::add),
+           py::arg("interior"),
+           "Use a custom interior density model for this Earth model.")
+      .def("add",
+           py::overload_cast<const std::shared_ptr<VoxelDensity>&>(&Earth::add),
+           py::arg("voxels"),
+           "Add a regional voxel density grid to this Earth model.");
 
   // SphericalEarth
   py::class_<SphericalEarth, Earth>(m, "SphericalEarth")
@@ -1,72 +1,278 @@
 #include "apricot/Flux.hpp"
+#include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/particles/Neutrino.hpp"
 #include "apricot/particles/UHECR.hpp"
+#include "apricot/fluxes/CompositeFlux.hpp"
 #include "apricot/fluxes/FixedParticleFlux.hpp"
+#include "apricot/fluxes/PowerLawFlux.hpp"
+#include "apricot/fluxes/TabulatedFlux.hpp"
 #include "apricot/fluxes/UniformParticleFlux.hpp"
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 using namespace apricot;
 
+namespace {
+
+  /**
+   * A Python class for a flux model.
+   *
+   * Fluxes are held by shared pointers so they can be components of a CompositeFlux.
+   */
+  template <typename FluxType>
+  using flux_class = py::class_<FluxType, Flux, std::shared_ptr<FluxType>>;
+
+  /**
+   * Bind a tabulated flux of one particle type.
+   */
+  template <typename ParticleType>
+  auto
+  bind_tabulated(py::module& m, const char* name) -> void {
+    flux_class<TabulatedFlux<ParticleType>>(m, name)
+      .def(py::init<const std::string&>(), py::arg("filename"),
+           "Sample energies from a file of '<log10(E/eV)> <dN/dE>' rows.")
+      .def(py::init([](const std::shared_ptr<SpectrumTable>& spectrum) {
+             return TabulatedFlux<ParticleType>(spectrum);
+           }),
+           py::arg("spectrum"),
+           "Sample energies from a (shared) SpectrumTable.")
+      .def_property_readonly("spectrum",
+          [](const TabulatedFlux<ParticleType>& self) {
+            return std::const_pointer_cast<SpectrumTable>(self.spectrum_);
+          },
+          "The spectrum that energies are sampled from.")
+      .def("get_particle", &TabulatedFlux<ParticleType>::get_particle,
+           "Return a randomly sampled particle from this flux model.");
+  }
+
+  /**
+   * Bind a (broken) power-law flux of one particle type.
+   *
+   * A broken power-law is the same class, so it is bound once and
+   * exported under both names.
+   */
+  template <typename ParticleType>
+  auto
+  bind_power_law(py::module& m, const std::string& name) -> void {
+
+    const auto flux{
+        flux_class<PowerLawFlux<ParticleType>>(m, ("PowerLaw" + name + "Flux").c_str())
+      .def(py::init<const double, const LogEnergy, const LogEnergy>(),
+           py::arg("index"), py::arg("min_energy"), py::arg("max_energy"),
+           "Sample dN/dE ∝ E^-index between two energies in log10(eV).")
+      .def(py::init<const std::vector<LogEnergy>&, const std::vector<double>&>(),
+           py::arg("energies"), py::arg("indices"),
+           "Sample a broken power-law with breaks at energies in log10(eV).")
+      .def_property_readonly("index",
+          [](const PowerLawFlux<ParticleType>& self) {
+            return self.spectrum_.get_indices().front();
+          },
+          "The spectral index of dN/dE (in the first segment).")
+      .def_property_readonly("min_energy",
+          [](const PowerLawFlux<ParticleType>& self) {
+            return self.spectrum_.get_energies().front();
+          },
+          "The minimum energy in log10(eV).")
+      .def_property_readonly("max_energy",
+          [](const PowerLawFlux<ParticleType>& self) {
+            return self.spectrum_.get_energies().back();
+          },
+          "The maximum energy in log10(eV).")
+      .def_property_readonly("energies",
+          [](const PowerLawFlux<ParticleType>& self) {
+            return self.spectrum_.get_energies();
+          },
+          "The break energies in log10(eV).")
+      .def_property_readonly("indices",
+          [](const PowerLawFlux<ParticleType>& self) {
+            return self.spectrum_.get_indices();
+          },
+          "The spectral index of dN/dE in each segment.")
+      .def("pdf", py::vectorize([](const PowerLawFlux<ParticleType>& self,
+                                   const LogEnergy energy) { return self.spectrum_.pdf(energy); }),
+           py::arg("energy"), "The sampling density, dP/dE [1/eV], at energies in log10(eV).")
+      .def("weight",
+           py::vectorize([](const PowerLawFlux<ParticleType>& self, const LogEnergy energy) {
+             return self.spectrum_.weight(energy);
+           }),
+           py::arg("energy"), "The generation weight, 1/(dP/dE) [eV], at energies in log10(eV).")
+      .def("get_particle", &PowerLawFlux<ParticleType>::get_particle,
+           "Return a randomly sampled particle from this flux model.")};
+
+    // and export it as a broken power-law as well
+    m.attr(("BrokenPowerLaw" + name + "Flux").c_str()) = flux;
+  }
+
+} // namespace
+
 void
 Py_Flux(py::module& m) {
 
   // the base Flux class
-  py::class_<Flux>(m, "Flux");
+  py::class_<Flux, std::shared_ptr<Flux>>(m, "Flux");
+
+  // a tabulated spectrum
+  py::class_<SpectrumTable, std::shared_ptr<SpectrumTable>>(m, "SpectrumTable")
+    .def(py::init<const std::vector<LogEnergy>&, const std::vector<double>&>(),
+         py::arg("energies"), py::arg("flux"),
+         "Tabulate a spectrum, dN/dE, at energies in log10(eV).")
+    .def(py::init<const std::string&>(), py::arg("filename"),
+         "Load a spectrum from a file of '<log10(E/eV)> <dN/dE>' rows.")
+    .def("sample", &SpectrumTable::sample,
+         "Sample a random energy [log10(eV)] from the spectrum.")
+    .def("flux", py::vectorize(&SpectrumTable::flux), py::arg("energy"),
+         "The interpolated flux, dN/dE, at energies in log10(eV).")
+    .def_property_readonly("integral", &SpectrumTable::integral,
+                           "The integral of the flux over all tabulated energies.")
+    .def_property_readonly("min_energy", &SpectrumTable::get_min_energy)
+    .def_property_readonly("max_energy", &SpectrumTable::get_max_energy);
 
   // a fixed particle and energy for proton
-  py::class_<FixedParticleFlux<Proton>, Flux>(m, "FixedProtonFlux")
+  flux_class<FixedParticleFlux<Proton>>(m, "FixedProtonFlux")
     .def(py::init<const double>(),
          "Create a FixedProtonFlux at an energy in log10(eV).")
     .def("get_particle", &FixedParticleFlux<Proton>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for helium
-  py::class_<FixedParticleFlux<Helium>, Flux>(m, "FixedHeliumFlux")
+  flux_class<FixedParticleFlux<Helium>>(m, "FixedHeliumFlux")
     .def(py::init<const double>(),
          "Create a FixedHeliumFlux at an energy in log10(eV).")
     .def("get_particle", &FixedParticleFlux<Helium>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for nitrogen
-  py::class_<FixedParticleFlux<Nitrogen>, Flux>(m, "FixedNitrogenFlux")
+  flux_class<FixedParticleFlux<Nitrogen>>(m, "FixedNitrogenFlux")
     .def(py::init<const double>(),
          "Create a FixedNitrogenFlux at an energy in log10(eV).")
     .def("get_particle", &FixedParticleFlux<Nitrogen>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for iron
-  py::class_<FixedParticleFlux<Iron>, Flux>(m, "FixedIronFlux")
+  flux_class<FixedParticleFlux<Iron>>(m, "FixedIronFlux")
     .def(py::init<const double>(),
          "Create a FixedIronFlux at an energy in log10(eV).")
     .def("get_particle", &FixedParticleFlux<Iron>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for proton
-  py::class_<UniformParticleFlux<Proton>, Flux>(m, "UniformProtonFlux")
+  flux_class<UniformParticleFlux<Proton>>(m, "UniformProtonFlux")
     .def(py::init<const double, const double>(),
          "Create a UniformProtonFlux between two energies in log10(eV).")
     .def("get_particle", &UniformParticleFlux<Proton>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for helium
-  py::class_<UniformParticleFlux<Helium>, Flux>(m, "UniformHeliumFlux")
+  flux_class<UniformParticleFlux<Helium>>(m, "UniformHeliumFlux")
     .def(py::init<const double, const double>(),
          "Create a UniformHeliumFlux between two energies in log10(eV).")
     .def("get_particle", &UniformParticleFlux<Helium>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for nitrogen
-  py::class_<UniformParticleFlux<Nitrogen>, Flux>(m, "UniformNitrogenFlux")
+  flux_class<UniformParticleFlux<Nitrogen>>(m, "UniformNitrogenFlux")
     .def(py::init<const double, const double>(),
          "Create a UniformNitrogenFlux between two energies in log10(eV).")
     .def("get_particle", &UniformParticleFlux<Nitrogen>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
   // a fixed particle and energy for iron
-  py::class_<UniformParticleFlux<Iron>, Flux>(m, "UniformIronFlux")
+  flux_class<UniformParticleFlux<Iron>>(m, "UniformIronFlux")
     .def(py::init<const double, const double>(),
          "Create a UniformIronFlux between two energies in log10(eV).")
     .def("get_particle", &UniformParticleFlux<Iron>::get_particle,
          "Return a randomly sampled particle from this flux model.");
 
+  // a fixed particle and energy for muon neutrinos
+  flux_class<FixedParticleFlux<MuonNeutrino>>(m, "FixedMuonNeutrinoFlux")
+    .def(py::init<const double>(),
+         "Create a FixedMuonNeutrinoFlux at an energy in log10(eV).")
+    .def("get_particle", &FixedParticleFlux<MuonNeutrino>::get_particle,
+         "Return a randomly sampled particle from this flux model.");
+
+  // a uniform energy for muon neutrinos
+  flux_class<UniformParticleFlux<MuonNeutrino>>(m, "UniformMuonNeutrinoFlux")
+    .def(py::init<const double, const double>(),
+         "Create a UniformMuonNeutrinoFlux between two energies in log10(eV).")
+    .def("get_particle", &UniformParticleFlux<MuonNeutrino>::get_particle,
+         "Return a randomly sampled particle from this flux model.");
+
+  // a fixed particle and energy for tau neutrinos
+  flux_class<FixedParticleFlux<TauNeutrino>>(m, "FixedTauNeutrinoFlux")
+    .def(py::init<const double>(),
+         "Create a FixedTauNeutrinoFlux at an energy in log10(eV).")
+    .def("get_particle", &FixedParticleFlux<TauNeutrino>::get_particle,
+         "Return a randomly sampled particle from this flux model.");
+
+  // a uniform energy for tau neutrinos
+  flux_class<UniformParticleFlux<TauNeutrino>>(m, "UniformTauNeutrinoFlux")
+    .def(py::init<const double, const double>(),
+         "Create a UniformTauNeutrinoFlux between two energies in log10(eV).")
+    .def("get_particle", &UniformParticleFlux<TauNeutrino>::get_particle,
+         "Return a randomly sampled particle from this flux model.");
+
+  // tabulated spectra of each particle
+  bind_tabulated<Proton>(m, "TabulatedProtonFlux");
+  bind_tabulated<Helium>(m, "TabulatedHeliumFlux");
+  bind_tabulated<Nitrogen>(m, "TabulatedNitrogenFlux");
+  bind_tabulated<Iron>(m, "TabulatedIronFlux");
+  bind_tabulated<MuonNeutrino>(m, "TabulatedMuonNeutrinoFlux");
+  bind_tabulated<TauNeutrino>(m, "TabulatedTauNeutrinoFlux");
+
+  // (broken) power-law spectra of each particle
+  bind_power_law<Proton>(m, "Proton");
+  bind_power_law<Helium>(m, "Helium");
+  bind_power_law<Nitrogen>(m, "Nitrogen");
+  bind_power_law<Iron>(m, "Iron");
+  bind_power_law<MixedUHECR>(m, "MixedUHECR");
+  bind_power_law<ElectronNeutrino>(m, "ElectronNeutrino");
+  bind_power_law<MuonNeutrino>(m, "MuonNeutrino");
+  bind_power_law<TauNeutrino>(m, "TauNeutrino");
+  bind_power_law<Electron>(m, "Electron");
+  bind_power_law<Muon>(m, "Muon");
+  bind_power_law<Tau>(m, "Tau");
+
+  // a mixture of fluxes or an energy-dependent composition
+  flux_class<CompositeFlux>(m, "CompositeFlux")
+    .def(py::init([](const std::vector<std::shared_ptr<Flux>>& fluxes,
+                     const std::vector<double>& fractions) {
+           return std::make_shared<CompositeFlux>(
+               std::vector<std::shared_ptr<const Flux>>(fluxes.begin(), fluxes.end()), fractions);
+         }),
+         py::arg("fluxes"), py::arg("fractions"),
+         "Mix several fluxes with a fixed (relative) fraction of each.")
+    .def(py::init([](const std::shared_ptr<Flux>& spectrum,
+                     const std::vector<ParticleID>& species,
+                     const std::vector<double>& fractions) {
+           std::vector<CompositeFlux::Species> factories;
+           for (const auto pdgid : species) factories.push_back(CompositeFlux::species(pdgid));
+           return std::make_shared<CompositeFlux>(spectrum, factories, fractions);
+         }),
+         py::arg("spectrum"), py::arg("species"), py::arg("fractions"),
+         "Sample energies from a spectrum and species (PDG IDs) from a fixed composition.")
+    .def(py::init([](const std::shared_ptr<Flux>& spectrum,
+                     const std::vector<ParticleID>& species,
+                     const std::vector<LogEnergy>& energies,
+                     const std::vector<std::vector<double>>& fractions) {
+           std::vector<CompositeFlux::Species> factories;
+           for (const auto pdgid : species) factories.push_back(CompositeFlux::species(pdgid));
+           return std::make_shared<CompositeFlux>(spectrum, factories, energies, fractions);
+         }),
+         py::arg("spectrum"), py::arg("species"), py::arg("energies"), py::arg("fractions"),
+         "Sample energies from a spectrum and species (PDG IDs) from a composition "
+         "tabulated at energies in log10(eV).")
+    .def_static("neutrinos",
+        [](const std::shared_ptr<Flux>& spectrum, const std::vector<double>& ratios) {
+          return std::make_shared<CompositeFlux>(CompositeFlux::neutrinos(spectrum, ratios));
+        },
+        py::arg("spectrum"), py::arg("ratios") = std::vector<double>{1., 1., 1.},
+        "Sample neutrinos from a spectrum with (e, mu, tau) flavor ratios.")
+    .def("fraction", py::vectorize(&CompositeFlux::fraction), py::arg("component"),
+         py::arg("energy"), "The fraction of a component at energies in log10(eV).")
+    .def("__len__", &CompositeFlux::size)
+    .def("get_particle", &CompositeFlux::get_particle,
+         "Return a randomly sampled particle from this flux model.");
+
 }
@@ -114,4 +114,34 @@ Py_Geometry(py::module& m) {
                py::arg("locations"),
                py::arg("normals"),
                "Reflect a vector below the surface defined by a normal.");
+
+  // the batched coordinate transforms - these map (N, 3) arrays of
+  // either memory layout without copying the inputs.
+  geometry.def("to_spherical",
+               &to_spherical_batch,
+               py::arg("locations"),
+               "Convert (N, 3) cartesian coordinates to (r, theta, phi).");
+  geometry.def("to_cartesian",
+               &to_cartesian_batch,
+               py::arg("locations"),
+               "Convert (N, 3) spherical (r, theta, phi) coordinates to cartesian.");
+  geometry.def("to_geodetic",
+               &to_geodetic,
+               py::arg("locations"),
+               "Convert (N, 3) geocentric coordinates to WGS84 (lat, lon, height).");
+  geometry.def("from_geodetic",
+               &from_geodetic,
+               py::arg("locations"),
+               "Convert (N, 3) WGS84 (lat, lon, height) coordinates to geocentric.");
+  geometry.def("to_enu",
+               &to_enu,
+               py::arg("locations"),
+               py::arg("origin"),
+               py::arg("geodetic") = true,
+               "Convert (N, 3) geocentric coordinates into a local East-North-Up frame.");
+  geometry.def("payload_view",
+               &payload_view,
+               py::arg("locations"),
+               py::arg("payload"),
+               "Return the (elevation, azimuth) of (N, 3) locations seen from a payload.");
 }
@@ -25,5 +25,7 @@ Py_Interaction(py::module& m) {
       .def_readonly("location", &Interaction::location_)
       .def_readonly("direction", &Interaction::direction_)
       .def_readonly("weight", &Interaction::weight_)
+      .def_readonly("generation_weight", &Interaction::generation_weight_,
+                    "The generation weight of the primary, 1/(P(species) dP/dE) [eV].")
       .def_readonly("altitude", &Interaction::altitude_);
 }
@@ -1,4 +1,5 @@
 #include "apricot/Particle.hpp"
+#include "apricot/PhysicsConfig.hpp"
 #include "apricot/particles/Neutrino.hpp"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -10,7 +11,21 @@ void
 Py_Neutrino(py::module& m) {
 
     // Neutrino
-  py::class_<Neutrino, Particle>(m, "Neutrino");
+  py::class_<Neutrino, Particle>(m, "Neutrino")
+    .def("sample_inelasticity", &Neutrino::sample_inelasticity,
+         "Sample the inelasticity (y) of an interaction at this energy.")
+    .def("sample_lepton_energy", &Neutrino::sample_lepton_energy,
+         "Sample the energy of the outgoing lepton in log10(eV).")
+    .def_property_static("cross_section_model",
+        [](py::object) { return PhysicsConfig::global().cross_sections->get_name(); },
+        [](py::object, const py::object& model) {
+          // models can be selected by name or by their built-in enum
+          PhysicsConfig::global().cross_sections =
+              py::isinstance<py::str>(model)
+                  ? &NeutrinoCrossSectionTable::get(model.cast<std::string>())
+                  : &NeutrinoCrossSectionTable::get(model.cast<NeutrinoCrossSectionModel>());
+        },
+        "The name of the global neutrino cross section model (a registered name or built-in model).");
 
   // ElectronNeutrino
   py::class_<ElectronNeutrino, Neutrino>(m, "ElectronNeutrino")
@@ -1,6 +1,9 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/eigen.h>
+#include <pybind11/stl.h>
 #include "apricot/particles/NeutrinoCrossSection.hpp"
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
 
 namespace py = pybind11;
 using namespace apricot;
@@ -18,21 +21,69 @@ void Py_NeutrinoCrossSection(py::module& m) {
     .value("ConnollyUpper", NeutrinoCrossSectionModel::ConnollyUpper)
     .value("Gorham", NeutrinoCrossSectionModel::Gorham);
 
-  // charged current
-  CS.def("charged_current", &charged_current,
+  // charged current - arrays of energies are passed to (and returned
+  // from) the batched C++ overload without copying
+  CS.def("charged_current",
+         py::overload_cast<const NeutrinoCrossSectionModel, const LogEnergy>(&charged_current),
          "Calculate the charged current neutrino cross section "
          " [log10(g/cm^2)] at an energy in [log10(eV)]");
-  CS.def("charged_current", py::vectorize(&charged_current),
+  CS.def("charged_current",
+         py::overload_cast<const NeutrinoCrossSectionModel, const EnergiesView&>(
+             &charged_current),
          "Calculate the charged current neutrino cross section "
          " [log10(g/cm^2)] at energies in [log10(eV)]");
 
   // neutral current
-  CS.def("neutral_current", &neutral_current,
+  CS.def("neutral_current",
+         py::overload_cast<const NeutrinoCrossSectionModel, const LogEnergy>(&neutral_current),
          "Calculate the neutral current neutrino cross section "
          " [log10(g/cm^2)] at an energy in [log10(eV)]");
-  CS.def("neutral_current", py::vectorize(&neutral_current),
+  CS.def("neutral_current",
+         py::overload_cast<const NeutrinoCrossSectionModel, const EnergiesView&>(
+             &neutral_current),
          "Calculate the neutral current neutrino cross section "
          " [log10(g/cm^2)] at energies in [log10(eV)]");
 
+  // NeutrinoCrossSectionTable
+  py::class_<NeutrinoCrossSectionTable>(CS, "NeutrinoCrossSectionTable")
+    .def(py::init<const NeutrinoCrossSectionModel>(), py::arg("model"),
+         "Tabulate a neutrino cross section model.")
+    .def(py::init<const std::string&, const std::vector<LogEnergy>&,
+                  const std::vector<double>&, const std::vector<double>&>(),
+         py::arg("name"), py::arg("energies"), py::arg("charged"), py::arg("neutral"),
+         "Tabulate a model from its CC and NC cross sections [cm^2].")
+    .def_static("get",
+                py::overload_cast<const NeutrinoCrossSectionModel>(&NeutrinoCrossSectionTable::get),
+                py::return_value_policy::reference, py::arg("model"),
+                "Get the shared table for a cross section model.")
+    .def_static("get",
+                py::overload_cast<const std::string&>(&NeutrinoCrossSectionTable::get),
+                py::return_value_policy::reference, py::arg("name"),
+                "Get a registered cross section model by name.")
+    .def_static("add", &NeutrinoCrossSectionTable::add,
+                py::return_value_policy::reference,
+                py::arg("name"), py::arg("energies"), py::arg("charged"), py::arg("neutral"),
+                "Register a model from its CC and NC cross sections [cm^2].")
+    .def_static("load", &NeutrinoCrossSectionTable::load,
+                py::return_value_policy::reference, py::arg("name"), py::arg("filename"),
+                "Load and register a tabulated cross section model from a file.")
+    .def_static("names", &NeutrinoCrossSectionTable::names,
+                "The names of every registered cross section model.")
+    .def("interaction_length", py::vectorize(&NeutrinoCrossSectionTable::interaction_length),
+         py::arg("energy"),
+         "The total (CC + NC) interaction length [g/cm^2] at energies in [log10(eV)]")
+    .def("charged_fraction", py::vectorize(&NeutrinoCrossSectionTable::charged_fraction),
+         py::arg("energy"),
+         "The fraction of interactions that are charged current at energies in [log10(eV)]")
+    .def("charged_current", py::vectorize(&NeutrinoCrossSectionTable::charged_current),
+         py::arg("energy"),
+         "The charged current cross section [log10(cm^2)] at energies in [log10(eV)]")
+    .def("neutral_current", py::vectorize(&NeutrinoCrossSectionTable::neutral_current),
+         py::arg("energy"),
+         "The neutral current cross section [log10(cm^2)] at energies in [log10(eV)]")
+    .def_property_readonly("model", &NeutrinoCrossSectionTable::get_model,
+                           "The built-in cross section model of this table (if any).")
+    .def_property_readonly("name", &NeutrinoCrossSectionTable::get_name,
+                           "The name of the model of this table.");
 
 }
@@ -1,5 +1,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/eigen.h>
+#include "apricot/particles/InelasticityTable.hpp"
 #include "apricot/particles/NeutrinoYFactor.hpp"
 
 namespace py = pybind11;
@@ -16,12 +18,25 @@ void Py_NeutrinoYFactor(py::module& m) {
     .value("Soyez", NeutrinoYFactorModel::Soyez)
     .value("ALLM", NeutrinoYFactorModel::ALLM);
 
-  // and the evaluation function
-  yfactor.def("y_factor", &y_factor,
+  // and the evaluation function - arrays of energies are passed to (and
+  // returned from) the batched C++ overload without copying
+  yfactor.def("y_factor",
+              py::overload_cast<const LogEnergy, const NeutrinoYFactorModel&>(&y_factor),
               "Calculate the average neutrino y-factor at an energy in log10(eV).");
-  yfactor.def("y_factor", // vectorize over energy
-    [](py::array_t<double> energy, NeutrinoYFactorModel& model) {
-      return py::vectorize([model](const double E) { return y_factor(E, model); })(energy);
-    }, "Calculate the average neutrino y-factor several energies in log10(eV).");
+  yfactor.def("y_factor",
+              py::overload_cast<const EnergiesView&, const NeutrinoYFactorModel&>(&y_factor),
+              "Calculate the average neutrino y-factor several energies in log10(eV).");
+
+  // InelasticityTable
+  py::class_<InelasticityTable>(yfactor, "InelasticityTable")
+    .def(py::init<const NeutrinoYFactorModel>(), py::arg("model"),
+         "Tabulate the inelasticity distribution of a y-factor model.")
+    .def_static("get", &InelasticityTable::get,
+                py::return_value_policy::reference, py::arg("model"),
+                "Get the shared table for a y-factor model.")
+    .def("sample", py::vectorize(&InelasticityTable::sample), py::arg("energy"),
+         "Sample an inelasticity at energies in log10(eV).")
+    .def("mean", py::vectorize(&InelasticityTable::mean), py::arg("energy"),
+         "The mean inelasticity of the table at energies in log10(eV).");
 
 }
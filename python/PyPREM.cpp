@@ -24,5 +24,8 @@ void Py_PREM(py::module& m) {
   prem.def("density", py::vectorize(&PREM::density),
            py::arg("radius"), py::arg("r_earth") = 6356.755,
            "Return the density of the Earth at many radii (km).");
+  prem.def("column", &PREM::column,
+           py::arg("r0"), py::arg("r1"), py::arg("r_earth") = 6356.755,
+           "Return the exact column density between two radii (g/cm^3 * km).");
 
 }
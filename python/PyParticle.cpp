@@ -1,8 +1,10 @@
 #include "apricot/Particle.hpp"
 #include "apricot/particles/Neutrino.hpp"
 #include "apricot/particles/UHECR.hpp"
+#include <pybind11/functional.h>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 using namespace apricot;
@@ -44,11 +46,31 @@ Py_Particle(py::module& m) {
   // Particle
   py::class_<Particle>(m, "Particle")
       .def_property("energy", &Particle::get_energy, &Particle::set_energy)
+      .def_property("weight", &Particle::get_weight, &Particle::set_weight,
+                    "The generation weight, 1/(P(species) dP/dE) [eV], or 1 for unweighted fluxes.")
       .def_property_readonly("id", &Particle::get_id, "Get the particle PDG id.")
       .def("__repr__", [](const Particle& p) {
         return "Particle(" + std::to_string(p.get_energy()) + ")";
       });
 
+  // XmaxDistribution
+  py::class_<XmaxDistribution, std::shared_ptr<XmaxDistribution>>(m, "XmaxDistribution")
+      .def(py::init<const std::vector<LogEnergy>&, const std::vector<double>&>(),
+           py::arg("energies"), py::arg("xmax"),
+           "Build a distribution of Xmax from a set of showers.")
+      .def(py::init<const std::string&>(), py::arg("filename"),
+           "Load a distribution of Xmax from a file of showers.")
+      .def_static("gumbel", &XmaxDistribution::gumbel,
+                  py::arg("mean"), py::arg("sigma"),
+                  py::arg("emin") = 16., py::arg("emax") = 21., py::arg("nenergies") = 51,
+                  "Build a Gumbel distribution with an energy-dependent mean and RMS.")
+      .def("quantile", py::vectorize(&XmaxDistribution::quantile),
+           py::arg("energy"), py::arg("probability"),
+           "Evaluate the inverse CDF of Xmax [g/cm^2].")
+      .def("sample", py::vectorize(&XmaxDistribution::sample), py::arg("energy"),
+           "Sample a random Xmax [g/cm^2].")
+      .def_property_readonly("energies", &XmaxDistribution::get_energies);
+
   // Proton
   py::class_<Proton, Particle>(m, "Proton")
       .def(py::init<const double>())
@@ -56,6 +78,13 @@ Py_Particle(py::module& m) {
       .def_static("get_Xmax",
                   py::vectorize(&Proton::get_Xmax),
                   "Get the grammage at shower max [g/cm^2].")
+      .def_static("sample_Xmax",
+                  py::vectorize(&Proton::sample_Xmax),
+                  "Sample a random grammage at shower max [g/cm^2].")
+      .def_static("get_Xmax_distribution",
+                  &Proton::get_Xmax_distribution,
+                  py::return_value_policy::reference,
+                  "Get the distribution of the grammage at shower max.")
       .def("__repr__", [](const Proton& p) {
         return "Proton(" + std::to_string(p.get_energy()) + ")";
       });
@@ -67,6 +96,13 @@ Py_Particle(py::module& m) {
       .def_static("get_Xmax",
                   py::vectorize(&Helium::get_Xmax),
                   "Get the grammage at shower max [g/cm^2].")
+      .def_static("sample_Xmax",
+                  py::vectorize(&Helium::sample_Xmax),
+                  "Sample a random grammage at shower max [g/cm^2].")
+      .def_static("get_Xmax_distribution",
+                  &Helium::get_Xmax_distribution,
+                  py::return_value_policy::reference,
+                  "Get the distribution of the grammage at shower max.")
       .def("__repr__", [](const Helium& p) {
         return "Helium(" + std::to_string(p.get_energy()) + ")";
       });
@@ -80,6 +116,13 @@ Py_Particle(py::module& m) {
       .def_static("get_Xmax",
                   py::vectorize(&Nitrogen::get_Xmax),
                   "Get the grammage at shower max [g/cm^2].")
+      .def_static("sample_Xmax",
+                  py::vectorize(&Nitrogen::sample_Xmax),
+                  "Sample a random grammage at shower max [g/cm^2].")
+      .def_static("get_Xmax_distribution",
+                  &Nitrogen::get_Xmax_distribution,
+                  py::return_value_policy::reference,
+                  "Get the distribution of the grammage at shower max.")
       .def("__repr__", [](const Nitrogen& p) {
         return "Nitrogen(" + std::to_string(p.get_energy()) + ")";
       });
@@ -91,6 +134,13 @@ Py_Particle(py::module& m) {
       .def_static("get_Xmax",
                   py::vectorize(&Iron::get_Xmax),
                   "Get the grammage at shower max [g/cm^2].")
+      .def_static("sample_Xmax",
+                  py::vectorize(&Iron::sample_Xmax),
+                  "Sample a random grammage at shower max [g/cm^2].")
+      .def_static("get_Xmax_distribution",
+                  &Iron::get_Xmax_distribution,
+                  py::return_value_policy::reference,
+                  "Get the distribution of the grammage at shower max.")
       .def("__repr__",
            [](const Iron& p) { return "Iron(" + std::to_string(p.get_energy()) + ")"; });
 
@@ -103,6 +153,13 @@ Py_Particle(py::module& m) {
       .def_static("get_Xmax",
                   py::vectorize(&MixedUHECR::get_Xmax),
                   "Get the grammage at shower max [g/cm^2].")
+      .def_static("sample_Xmax",
+                  py::vectorize(&MixedUHECR::sample_Xmax),
+                  "Sample a random grammage at shower max [g/cm^2].")
+      .def_static("get_Xmax_distribution",
+                  &MixedUHECR::get_Xmax_distribution,
+                  py::return_value_policy::reference,
+                  "Get the distribution of the grammage at shower max.")
       .def("__repr__", [](const MixedUHECR& p) {
         return "MixedUHECR(" + std::to_string(p.get_energy()) + ")";
       });
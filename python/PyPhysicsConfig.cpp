@@ -0,0 +1,65 @@
+#include "apricot/PhysicsConfig.hpp"
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+using namespace apricot;
+
+namespace {
+
+  /**
+   * Find a cross section model by name or by its built-in enum.
+   */
+  auto
+  cross_section_table(const py::object& model) -> const NeutrinoCrossSectionTable* {
+    return py::isinstance<py::str>(model)
+               ? &NeutrinoCrossSectionTable::get(model.cast<std::string>())
+               : &NeutrinoCrossSectionTable::get(model.cast<NeutrinoCrossSectionModel>());
+  }
+
+} // namespace
+
+void
+Py_PhysicsConfig(py::module& m) {
+
+  // PhysicsConfig
+  py::class_<PhysicsConfig>(m, "PhysicsConfig")
+    .def(py::init([](const py::object& cross_section_model,
+                     const py::object& y_factor_model,
+                     const py::object& energy_loss_model) {
+           // any model that is not given is taken from the global configuration
+           PhysicsConfig config{PhysicsConfig::global()};
+           if (!cross_section_model.is_none()) {
+             config.cross_sections = cross_section_table(cross_section_model);
+           }
+           if (!y_factor_model.is_none()) {
+             config.y_factor_model = y_factor_model.cast<NeutrinoYFactorModel>();
+           }
+           if (!energy_loss_model.is_none()) {
+             config.energy_loss_model = energy_loss_model.cast<LeptonEnergyLossModel>();
+           }
+           return config;
+         }),
+         py::arg("cross_section_model") = py::none(),
+         py::arg("y_factor_model") = py::none(),
+         py::arg("energy_loss_model") = py::none(),
+         "Create a set of physics models; unset models are copied from the global models.")
+    .def_static("global_config", &PhysicsConfig::global, py::return_value_policy::reference,
+                "The global physics models used by propagators without their own models.")
+    .def_property("cross_section_model",
+        [](const PhysicsConfig& self) { return self.cross_sections->get_name(); },
+        [](PhysicsConfig& self, const py::object& model) {
+          self.cross_sections = cross_section_table(model);
+        },
+        "The name of the neutrino cross section model (a registered name or built-in model).")
+    .def_readwrite("y_factor_model", &PhysicsConfig::y_factor_model,
+                   "The model used to sample the inelasticity of neutrino interactions.")
+    .def_readwrite("energy_loss_model", &PhysicsConfig::energy_loss_model,
+                   "The model to use for leptonic energy loss.")
+    .def("__repr__", [](const PhysicsConfig& self) -> std::string {
+      return "PhysicsConfig(cross_section_model='" + self.cross_sections->get_name() +
+             "', y_factor_model=" +
+             py::str(py::cast(self.y_factor_model)).cast<std::string>() +
+             ", energy_loss_model=" +
+             py::str(py::cast(self.energy_loss_model)).cast<std::string>() + ")";
+    });
+}
@@ -4,6 +4,9 @@
 #include "apricot/Propagator.hpp"
 #include "apricot/Source.hpp"
 #include "apricot/propagators/SimplePropagator.hpp"
+#include "apricot/propagators/TauExitPropagator.hpp"
+#include "apricot/propagators/TauExitTable.hpp"
+#include "apricot/propagators/UHECRPropagator.hpp"
 
 #include <pybind11/eigen.h>
 #include <pybind11/numpy.h>
@@ -18,11 +21,21 @@ Py_Propagator(py::module& m) {
 
   // the base FluxModel class
   py::class_<Propagator>(m, "Propagator")
+      .def_property("physics",
+          [](const Propagator& self) -> PhysicsConfig { return self.get_physics(); },
+          &Propagator::set_physics,
+          "A copy of the physics models used by this propagator.")
       .def("__repr__",
            [](const Propagator& self) -> std::string { return "Propagator()"; });
 
   py::class_<SimplePropagator, Propagator>(m, "SimplePropagator")
-      .def(py::init<const Earth&>())
+      .def(py::init<const Earth&, const bool, const bool>(),
+           py::arg("earth"),
+           py::arg("taus")  = false,
+           py::arg("muons") = false,
+           "Create a propagator that optionally transports taus and muons through the Earth.")
+      .def_property_readonly("taus", &SimplePropagator::get_taus)
+      .def_property_readonly("muons", &SimplePropagator::get_muons)
       .def("propagate",
            py::overload_cast<Source&, Flux&, const Detector&>(&SimplePropagator::propagate,
                                                               py::const_),
@@ -32,6 +45,91 @@ Py_Propagator(py::module& m) {
                &Propagator::propagate, py::const_), py::call_guard<py::gil_scoped_release>(),
            "Propagate several particles to a detector.")
       .def("__repr__", [](const SimplePropagator& self) -> std::string {
-        return "SimplePropagator()";
+        // only show the leptons that we transport
+        std::string leptons;
+        if (self.get_taus()) leptons += "taus=True";
+        if (self.get_muons()) leptons += std::string(leptons.empty() ? "" : ", ") + "muons=True";
+        return "SimplePropagator(" + leptons + ")";
+      });
+
+  py::class_<UHECRPropagator, Propagator>(m, "UHECRPropagator")
+      .def(py::init<const Earth&, const std::shared_ptr<SlantDepthTable>&>(),
+           py::arg("earth"),
+           py::arg("table") = nullptr,
+           "Create a propagator that finds the shower maximum of cosmic rays directly.")
+      .def("propagate",
+           py::overload_cast<Source&, Flux&, const Detector&>(&UHECRPropagator::propagate,
+                                                             py::const_),
+           "Propagate a single particle to the detector.")
+      .def("propagate",
+           py::overload_cast<Source&, Flux&, const Detector&, const int>(
+               &Propagator::propagate, py::const_), py::call_guard<py::gil_scoped_release>(),
+           "Propagate several particles to a detector.")
+      .def_property_readonly("table", &UHECRPropagator::get_table,
+                             "The slant depth table of the atmosphere.")
+      .def("__repr__", [](const UHECRPropagator& self) -> std::string {
+        return "UHECRPropagator()";
+      });
+
+  py::class_<TauExitTable, std::shared_ptr<TauExitTable>>(m, "TauExitTable")
+      .def(py::init<const Earth&,
+                    const LogEnergy,
+                    const LogEnergy,
+                    const int,
+                    const std::vector<double>&,
+                    const int,
+                    const int>(),
+           py::arg("earth"),
+           py::arg("emin"),
+           py::arg("emax"),
+           py::arg("nenergies"),
+           py::arg("angles"),
+           py::arg("ntrials"),
+           py::arg("nthreads") = 0,
+           py::call_guard<py::gil_scoped_release>(),
+           "Generate tau exit tables for an Earth model.")
+      .def(py::init<const std::string&>(),
+           py::arg("filename"),
+           "Load tau exit tables from a binary file.")
+      .def("save", &TauExitTable::save, py::arg("filename"),
+           "Save the tables to a binary file.")
+      .def("probability",
+           py::vectorize(&TauExitTable::probability),
+           py::arg("energy"),
+           py::arg("angle"),
+           "The tau exit probability at a neutrino energy [log10(eV)] and emergence angle [deg].")
+      .def("sample",
+           &TauExitTable::sample,
+           py::arg("energy"),
+           py::arg("angle"),
+           "Sample the log10 energy [eV] of an exiting tau (or None).")
+      .def_property_readonly("emin", &TauExitTable::get_emin)
+      .def_property_readonly("emax", &TauExitTable::get_emax)
+      .def_property_readonly("nenergies", &TauExitTable::get_nenergies)
+      .def_property_readonly("angles", &TauExitTable::get_angles)
+      .def("__repr__", [](const TauExitTable& self) -> std::string {
+        return "TauExitTable(emin=" + std::to_string(self.get_emin()) +
+               ", emax=" + std::to_string(self.get_emax()) +
+               ", nenergies=" + std::to_string(self.get_nenergies()) +
+               ", nangles=" + std::to_string(self.get_angles().size()) + ")";
+      });
+
+  py::class_<TauExitPropagator, Propagator>(m, "TauExitPropagator")
+      .def(py::init<const Earth&, const std::shared_ptr<TauExitTable>&>(),
+           py::arg("earth"),
+           py::arg("table"),
+           "Create a propagator that samples exiting taus from tau exit tables.")
+      .def("propagate",
+           py::overload_cast<Source&, Flux&, const Detector&>(&TauExitPropagator::propagate,
+                                                               py::const_),
+           "Propagate a single particle to the detector.")
+      .def("propagate",
+           py::overload_cast<Source&, Flux&, const Detector&, const int>(
+               &Propagator::propagate, py::const_), py::call_guard<py::gil_scoped_release>(),
+           "Propagate several particles to a detector.")
+      .def_property_readonly("table", &TauExitPropagator::get_table,
+                             "The tau exit tables.")
+      .def("__repr__", [](const TauExitPropagator& self) -> std::string {
+        return "TauExitPropagator()";
       });
 }
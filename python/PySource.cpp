@@ -10,13 +10,21 @@ void
 Py_Source(py::module& m) {
 
   // the base FluxModel class
-  py::class_<Source>(m, "Source");
+  py::class_<Source>(m, "Source")
+      .def("solid_angle", &Source::solid_angle,
+           "The solid angle that directions are sampled from [sr].");
 
   // sample points on the spherical cap
   py::class_<SphericalCapSource, Source>(m, "SphericalCapSource")
       .def(py::init<const double, const double, const double>(), py::arg("radius") = 6356.755,
            py::arg("theta") = M_PI / 16., py::arg("center") = (15. / 16.) * M_PI,
            "Sample origin points on a spherical cap.")
+      .def(py::init<const CartesianCoordinate&, const double, const double, const double,
+                    const double>(),
+           py::arg("target"), py::arg("cone"), py::arg("radius") = 6356.755,
+           py::arg("theta") = M_PI / 16., py::arg("center") = (15. / 16.) * M_PI,
+           "Sample origin points on a spherical cap with directions in a cone "
+           "of half-angle `cone` [radians] around the vector to `target`.")
       .def("get_origin", &SphericalCapSource::get_origin,
            "Return a random origin and direction from the cap.")
       .def(
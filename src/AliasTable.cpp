@@ -0,0 +1,74 @@
+#include "apricot/AliasTable.hpp"
+#include "apricot/Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+AliasTable::AliasTable(const std::vector<double>& weights) :
+    probability_(weights.size(), 1.), alias_(weights.size()), weights_(weights) {
+
+  // check that we have a valid distribution
+  if (weights.empty()) {
+    throw std::invalid_argument("AliasTable: needs at least one weight.");
+  }
+  double total{0.};
+  for (const auto w : weights) {
+    if (!(w >= 0.) || !std::isfinite(w)) {
+      throw std::invalid_argument("AliasTable: weights must be non-negative.");
+    }
+    total += w;
+  }
+  if (!(total > 0.)) {
+    throw std::invalid_argument("AliasTable: at least one weight must be positive.");
+  }
+
+  // normalize the weights
+  for (auto& w : weights_) w /= total;
+
+  // scale each weight so that the mean column is exactly full
+  const auto n{weights.size()};
+  std::vector<double> scaled(n);
+  std::vector<std::size_t> small;
+  std::vector<std::size_t> large;
+  for (std::size_t i = 0; i < n; ++i) {
+    alias_[i]  = i;
+    scaled[i]  = weights_[i] * static_cast<double>(n);
+    (scaled[i] < 1. ? small : large).push_back(i);
+  }
+
+  // and fill each underfull column from an overfull one
+  while (!small.empty() && !large.empty()) {
+    const auto s{small.back()};
+    const auto l{large.back()};
+    small.pop_back();
+
+    probability_[s] = scaled[s];
+    alias_[s]       = l;
+
+    // the overfull column loses what it gave away
+    scaled[l] -= 1. - scaled[s];
+    if (scaled[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // any remaining columns are full (up to round-off)
+  for (const auto i : small) probability_[i] = 1.;
+  for (const auto i : large) probability_[i] = 1.;
+}
+
+auto
+AliasTable::sample() const -> std::size_t {
+
+  // a random point in [0, n)
+  const auto x{random::uniform<double>() * static_cast<double>(probability_.size())};
+
+  // the integer part picks the column
+  const auto i{std::min(static_cast<std::size_t>(x), probability_.size() - 1)};
+
+  // and the fractional part chooses the column or its alias
+  return x - static_cast<double>(i) < probability_[i] ? i : alias_[i];
+}
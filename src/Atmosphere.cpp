@@ -0,0 +1,47 @@
+#include "apricot/Atmosphere.hpp"
+#include <cmath>
+
+using namespace apricot;
+
+auto
+Atmosphere::depth(const double altitude) const -> double {
+
+  // there is no atmosphere above the top
+  if (altitude >= TOP) return 0.;
+
+  // split the column into (at most) 1 km intervals
+  const auto nsteps{static_cast<int>(std::ceil(TOP - altitude))};
+  const auto width{(TOP - altitude) / nsteps};
+
+  // the offset of the outer Gauss-Legendre nodes
+  const auto offset{0.5 * width * 0.7745966692414834}; // sqrt(3/5)
+
+  // the column density that we have integrated
+  double column{0.};
+
+  // and integrate each interval with a three-point Gauss-Legendre rule
+  for (int i = 0; i < nsteps; ++i) {
+    const auto center{altitude + (i + 0.5) * width};
+    column += (5. / 9.) * density(center - offset) + (8. / 9.) * density(center) +
+              (5. / 9.) * density(center + offset);
+  }
+
+  // and convert from g/cm^3 * km into g/cm^2
+  return 1e5 * 0.5 * width * column;
+}
+
+auto
+Atmosphere::altitude(const double depth) const -> double {
+
+  // the range of altitudes that we search over [km]
+  double lower{-10.};
+  double upper{TOP};
+
+  // the depth decreases with altitude so we can bisect
+  for (int i = 0; i < 60; ++i) {
+    const auto middle{0.5 * (lower + upper)};
+    (this->depth(middle) > depth ? lower : upper) = middle;
+  }
+
+  return 0.5 * (lower + upper);
+}
@@ -0,0 +1,176 @@
+#include "apricot/fluxes/CompositeFlux.hpp"
+#include "apricot/Random.hpp"
+#include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/particles/Neutrino.hpp"
+#include "apricot/particles/UHECR.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace apricot;
+
+CompositeFlux::CompositeFlux(const std::vector<std::shared_ptr<const Flux>>& fluxes,
+                             const std::vector<double>& fractions)
+    : fluxes_(fluxes) {
+
+  // check that we have a valid mixture
+  if (fluxes.empty() || fluxes.size() != fractions.size()) {
+    throw std::invalid_argument(
+        "CompositeFlux: needs at least one flux and one fraction per flux.");
+  }
+  if (std::any_of(fluxes.begin(), fluxes.end(), [](const auto& flux) { return !flux; })) {
+    throw std::invalid_argument("CompositeFlux: fluxes must not be null.");
+  }
+
+  tables_.emplace_back(fractions);
+}
+
+CompositeFlux::CompositeFlux(const std::shared_ptr<const Flux>& spectrum,
+                             const std::vector<Species>& species,
+                             const std::vector<double>& fractions)
+    : CompositeFlux(spectrum, species, {0.}, {fractions}) {}
+
+CompositeFlux::CompositeFlux(const std::shared_ptr<const Flux>& spectrum,
+                             const std::vector<Species>& species,
+                             const std::vector<LogEnergy>& energies,
+                             const std::vector<std::vector<double>>& fractions)
+    : spectrum_(spectrum), species_(species), energies_(energies) {
+
+  // check that we have a valid composition
+  if (!spectrum) {
+    throw std::invalid_argument("CompositeFlux: the spectrum must not be null.");
+  }
+  if (species.empty() ||
+      std::any_of(species.begin(), species.end(), [](const auto& s) { return !s; })) {
+    throw std::invalid_argument("CompositeFlux: needs at least one species.");
+  }
+  if (energies.empty() || energies.size() != fractions.size()) {
+    throw std::invalid_argument(
+        "CompositeFlux: needs at least one energy and one set of fractions per energy.");
+  }
+  for (std::size_t i = 1; i < energies.size(); ++i) {
+    if (!(energies[i - 1] < energies[i])) {
+      throw std::invalid_argument("CompositeFlux: energies must be strictly increasing.");
+    }
+  }
+
+  // build the alias table at each energy
+  for (const auto& row : fractions) {
+    if (row.size() != species.size()) {
+      throw std::invalid_argument("CompositeFlux: needs one fraction per species at each energy.");
+    }
+    tables_.emplace_back(row);
+  }
+}
+
+auto
+CompositeFlux::neutrinos(const std::shared_ptr<const Flux>& spectrum,
+                         const std::vector<double>& ratios) -> CompositeFlux {
+
+  // one species for each generation
+  std::vector<Species> flavors;
+  for (const auto flavor : {Generation::Electron, Generation::Muon, Generation::Tau}) {
+    flavors.emplace_back(
+        [flavor](const LogEnergy energy) { return Neutrino::from_generation(flavor, energy); });
+  }
+
+  return CompositeFlux(spectrum, flavors, ratios);
+}
+
+auto
+CompositeFlux::species(const ParticleID pdgid) -> Species {
+
+  // switch on the desired particle
+  switch (pdgid) {
+    case PDG::Electron:
+      return [](const LogEnergy energy) { return std::make_unique<Electron>(energy); };
+    case PDG::Muon:
+      return [](const LogEnergy energy) { return std::make_unique<Muon>(energy); };
+    case PDG::Tau:
+      return [](const LogEnergy energy) { return std::make_unique<Tau>(energy); };
+    case PDG::ElectronNeutrino:
+      return [](const LogEnergy energy) { return std::make_unique<ElectronNeutrino>(energy); };
+    case PDG::MuonNeutrino:
+      return [](const LogEnergy energy) { return std::make_unique<MuonNeutrino>(energy); };
+    case PDG::TauNeutrino:
+      return [](const LogEnergy energy) { return std::make_unique<TauNeutrino>(energy); };
+    case PDG::Proton:
+      return [](const LogEnergy energy) { return std::make_unique<Proton>(energy); };
+    case PDG::Helium:
+      return [](const LogEnergy energy) { return std::make_unique<Helium>(energy); };
+    case PDG::Nitrogen:
+      return [](const LogEnergy energy) { return std::make_unique<Nitrogen>(energy); };
+    case PDG::Iron:
+      return [](const LogEnergy energy) { return std::make_unique<Iron>(energy); };
+
+    // when all else fails, throw an exception
+    default:
+      throw std::invalid_argument("CompositeFlux: no species for PDG ID " +
+                                  std::to_string(pdgid) + ".");
+  } // END: switch (pdgid)
+}
+
+auto
+CompositeFlux::get_particle() const -> std::unique_ptr<Particle> {
+
+  // a mixture of fluxes picks a flux and uses its particle
+  if (!spectrum_) {
+    const auto component{tables_.front().sample()};
+    auto particle{fluxes_[component]->get_particle()};
+
+    // and divides its weight by the probability of this flux
+    particle->set_weight(particle->get_weight() / tables_.front().probability(component));
+
+    return particle;
+  }
+
+  // otherwise, sample an energy (and weight) from the spectrum
+  const auto primary{spectrum_->get_particle()};
+  const auto energy{primary->get_energy()};
+
+  // and create the species that we pick at this energy
+  const auto component{table(energy).sample()};
+  auto particle{species_[component](energy)};
+
+  // whose weight includes the probability of this species at this energy
+  particle->set_weight(primary->get_weight() / fraction(component, energy));
+
+  return particle;
+}
+
+auto
+CompositeFlux::locate(const LogEnergy energy) const -> std::pair<std::size_t, double> {
+
+  // the composition is constant beyond the tabulated energies
+  if (energies_.size() < 2 || !(energy > energies_.front())) return {0, 0.};
+  if (!(energy < energies_.back())) return {energies_.size() - 2, 1.};
+
+  // find the interval that contains this energy
+  const auto above{static_cast<std::size_t>(
+      std::upper_bound(energies_.begin(), energies_.end(), energy) - energies_.begin())};
+  const auto i{std::min(above - 1, energies_.size() - 2)};
+
+  return {i, (energy - energies_[i]) / (energies_[i + 1] - energies_[i])};
+}
+
+auto
+CompositeFlux::table(const LogEnergy energy) const -> const AliasTable& {
+
+  // find where we are between the tabulated energies
+  const auto [i, f]{locate(energy)};
+
+  // and pick the nearer table with the larger probability
+  if (tables_.size() < 2) return tables_.front();
+  return random::uniform<double>() < f ? tables_[i + 1] : tables_[i];
+}
+
+auto
+CompositeFlux::fraction(const std::size_t component, const LogEnergy energy) const -> double {
+
+  // a mixture of fluxes has a single composition
+  if (tables_.size() < 2) return tables_.front().probability(component);
+
+  // otherwise, interpolate the composition at this energy
+  const auto [i, f]{locate(energy)};
+  return (1. - f) * tables_[i].probability(component) + f * tables_[i + 1].probability(component);
+}
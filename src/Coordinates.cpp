@@ -0,0 +1,207 @@
+#include "apricot/Coordinates.hpp"
+#include <cmath>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The rotation from geocentric into a local East-North-Up frame.
+   *
+   * The rows of the returned matrix are the east, north, and up
+   * unit vectors at a given latitude and longitude.
+   *
+   * @param latitude    The latitude of the frame [radians].
+   * @param longitude   The longitude of the frame [radians].
+   */
+  auto
+  enu_rotation(const double latitude, const double longitude) -> Eigen::Matrix3d {
+
+    // the trig functions that we need
+    const auto sinlat{std::sin(latitude)};
+    const auto coslat{std::cos(latitude)};
+    const auto sinlon{std::sin(longitude)};
+    const auto coslon{std::cos(longitude)};
+
+    // and construct the rotation matrix - the rows are east, north, and up
+    Eigen::Matrix3d rotation;
+    rotation << -sinlon, coslon, 0., -sinlat * coslon, -sinlat * sinlon, coslat,
+        coslat * coslon, coslat * sinlon, sinlat;
+
+    return rotation;
+  }
+
+} // namespace
+
+auto
+apricot::to_spherical_batch(const CoordinatesView& locations) -> SphericalCoordinates {
+
+  // create the output array
+  SphericalCoordinates out(locations.rows(), 3);
+
+  // loop over every location
+  for (Eigen::Index i = 0; i < locations.rows(); ++i) {
+
+    // extract out the components
+    const auto x{locations(i, 0)};
+    const auto y{locations(i, 1)};
+    const auto z{locations(i, 2)};
+
+    // and compute (r, theta, phi)
+    const auto r{std::sqrt(x * x + y * y + z * z)};
+    out(i, 0) = r;
+    out(i, 1) = std::acos(z / r);
+    out(i, 2) = std::atan2(y, x);
+  }
+
+  return out;
+}
+
+auto
+apricot::to_cartesian_batch(const CoordinatesView& locations) -> CartesianCoordinates {
+
+  // create the output array
+  CartesianCoordinates out(locations.rows(), 3);
+
+  // loop over every location
+  for (Eigen::Index i = 0; i < locations.rows(); ++i) {
+
+    // get a named reference to each component
+    const auto radius{locations(i, 0)};
+    const auto theta{locations(i, 1)};
+    const auto phi{locations(i, 2)};
+
+    // and convert to (x, y, z)
+    const auto rho{radius * std::sin(theta)};
+    out(i, 0) = rho * std::cos(phi);
+    out(i, 1) = rho * std::sin(phi);
+    out(i, 2) = radius * std::cos(theta);
+  }
+
+  return out;
+}
+
+auto
+apricot::to_geodetic(const CoordinatesView& locations) -> GeodeticCoordinates {
+
+  // the ellipsoid constants that we need
+  constexpr auto a2{wgs84::A * wgs84::A};
+  constexpr auto b2{wgs84::B * wgs84::B};
+  constexpr auto e2{wgs84::E2};
+  constexpr auto e4{e2 * e2};
+  constexpr auto ep2{(a2 - b2) / b2}; // the second eccentricity squared
+
+  // create the output array
+  GeodeticCoordinates out(locations.rows(), 3);
+
+  // loop over every location
+  for (Eigen::Index i = 0; i < locations.rows(); ++i) {
+
+    // extract out the components
+    const auto x{locations(i, 0)};
+    const auto y{locations(i, 1)};
+    const auto z{locations(i, 2)};
+
+    // the distance from the polar axis
+    const auto p2{x * x + y * y};
+    const auto p{std::sqrt(p2)};
+    const auto z2{z * z};
+
+    // and the closed-form solution of Heikkinen (1982)
+    const auto F{54. * b2 * z2};
+    const auto G{p2 + (1. - e2) * z2 - e2 * (a2 - b2)};
+    const auto c{e4 * F * p2 / (G * G * G)};
+    const auto s{std::cbrt(1. + c + std::sqrt(c * c + 2. * c))};
+    const auto k{s + 1. + 1. / s};
+    const auto P{F / (3. * k * k * G * G)};
+    const auto Q{std::sqrt(1. + 2. * e4 * P)};
+    const auto r0{-P * e2 * p / (1. + Q) +
+                  std::sqrt(0.5 * a2 * (1. + 1. / Q) - P * (1. - e2) * z2 / (Q * (1. + Q)) -
+                            0.5 * P * p2)};
+    const auto dp{p - e2 * r0};
+    const auto U{std::sqrt(dp * dp + z2)};
+    const auto V{std::sqrt(dp * dp + (1. - e2) * z2)};
+    const auto z0{b2 * z / (wgs84::A * V)};
+
+    // and save (latitude, longitude, height)
+    out(i, 0) = rad_to_deg(std::atan2(z + ep2 * z0, p));
+    out(i, 1) = rad_to_deg(std::atan2(y, x));
+    out(i, 2) = U * (1. - b2 / (wgs84::A * V));
+  }
+
+  return out;
+}
+
+auto
+apricot::from_geodetic(const CoordinatesView& locations) -> CartesianCoordinates {
+
+  // create the output array
+  CartesianCoordinates out(locations.rows(), 3);
+
+  // loop over every location
+  for (Eigen::Index i = 0; i < locations.rows(); ++i) {
+
+    // get the latitude and longitude in radians
+    const auto latitude{deg_to_rad(locations(i, 0))};
+    const auto longitude{deg_to_rad(locations(i, 1))};
+    const auto height{locations(i, 2)};
+
+    // the trig functions that we need
+    const auto sinlat{std::sin(latitude)};
+    const auto coslat{std::cos(latitude)};
+
+    // the prime vertical radius of curvature
+    const auto N{wgs84::A / std::sqrt(1. - wgs84::E2 * sinlat * sinlat)};
+
+    // and convert to (x, y, z)
+    out(i, 0) = (N + height) * coslat * std::cos(longitude);
+    out(i, 1) = (N + height) * coslat * std::sin(longitude);
+    out(i, 2) = (N * (1. - wgs84::E2) + height) * sinlat;
+  }
+
+  return out;
+}
+
+auto
+apricot::to_enu(const CoordinatesView& locations,
+                const CartesianCoordinate& origin,
+                const bool geodetic) -> CartesianCoordinates {
+
+  // the longitude of the origin is the same in both cases
+  const auto longitude{std::atan2(origin(1), origin(0))};
+
+  // the latitude of the origin - either geodetic or geocentric
+  const auto latitude{geodetic
+                          ? deg_to_rad(to_geodetic(origin.transpose())(0, 0))
+                          : std::asin(origin(2) / origin.norm())};
+
+  // the rotation into the local frame
+  const auto rotation{enu_rotation(latitude, longitude)};
+
+  // and rotate the offset of every location from the origin
+  return (locations.rowwise() - origin.transpose()) * rotation.transpose();
+}
+
+auto
+apricot::payload_view(const CoordinatesView& locations, const CartesianCoordinate& payload)
+    -> Eigen::Matrix<double, Eigen::Dynamic, 2> {
+
+  // get the locations in the local frame of the payload
+  const auto enu{to_enu(locations, payload, false)};
+
+  // create the output array
+  Eigen::Matrix<double, Eigen::Dynamic, 2> out(locations.rows(), 2);
+
+  // loop over every location
+  for (Eigen::Index i = 0; i < enu.rows(); ++i) {
+
+    // the horizontal distance to this location
+    const auto horizontal{std::hypot(enu(i, 0), enu(i, 1))};
+
+    // and compute the elevation and azimuth
+    out(i, 0) = rad_to_deg(std::atan2(enu(i, 2), horizontal));
+    out(i, 1) = rad_to_deg(std::atan2(enu(i, 0), enu(i, 1)));
+  }
+
+  return out;
+}
@@ -0,0 +1,36 @@
+#include "apricot/DensityModel.hpp"
+#include <stdexcept>
+
+using namespace apricot;
+
+auto
+apricot::material_from_string(const std::string& name) -> MaterialID {
+
+  if (name == "vacuum") {
+    return materials::Vacuum;
+  } else if (name == "core") {
+    return materials::Core;
+  } else if (name == "mantle") {
+    return materials::Mantle;
+  } else if (name == "rock" || name == "crust") {
+    return materials::Rock;
+  } else if (name == "water" || name == "ocean") {
+    return materials::Water;
+  } else if (name == "ice") {
+    return materials::Ice;
+  } else if (name == "firn") {
+    return materials::Firn;
+  } else if (name == "sediment") {
+    return materials::Sediment;
+  } else if (name == "air") {
+    return materials::Air;
+  } else {
+    throw std::invalid_argument("Unknown material '" + name + "'.");
+  }
+}
+
+auto
+DensityModel::column(const double r0, const double r1, const double Rearth) const
+    -> double {
+  return integrate([&](const double r) { return this->density(r, Rearth); }, r0, r1);
+}
@@ -5,6 +5,16 @@ using namespace apricot;
 
 auto
 Earth::density(const CartesianCoordinate& location) const -> double {
+  return density<Atmosphere>(location, this->radius(location));
+}
+
+auto
+Earth::material(const CartesianCoordinate& location) const -> MaterialID {
+
+  // a voxel grid replaces the radial model inside its region
+  if (voxels_ != nullptr && voxels_->contains(location)) {
+    return voxels_->material(location);
+  }
 
   // the radius of the Earth at this location
   const auto Rearth{this->radius(location)};
@@ -12,30 +22,31 @@ Earth::density(const CartesianCoordinate& location) const -> double {
   // the radius of the current point
   const auto radius{location.norm()};
 
-  // if the location is less than the Earth radius
-  if ( radius < Rearth ) {
-    return PREM::density(radius, Rearth);
+  // if we are above the surface, we are in air (or space)
+  if (radius >= Rearth) {
+    return (atmosphere_ != nullptr) ? materials::Air : materials::Vacuum;
   }
-  else { // we are not in the bulk of the Earth
-
-    // check if we have an atmosphere model
-    if (atmosphere_ != nullptr) {
-
-      // compute the altitude of this point
-      const auto altitude{radius - Rearth};
-
-      // return the density of the atmosphere
-      return atmosphere_->density(altitude);
-    }
 
-    // with no atmosphere model, assume zero density.
-    return 0.;
-    
-  } // END: else
+  // use a custom density model if we have one
+  if (interior_ != nullptr) {
+    return interior_->material(radius, Rearth);
+  }
 
+  // otherwise default to PREM
+  return PREM::material(radius, Rearth);
 }
 
 auto
 Earth::add(const std::shared_ptr<Atmosphere>& atmosphere) -> void {
   this->atmosphere_ = std::static_pointer_cast<Atmosphere>(atmosphere);
 }
+
+auto
+Earth::add(const std::shared_ptr<DensityModel>& interior) -> void {
+  this->interior_ = interior;
+}
+
+auto
+Earth::add(const std::shared_ptr<VoxelDensity>& voxels) -> void {
+  this->voxels_ = voxels;
+}
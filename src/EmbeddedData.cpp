@@ -0,0 +1,37 @@
+#include "apricot/EmbeddedData.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+using namespace apricot::data;
+
+namespace {
+
+  // the tables generated by cmake/EmbedData.cmake
+#include "EmbeddedTables.inc"
+
+} // namespace
+
+auto
+apricot::data::find_table(const std::string& name) -> std::optional<EmbeddedTable> {
+
+  // look for a table with this name
+  const auto table{std::find_if(EMBEDDED.begin(), EMBEDDED.end(), [&](const auto& entry) {
+    return std::strcmp(entry.name, name.c_str()) == 0;
+  })};
+
+  // and return it if we found it
+  if (table == EMBEDDED.end()) return std::nullopt;
+  return *table;
+}
+
+auto
+apricot::data::table_names() -> std::vector<std::string> {
+
+  // the names of each table
+  std::vector<std::string> names;
+  for (const auto& table : EMBEDDED) names.emplace_back(table.name);
+
+  return names;
+}
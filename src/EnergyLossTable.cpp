@@ -0,0 +1,301 @@
+#include "apricot/particles/EnergyLossTable.hpp"
+#include "apricot/Particle.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The spacing of the energy grid [log10(eV)].
+   */
+  constexpr double STEP{(EnergyLossTable::EMAX - EnergyLossTable::EMIN) /
+                        EnergyLossTable::NBINS};
+
+  /**
+   * The coefficients of a quadratic in log10(E/GeV) - 9 [1e-6 cm^2/g].
+   */
+  using Coefficients = std::array<double, 3>;
+
+  /**
+   * The bremsstrahlung + pair production coefficients of a lepton.
+   *
+   * @param id    The PDG ID of the lepton.
+   */
+  auto
+  electromagnetic(const ParticleID id) -> Coefficients {
+    switch (std::abs(id)) {
+    case PDG::Muon:
+      return {{3.0, 0.10, 0.}};
+    case PDG::Tau:
+      return {{0.35, 0.030, 0.}};
+    default:
+      throw std::invalid_argument("EnergyLossTable: only muons and taus are supported.");
+    } // END: switch (id)
+  }
+
+  /**
+   * The photonuclear coefficients of a lepton.
+   *
+   * @param id       The PDG ID of the lepton.
+   * @param model    The photonuclear energy loss model.
+   */
+  auto
+  photonuclear(const ParticleID id, const LeptonEnergyLossModel model) -> Coefficients {
+
+    // the photonuclear loss of muons is larger than for taus
+    const bool muon{std::abs(id) == PDG::Muon};
+
+    switch (model) {
+    case LeptonEnergyLossModel::BDHM:
+      return muon ? Coefficients{{0.45, 0.12, 0.012}} : Coefficients{{0.37, 0.080, 0.008}};
+    case LeptonEnergyLossModel::Soyez:
+      return muon ? Coefficients{{0.48, 0.14, 0.015}} : Coefficients{{0.40, 0.095, 0.010}};
+    case LeptonEnergyLossModel::BS:
+      return muon ? Coefficients{{0.42, 0.06, 0.}} : Coefficients{{0.33, 0.040, 0.}};
+    case LeptonEnergyLossModel::ALLM:
+    default:
+      return muon ? Coefficients{{0.52, 0.18, 0.022}} : Coefficients{{0.45, 0.120, 0.012}};
+    } // END: switch (model)
+  }
+
+  /**
+   * Evaluate a fit at x = log10(E/GeV) - 9 [cm^2/g].
+   *
+   * A quadratic fit is held constant below its minimum so that
+   * beta(E) never grows towards lower energies.
+   *
+   * @param fit    The coefficients of the fit.
+   * @param x      The (clamped) energy of the fit.
+   */
+  auto
+  evaluate(const Coefficients& fit, const double x) -> double {
+    const auto y{fit[2] > 0. ? std::max(x, -fit[1] / (2. * fit[2])) : x};
+    return 1e-6 * (fit[0] + fit[1] * y + fit[2] * y * y);
+  }
+
+  /**
+   * The fractional index of an energy on the grid, clamped to the table.
+   *
+   * @param energy    The energy [log10(eV)].
+   */
+  auto
+  index(const LogEnergy energy) -> std::pair<int, double> {
+    const auto x{std::clamp((energy - EnergyLossTable::EMIN) / STEP,
+                            0.,
+                            1. * EnergyLossTable::NBINS)};
+    const auto i{std::min(static_cast<int>(x), EnergyLossTable::NBINS - 1)};
+    return {i, x - i};
+  }
+
+} // namespace
+
+EnergyLossTable::EnergyLossTable(const ParticleID id, const LeptonEnergyLossModel model) :
+    alpha_(ALPHA) {
+
+  // evaluate beta(E) at every node
+  std::vector<double> betas(NBINS + 1);
+  for (int i = 0; i <= NBINS; ++i) {
+    const auto [em, nuclear]{contributions(id, model, EMIN + i * STEP)};
+    betas[i] = em + nuclear;
+  }
+
+  // and build the range table
+  initialize(std::move(betas));
+}
+
+EnergyLossTable::EnergyLossTable(const std::string& filename, const double alpha) :
+    alpha_(alpha) {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open energy loss file '" + filename + "'.");
+  }
+
+  // the energies and betas in the file
+  std::vector<double> energies;
+  std::vector<double> values;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // and read the values on this row
+    std::istringstream row{line};
+    double energy;
+    double beta;
+
+    // skip any empty lines
+    if (!(row >> energy)) continue;
+
+    // a message prefix for any errors
+    const auto where{filename + ":" + std::to_string(lineno) + ": "};
+
+    // check that we have a valid row
+    if (!(row >> beta) || beta <= 0.) {
+      throw std::runtime_error(where + "expected '<log10(E/eV)> <beta [cm^2/g]>'.");
+    }
+    if (!energies.empty() && energy <= energies.back()) {
+      throw std::runtime_error(where + "energies must be increasing.");
+    }
+
+    energies.push_back(energy);
+    values.push_back(beta);
+  }
+
+  // we need at least one point
+  if (energies.empty()) {
+    throw std::runtime_error("No energy loss coefficients found in '" + filename + "'.");
+  }
+
+  // interpolate beta(E) onto the grid - constant beyond the ends
+  std::vector<double> betas(NBINS + 1);
+  for (int i = 0; i <= NBINS; ++i) {
+
+    // the energy of this node
+    const auto energy{EMIN + i * STEP};
+
+    // the first point above this energy
+    const auto upper{std::upper_bound(energies.begin(), energies.end(), energy)};
+    const auto j{static_cast<std::size_t>(upper - energies.begin())};
+
+    // and interpolate between the two points around it
+    if (j == 0) {
+      betas[i] = values.front();
+    } else if (j == energies.size()) {
+      betas[i] = values.back();
+    } else {
+      const auto f{(energy - energies[j - 1]) / (energies[j] - energies[j - 1])};
+      betas[i] = values[j - 1] + f * (values[j] - values[j - 1]);
+    }
+  }
+
+  // and build the range table
+  initialize(std::move(betas));
+}
+
+EnergyLossTable::EnergyLossTable(std::vector<double> betas, const double alpha) :
+    alpha_(alpha) {
+
+  // check that we have one beta per node
+  if (betas.size() != static_cast<std::size_t>(NBINS + 1)) {
+    throw std::invalid_argument("EnergyLossTable: there must be one beta per node of the grid.");
+  }
+
+  // and build the range table
+  initialize(std::move(betas));
+}
+
+auto
+EnergyLossTable::contributions(const ParticleID id,
+                               const LeptonEnergyLossModel model,
+                               const LogEnergy energy) -> std::pair<double, double> {
+
+  // the coefficients of this lepton and model
+  const auto em{electromagnetic(id)};
+  const auto nuclear{photonuclear(id, model)};
+
+  // the fits are only valid from 1e3 to 1e13 GeV
+  const auto x{std::clamp(energy - 9., 3., 13.) - 9.};
+
+  // and evaluate the two contributions
+  return {evaluate(em, x), evaluate(nuclear, x)};
+}
+
+auto
+EnergyLossTable::initialize(std::vector<double> betas) -> void {
+
+  // save the coefficients
+  betas_ = std::move(betas);
+
+  // the rate of change of the range with log10(E) - dX/du = ln(10) E / (alpha + beta E)
+  const auto rate{[&](const double energy, const double beta) {
+    const auto E{std::pow(10., energy)};
+    return std::log(10.) * E / (alpha_ + beta * E);
+  }};
+
+  // and integrate the range up from EMIN with Simpson's rule
+  ranges_.assign(NBINS + 1, 0.);
+  for (int i = 1; i <= NBINS; ++i) {
+    const auto lower{EMIN + (i - 1) * STEP};
+    ranges_[i] = ranges_[i - 1] + (STEP / 6.) * (rate(lower, betas_[i - 1]) +
+                                                 4. * rate(lower + 0.5 * STEP,
+                                                           0.5 * (betas_[i - 1] + betas_[i])) +
+                                                 rate(lower + STEP, betas_[i]));
+  }
+}
+
+auto
+EnergyLossTable::get(const ParticleID id, const LeptonEnergyLossModel model)
+    -> const EnergyLossTable& {
+
+  // the models in the order of the enum
+  constexpr std::array<LeptonEnergyLossModel, 4> models{{LeptonEnergyLossModel::BDHM,
+                                                         LeptonEnergyLossModel::Soyez,
+                                                         LeptonEnergyLossModel::ALLM,
+                                                         LeptonEnergyLossModel::BS}};
+
+  // build every table once - the muons and then the taus
+  static const auto tables{[&]() {
+    std::vector<EnergyLossTable> built;
+    for (const auto lepton : {PDG::Muon, PDG::Tau}) {
+      for (const auto m : models) built.emplace_back(lepton, m);
+    }
+    return built;
+  }()};
+
+  // check that we have a supported lepton
+  if (std::abs(id) != PDG::Muon && std::abs(id) != PDG::Tau) {
+    throw std::invalid_argument("EnergyLossTable: only muons and taus are supported.");
+  }
+
+  // and return the table for this lepton and model
+  return tables[(std::abs(id) == PDG::Tau ? models.size() : 0) +
+                static_cast<std::size_t>(model)];
+}
+
+auto
+EnergyLossTable::beta(const LogEnergy energy) const -> double {
+  const auto [i, f]{index(energy)};
+  return betas_[i] + f * (betas_[i + 1] - betas_[i]);
+}
+
+auto
+EnergyLossTable::range(const LogEnergy energy) const -> double {
+  const auto [i, f]{index(energy)};
+  return ranges_[i] + f * (ranges_[i + 1] - ranges_[i]);
+}
+
+auto
+EnergyLossTable::energy(const LogEnergy energy, const double grammage) const -> LogEnergy {
+
+  // the range that remains after crossing this grammage
+  const auto remaining{range(energy) - grammage};
+
+  // if this is negative, the lepton has ranged out
+  if (remaining <= 0.) return EMIN;
+
+  // find the first node with a larger range
+  const auto upper{std::upper_bound(ranges_.begin(), ranges_.end(), remaining)};
+  const auto i{std::clamp(static_cast<int>(upper - ranges_.begin()), 1, NBINS)};
+
+  // and invert the linear interpolation of the range
+  const auto f{(remaining - ranges_[i - 1]) / (ranges_[i] - ranges_[i - 1])};
+  return EMIN + (i - 1 + std::min(f, 1.)) * STEP;
+}
@@ -4,6 +4,11 @@
 using namespace apricot;
 
 auto
-ExponentialAtmosphere::density(const double altitude) const -> double {
-  return rho0_ * exp ( (- g * M * altitude) / (R * T_) );
+ExponentialAtmosphere::depth(const double altitude) const -> double {
+  return 1e5 * rho0_ * scale_ * std::exp(-altitude / scale_);
+}
+
+auto
+ExponentialAtmosphere::altitude(const double depth) const -> double {
+  return -scale_ * std::log(depth / (1e5 * rho0_ * scale_));
 }
@@ -0,0 +1,99 @@
+#include "apricot/earth/FirnDensity.hpp"
+#include "apricot/earth/PREM.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+FirnDensity::FirnDensity(const double thickness,
+                         const double surface,
+                         const double scale,
+                         const double ice,
+                         const std::shared_ptr<DensityModel>& background) :
+    thickness_(thickness),
+    surface_(surface),
+    scale_(scale),
+    ice_(ice),
+    background_(background) {
+
+  // check that the profile is physical
+  if (thickness_ < 0. || scale_ <= 0. || surface_ <= 0. || ice_ < surface_) {
+    throw std::invalid_argument("FirnDensity: invalid firn profile parameters.");
+  }
+}
+
+auto
+FirnDensity::density(const double radius, const double Rearth) const -> double {
+
+  // the depth below the surface
+  const auto depth{Rearth - radius};
+
+  // outside of the ice sheet, use the background model
+  if (depth < 0. || depth >= thickness_) return background(radius, Rearth);
+
+  // otherwise, use the exponential firn profile
+  return ice_ - (ice_ - surface_) * std::exp(-depth / scale_);
+}
+
+auto
+FirnDensity::material(const double radius, const double Rearth) const -> MaterialID {
+
+  // the depth below the surface
+  const auto depth{Rearth - radius};
+
+  // outside of the ice sheet, use the background model
+  if (depth < 0. || depth >= thickness_) {
+    return background_ != nullptr ? background_->material(radius, Rearth)
+                                  : PREM::material(radius, Rearth);
+  }
+
+  // firn turns into ice at the pore close-off density
+  return density(radius, Rearth) < CLOSEOFF ? materials::Firn : materials::Ice;
+}
+
+auto
+FirnDensity::column(const double r0, const double r1, const double Rearth) const -> double {
+
+  // integrate from the lower to the upper radius
+  if (r1 < r0) return -column(r1, r0, Rearth);
+
+  // the radius at the base and surface of the ice sheet
+  const auto base{Rearth - thickness_};
+
+  // the part of [r0, r1] that is inside the ice sheet
+  const auto lower{std::clamp(r0, base, Rearth)};
+  const auto upper{std::clamp(r1, base, Rearth)};
+
+  // the column density of the background model below and above the ice
+  const auto below{r0 < base ? background_column(r0, std::min(r1, base), Rearth) : 0.};
+  const auto above{r1 > Rearth ? background_column(std::max(r0, Rearth), r1, Rearth) : 0.};
+
+  // the depth range of the ice that we cross
+  const auto shallow{Rearth - upper};
+  const auto deep{Rearth - lower};
+
+  // and the exact integral of the firn profile over this depth
+  const auto ice{ice_ * (deep - shallow) - (ice_ - surface_) * scale_ *
+                                               (std::exp(-shallow / scale_) -
+                                                std::exp(-deep / scale_))};
+
+  return below + ice + above;
+}
+
+auto
+FirnDensity::background(const double radius, const double Rearth) const -> double {
+  return background_ != nullptr ? background_->density(radius, Rearth)
+                                : PREM::density(radius, Rearth);
+}
+
+auto
+FirnDensity::background_column(const double r0, const double r1, const double Rearth) const
+    -> double {
+
+  // use the column density of the background model if we have one
+  if (background_ != nullptr) return background_->column(r0, r1, Rearth);
+
+  // otherwise use the exact PREM column density
+  return PREM::column(r0, r1, Rearth);
+}
@@ -2,6 +2,8 @@
 #include "Utils.hpp"
 #include "apricot/Random.hpp"
 #include "apricot/earth/SphericalEarth.hpp"
+#include <Eigen/Geometry>
+#include <algorithm>
 #include <stdexcept>
 
 using namespace apricot;
@@ -43,6 +45,25 @@ apricot::random_cap_point(const double mintheta,
   return to_cartesian(spherical);
 }
 
+auto
+apricot::random_cone_point(const Vector& axis, const double angle) -> Vector {
+
+  // the axis of the cone and two unit vectors perpendicular to it
+  const Vector z{axis.normalized()};
+  const Vector x{z.unitOrthogonal()};
+  const Vector y{z.cross(x)};
+
+  // choose cos(theta) uniformly so that we are uniform in solid angle
+  const double costheta{random::uniform(cos(angle), 1.)};
+  const double sintheta{sqrt(std::max(0., 1. - costheta * costheta))};
+
+  // and choose phi uniformly around the axis
+  const double phi{random::uniform(0., 2 * M_PI)};
+
+  // and construct the vector from the cone axis
+  return costheta * z + sintheta * (cos(phi) * x + sin(phi) * y);
+}
+
 auto
 apricot::spherical_cap_area(const double theta, const double radius) -> double {
   return 2*M_PI*radius*radius*(1. - cos(theta));
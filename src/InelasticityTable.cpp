@@ -0,0 +1,166 @@
+#include "apricot/particles/InelasticityTable.hpp"
+#include "apricot/Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The number of intervals used to integrate each distribution.
+   */
+  constexpr int NSTEPS{4000};
+
+  /**
+   * The smallest non-zero y used to integrate each distribution.
+   */
+  constexpr double YMIN{1e-8};
+
+  /**
+   * The offset, c, of dN/dy ~ 1 / (y + c) with a given mean.
+   *
+   * The mean, 1 / ln(1 + 1/c) - c, increases from 0 to 1/2 with c.
+   *
+   * @param mean    The mean inelasticity.
+   */
+  auto
+  offset(const double mean) -> double {
+
+    // the mean of this distribution for an offset
+    const auto average{[](const double c) { return 1. / std::log1p(1. / c) - c; }};
+
+    // keep the mean within the range of this distribution
+    const auto target{std::clamp(mean, 1e-3, 0.499)};
+
+    // and bisect in log(c)
+    double lower{-30.};
+    double upper{15.};
+    for (int i = 0; i < 100; ++i) {
+      const auto middle{0.5 * (lower + upper)};
+      (average(std::exp(middle)) < target ? lower : upper) = middle;
+    }
+
+    return std::exp(0.5 * (lower + upper));
+  }
+
+} // namespace
+
+InelasticityTable::InelasticityTable(const Distribution& distribution) {
+
+  // the spacing of the energy grid
+  constexpr double step{(EMAX - EMIN) / NENERGIES};
+
+  // the integration nodes - logarithmic in y down to YMIN
+  std::vector<double> y(NSTEPS + 2, 0.);
+  for (int k = 0; k <= NSTEPS; ++k) {
+    y[k + 1] = YMIN * std::pow(1. / YMIN, static_cast<double>(k) / NSTEPS);
+  }
+
+  // the cumulative distribution at each node
+  std::vector<double> cdf(y.size(), 0.);
+
+  // build the inverse CDF at every energy node
+  quantiles_.resize(static_cast<std::size_t>(NENERGIES + 1) * (NQUANTILES + 1));
+  for (int i = 0; i <= NENERGIES; ++i) {
+
+    // the energy of this node
+    const auto energy{EMIN + i * step};
+
+    // integrate the distribution with the trapezoid rule
+    auto previous{distribution(energy, y[0])};
+    for (std::size_t k = 1; k < y.size(); ++k) {
+      const auto current{distribution(energy, y[k])};
+      cdf[k] = cdf[k - 1] + 0.5 * (previous + current) * (y[k] - y[k - 1]);
+      previous = current;
+    }
+
+    // we need a normalizable distribution
+    const auto total{cdf.back()};
+    if (!(total > 0.) || !std::isfinite(total)) {
+      throw std::invalid_argument("InelasticityTable: the distribution must be positive.");
+    }
+
+    // and invert the CDF at each quantile
+    std::size_t k{1};
+    for (int j = 0; j <= NQUANTILES; ++j) {
+
+      // the cumulative probability of this quantile
+      const auto target{total * j / NQUANTILES};
+
+      // find the interval containing this quantile
+      while (k + 1 < cdf.size() && cdf[k] < target) ++k;
+
+      // and interpolate linearly within it
+      const auto width{cdf[k] - cdf[k - 1]};
+      const auto fraction{width > 0. ? std::clamp((target - cdf[k - 1]) / width, 0., 1.) : 0.};
+      quantiles_[i * (NQUANTILES + 1) + j] = y[k - 1] + fraction * (y[k] - y[k - 1]);
+    }
+
+  } // END: for (int i = 0...
+}
+
+InelasticityTable::InelasticityTable(const NeutrinoYFactorModel model) :
+    InelasticityTable([model, last = -1., c = 1.](const LogEnergy energy,
+                                                  const double y) mutable {
+      // the offset only changes with the energy
+      if (std::abs(energy - last) > 0.) {
+        last = energy;
+        c    = offset(y_factor(energy, model));
+      }
+      return 1. / (y + c);
+    }) {}
+
+auto
+InelasticityTable::get(const NeutrinoYFactorModel model) -> const InelasticityTable& {
+
+  // one table per model - these are only built once
+  static const InelasticityTable bdhm{NeutrinoYFactorModel::BDHM};
+  static const InelasticityTable soyez{NeutrinoYFactorModel::Soyez};
+  static const InelasticityTable allm{NeutrinoYFactorModel::ALLM};
+
+  switch (model) {
+  case NeutrinoYFactorModel::BDHM:
+    return bdhm;
+  case NeutrinoYFactorModel::Soyez:
+    return soyez;
+  case NeutrinoYFactorModel::ALLM:
+  default:
+    return allm;
+  } // END: switch (model)
+}
+
+auto
+InelasticityTable::sample(const LogEnergy energy) const -> double {
+
+  // the fractional index of this energy
+  const auto x{std::clamp((energy - EMIN) * (NENERGIES / (EMAX - EMIN)), 0., 1. * NENERGIES)};
+  const auto i{std::min(static_cast<int>(x), NENERGIES - 1)};
+
+  // pick one of the two nodes with the interpolation weight
+  const auto node{random::uniform<double>() < x - i ? i + 1 : i};
+
+  // and sample its inverse CDF
+  return quantile(node, random::uniform<double>());
+}
+
+auto
+InelasticityTable::mean(const LogEnergy energy) const -> double {
+
+  // the fractional index of this energy
+  const auto x{std::clamp((energy - EMIN) * (NENERGIES / (EMAX - EMIN)), 0., 1. * NENERGIES)};
+  const auto i{std::min(static_cast<int>(x), NENERGIES - 1)};
+
+  // the mean of the inverse CDF of an energy node
+  const auto average{[&](const int node) {
+    double sum{0.};
+    for (int j = 1; j <= NQUANTILES; ++j) {
+      sum += 0.5 * (quantile(node, (j - 1.) / NQUANTILES) + quantile(node, 1. * j / NQUANTILES));
+    }
+    return sum / NQUANTILES;
+  }};
+
+  // and interpolate between the two nodes
+  return (1. - (x - i)) * average(i) + (x - i) * average(i + 1);
+}
@@ -10,7 +10,8 @@ Interaction::Interaction(const std::unique_ptr<Particle>& particle,
                          const double weight,
                          const double altitude)
     : pdgid_(particle->get_id()), energy_(particle->get_energy()), type_(type),
-      location_(location), direction_(direction), weight_(weight), altitude_(altitude) {}
+      location_(location), direction_(direction), weight_(weight), altitude_(altitude),
+      generation_weight_(particle->get_weight()) {}
 
 Interaction::Interaction(const ParticleID pid,
                          const LogEnergy energy,
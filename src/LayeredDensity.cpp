@@ -0,0 +1,238 @@
+#include "apricot/earth/LayeredDensity.hpp"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace apricot;
+
+LayeredDensity::LayeredDensity(const std::vector<Layer>& layers, const double reference) {
+  compile(layers, reference);
+}
+
+LayeredDensity::LayeredDensity(const std::string& filename) {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open layer file '" + filename + "'.");
+  }
+
+  // the layers that we read from the file
+  std::vector<Layer> layers;
+
+  // the reference radius that the file is specified at
+  double reference{LayeredDensity::REFERENCE};
+
+  // the (radius, density) of the previous `point` row - if any
+  bool in_table{false};
+  double last_radius{0.};
+  double last_density{0.};
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // and read the keyword for this row
+    std::istringstream row{line};
+    std::string keyword;
+
+    // skip any empty lines
+    if (!(row >> keyword)) continue;
+
+    // a message prefix for any errors
+    const auto where{filename + ":" + std::to_string(lineno) + ": "};
+
+    if (keyword == "reference") {
+      if (!(row >> reference) || reference <= 0.) {
+        throw std::runtime_error(where + "invalid reference radius.");
+      }
+    } else if (keyword == "layer") {
+
+      // the outer radius and material of this shell
+      double outer;
+      std::string material;
+      if (!(row >> outer >> material)) {
+        throw std::runtime_error(where + "expected 'layer <radius> <material> <c0> ...'.");
+      }
+
+      // and read up to four coefficients
+      std::array<double, 4> coeffs{{0., 0., 0., 0.}};
+      int ncoeffs{0};
+      while (ncoeffs < 4 && row >> coeffs[ncoeffs]) {
+        ++ncoeffs;
+      }
+      if (ncoeffs == 0) {
+        throw std::runtime_error(where + "a layer needs at least one coefficient.");
+      }
+
+      layers.emplace_back(outer, material_from_string(material), coeffs);
+      in_table = false;
+
+    } else if (keyword == "point") {
+
+      // the radius, material, and density at this point
+      double radius;
+      std::string name;
+      double density;
+      if (!(row >> radius >> name >> density)) {
+        throw std::runtime_error(where + "expected 'point <radius> <material> <density>'.");
+      }
+
+      // get the ID of this material
+      const auto material{material_from_string(name)};
+
+      // the inner edge of the profile is the previous boundary
+      const double inner{layers.empty() ? 0. : layers.back().outer_};
+
+      // convert the (radius, density) into a linear shell in x = r / R
+      if (in_table && radius > last_radius) {
+        const auto slope{reference * (density - last_density) / (radius - last_radius)};
+        const auto intercept{density - slope * (radius / reference)};
+        layers.emplace_back(radius, material, std::array<double, 4>{{intercept, slope, 0., 0.}});
+      } else if (radius > inner) {
+        // the first point of a profile is extended inwards
+        layers.emplace_back(radius, material, std::array<double, 4>{{density, 0., 0., 0.}});
+      }
+
+      // and save this point for the next row
+      in_table     = true;
+      last_radius  = radius;
+      last_density = density;
+
+    } else {
+      throw std::runtime_error(where + "unknown keyword '" + keyword + "'.");
+    }
+
+  } // END: while (std::getline...
+
+  // and compile the layers that we found
+  compile(layers, reference);
+}
+
+auto
+LayeredDensity::compile(const std::vector<Layer>& layers, const double reference) -> void {
+
+  // we need at least one shell
+  if (layers.empty()) {
+    throw std::invalid_argument("A LayeredDensity needs at least one layer.");
+  }
+
+  // reserve the storage for the shells (and the vacuum shell)
+  boundaries_.reserve(layers.size() + 1);
+  coeffs_.reserve(layers.size() + 1);
+  materials_.reserve(layers.size() + 1);
+
+  // and copy the layers into the lookup arrays
+  for (const auto& layer : layers) {
+
+    // the normalized outer radius of this shell
+    const auto x{layer.outer_ / reference};
+
+    // the shells must be strictly increasing in radius
+    if (!boundaries_.empty() && x <= boundaries_.back()) {
+      throw std::invalid_argument("Layers must be given from the center outwards.");
+    }
+
+    boundaries_.push_back(x);
+    coeffs_.push_back(layer.coeffs_);
+    materials_.push_back(layer.material_);
+  }
+
+  // we terminate the shells with an infinite vacuum shell so that
+  // every lookup lands in a valid shell without any bounds checks
+  boundaries_.push_back(std::numeric_limits<double>::infinity());
+  coeffs_.push_back({{0., 0., 0., 0.}});
+  materials_.push_back(materials::Vacuum);
+
+  // and build the guide table - the first shell whose outer
+  // boundary is above the inner edge of each guide bin
+  guide_.resize(NGUIDE);
+  for (std::size_t bin = 0; bin < NGUIDE; ++bin) {
+    const auto x{double(bin) / NGUIDE};
+    guide_[bin] =
+        std::upper_bound(boundaries_.begin(), boundaries_.end(), x) - boundaries_.begin();
+  }
+}
+
+auto
+LayeredDensity::find_shell(const double x) const -> std::size_t {
+  // the guide bin containing x - clamped to the table
+  const auto bin{std::min(std::size_t(std::max(x, 0.) * NGUIDE), NGUIDE - 1)};
+
+  // and walk forward to the first shell whose outer boundary is above x
+  auto shell{guide_[bin]};
+  while (x >= boundaries_[shell]) {
+    ++shell;
+  }
+
+  return shell;
+}
+
+auto
+LayeredDensity::density(const double radius, const double Rearth) const -> double {
+
+  // get dimensionless constant as a function of Earth radius
+  const auto x{radius / Rearth};
+
+  // find the shell that contains this radius - this is the
+  // vacuum shell (all zero coefficients) outside of the Earth
+  const auto& c{coeffs_[find_shell(x)]};
+
+  // and evaluate the cubic with Horner's method
+  return c[0] + x * (c[1] + x * (c[2] + x * c[3]));
+}
+
+auto
+LayeredDensity::material(const double radius, const double Rearth) const -> MaterialID {
+
+  // find the shell (or the vacuum shell) that contains this radius
+  return materials_[find_shell(radius / Rearth)];
+}
+
+auto
+LayeredDensity::column(const double r0, const double r1, const double Rearth) const
+    -> double {
+
+  // integrate from the lower to the upper radius
+  if (r1 < r0) return -column(r1, r0, Rearth);
+
+  // the normalized range that we integrate over
+  const auto x0{r0 / Rearth};
+  const auto x1{r1 / Rearth};
+
+  // the antiderivative of a shell polynomial at x
+  auto antiderivative = [](const std::array<double, 4>& c, const double x) {
+    return x * (c[0] + x * (c[1] / 2. + x * (c[2] / 3. + x * c[3] / 4.)));
+  };
+
+  // the integral in x
+  double total{0.};
+
+  // loop over the shells from the one containing x0
+  for (auto shell = find_shell(x0); shell < size(); ++shell) {
+
+    // the part of this shell that is in the range
+    const auto lower{std::max(x0, shell == 0 ? 0. : boundaries_[shell - 1])};
+    const auto upper{std::min(x1, boundaries_[shell])};
+
+    // if we are past the end of the range, we are done
+    if (upper <= lower) break;
+
+    // and add the exact integral over this part of the shell
+    total += antiderivative(coeffs_[shell], upper) - antiderivative(coeffs_[shell], lower);
+  }
+
+  // and convert back into a radial integral
+  return Rearth * total;
+}
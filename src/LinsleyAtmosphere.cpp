@@ -0,0 +1,116 @@
+#include "apricot/atmospheres/LinsleyAtmosphere.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The parameters of a Linsley atmosphere as tabulated by CORSIKA.
+   */
+  struct LinsleyParameters {
+    LinsleyAtmosphere::Parameters boundaries; ///< The bottom of each layer [km].
+    LinsleyAtmosphere::Parameters a;          ///< The depth offsets [g/cm^2].
+    LinsleyAtmosphere::Parameters b;          ///< The depth scales [g/cm^2].
+    LinsleyAtmosphere::Parameters c;          ///< The scale heights [cm].
+  };
+
+  /**
+   * Get a built-in parameter set by name.
+   *
+   * @param model    The name of the parameter set.
+   */
+  auto
+  parameters(const std::string& model) -> LinsleyParameters {
+
+    if (model == "us-standard") {
+      return {{{0., 4., 10., 40., 100.}},
+              {{-186.555305, -94.919, 0.61289, 0., 0.01128292}},
+              {{1222.6562, 1144.9069, 1305.5948, 540.1778, 1.}},
+              {{994186.38, 878153.55, 636143.04, 772170.16, 1e9}}};
+    } else if (model == "south-pole-january") {
+      return {{{0., 2.67, 5.33, 8., 100.}},
+              {{-113.139, -79.0635, -54.3888, 0., 0.00421033}},
+              {{1133.1, 1101.2, 1085.0, 1098.0, 1.}},
+              {{861730., 826340., 790950., 682800., 2.6798156e9}}};
+    } else if (model == "south-pole-august") {
+      return {{{0., 6.67, 13.33, 20., 100.}},
+              {{-59.0293, -21.5794, -7.14839, 0., 0.000190175}},
+              {{1079.0, 1071.9, 1182.0, 1647.1, 1.}},
+              {{764170., 699910., 635780., 551140., 5.9329575e10}}};
+    } else {
+      throw std::invalid_argument("Unknown Linsley atmosphere '" + model + "'.");
+    }
+  }
+
+} // namespace
+
+LinsleyAtmosphere::LinsleyAtmosphere(const std::string& model) :
+    LinsleyAtmosphere(parameters(model).boundaries,
+                      parameters(model).a,
+                      parameters(model).b,
+                      parameters(model).c) {}
+
+LinsleyAtmosphere::LinsleyAtmosphere(const Parameters& boundaries,
+                                     const Parameters& a,
+                                     const Parameters& b,
+                                     const Parameters& c) :
+    boundaries_(boundaries), a_(a), b_(b) {
+
+  // check that the layers are physical and in order
+  for (int i = 0; i < 5; ++i) {
+    if (b_[i] <= 0. || c[i] <= 0. || (i > 0 && boundaries_[i] <= boundaries_[i - 1])) {
+      throw std::invalid_argument("LinsleyAtmosphere: invalid layer parameters.");
+    }
+
+    // store the scale heights in km
+    c_[i] = 1e-5 * c[i];
+  }
+
+  // the altitude at which the uppermost layer reaches zero depth
+  top_ = a_[4] * c_[4] / b_[4];
+
+  // the top must be inside the uppermost layer
+  if (top_ <= boundaries_[4]) {
+    throw std::invalid_argument("LinsleyAtmosphere: the top is below the uppermost layer.");
+  }
+
+  // and cache the depth at the bottom of each layer
+  for (int i = 0; i < 5; ++i) {
+    depths_[i] = depth(boundaries_[i]);
+  }
+}
+
+auto
+LinsleyAtmosphere::depth(const double altitude) const -> double {
+
+  // above the top, there is no atmosphere
+  if (altitude >= top_) return 0.;
+
+  // the layer containing this altitude
+  const auto i{layer(altitude)};
+
+  // the uppermost layer is linear
+  if (i == 4) return a_[4] - b_[4] * altitude / c_[4];
+
+  // and the lower layers are exponential
+  return a_[i] + b_[i] * std::exp(-altitude / c_[i]);
+}
+
+auto
+LinsleyAtmosphere::altitude(const double depth) const -> double {
+
+  // at zero depth, we are at the top of the atmosphere
+  if (depth <= 0.) return top_;
+
+  // find the layer containing this depth - the depth decreases with altitude
+  int i{4};
+  while (i > 0 && depth > depths_[i]) --i;
+
+  // the uppermost layer is linear
+  if (i == 4) return (a_[4] - depth) * c_[4] / b_[4];
+
+  // and invert the exponential in the lower layers
+  return -c_[i] * std::log((depth - a_[i]) / b_[i]);
+}
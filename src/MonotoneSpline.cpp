@@ -0,0 +1,72 @@
+#include "apricot/MonotoneSpline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+MonotoneSpline::MonotoneSpline(const std::vector<double>& x, const std::vector<double>& y) :
+    x_(x), y_(y), slope_(x.size()) {
+
+  // check that we have a valid set of knots
+  if (x.size() < 2 || x.size() != y.size()) {
+    throw std::invalid_argument("MonotoneSpline: needs at least two knots and one value per knot.");
+  }
+  for (std::size_t i = 1; i < x.size(); ++i) {
+    if (!(x[i - 1] < x[i])) {
+      throw std::invalid_argument("MonotoneSpline: knots must be strictly increasing.");
+    }
+  }
+
+  // the slope of each interval
+  const auto n{x.size()};
+  std::vector<double> secant(n - 1);
+  for (std::size_t i = 0; i + 1 < n; ++i) secant[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+
+  // the initial slope at each knot is the mean of the adjacent secants
+  slope_.front() = secant.front();
+  slope_.back()  = secant.back();
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    slope_[i] = secant[i - 1] * secant[i] > 0. ? 0.5 * (secant[i - 1] + secant[i]) : 0.;
+  }
+
+  // and limit the slopes so that each interval is monotone (Fritsch-Carlson)
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+
+    // flat intervals stay flat
+    if (!(std::abs(secant[i]) > 0.)) {
+      slope_[i]     = 0.;
+      slope_[i + 1] = 0.;
+      continue;
+    }
+
+    // otherwise, keep the slopes inside a circle of radius 3
+    const auto alpha{slope_[i] / secant[i]};
+    const auto beta{slope_[i + 1] / secant[i]};
+    const auto radius{std::hypot(alpha, beta)};
+    if (radius > 3.) {
+      slope_[i]     = 3. * alpha / radius * secant[i];
+      slope_[i + 1] = 3. * beta / radius * secant[i];
+    }
+  }
+}
+
+auto
+MonotoneSpline::operator()(const double x) const -> double {
+
+  // extrapolate linearly beyond the knots
+  if (!(x > x_.front())) return y_.front() + slope_.front() * (x - x_.front());
+  if (!(x < x_.back())) return y_.back() + slope_.back() * (x - x_.back());
+
+  // the interval containing x
+  const auto i{static_cast<std::size_t>(std::upper_bound(x_.begin(), x_.end(), x) - x_.begin()) -
+               1};
+
+  // and evaluate the Hermite basis on this interval
+  const auto h{x_[i + 1] - x_[i]};
+  const auto t{(x - x_[i]) / h};
+  const auto t2{t * t};
+  const auto t3{t2 * t};
+  return (2. * t3 - 3. * t2 + 1.) * y_[i] + (t3 - 2. * t2 + t) * h * slope_[i] +
+         (-2. * t3 + 3. * t2) * y_[i + 1] + (t3 - t2) * h * slope_[i + 1];
+}
@@ -1,16 +1,30 @@
 #include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/PhysicsConfig.hpp"
 #include "apricot/Random.hpp"
+#include "apricot/particles/StochasticLossTable.hpp"
 
 using namespace apricot;
 
 auto Muon::get_interaction() const -> InteractionInfo {
 
-  // we currently only support muon decays
+  // the stochastic losses of muons with the current model
+  const auto& losses{StochasticLossTable::get(PDG::Muon, PhysicsConfig::current().energy_loss_model)};
 
-  // get a randomly distributed lifetime
-  const auto time{this->decay_time()};
+  // the energy of the muon when it has its next catastrophic loss
+  const auto energy{losses.next_loss(energy_)};
 
-  // return an InteractionInfo struct with this information
-  // InteractionInfo uses nanoseconds in lab frame.
-  return InteractionInfo(interactions::Decay, -1., time);
+  // if the muon ranges out first, it decays at rest
+  if (energy <= EnergyLossTable::EMIN) {
+
+    // get a randomly distributed lifetime
+    const auto time{this->decay_time()};
+
+    // return an InteractionInfo struct with this information
+    // InteractionInfo uses nanoseconds in lab frame.
+    return InteractionInfo(interactions::Decay, -1., time);
+  }
+
+  // otherwise, sample the process and the grammage to this loss
+  return InteractionInfo(StochasticLossTable::interaction(losses.sample_process(energy)),
+                         losses.continuous().grammage(energy_, energy));
 }
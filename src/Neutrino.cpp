@@ -1,6 +1,9 @@
 #include "apricot/particles/Neutrino.hpp"
 #include "apricot/Constants.hpp"
+#include "apricot/PhysicsConfig.hpp"
 #include "apricot/Random.hpp"
+#include "apricot/particles/InelasticityTable.hpp"
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
 #include <cmath>
 #include <stdexcept>
 
@@ -10,24 +13,22 @@ using namespace apricot;
 auto
 Neutrino::get_interaction() const -> InteractionInfo {
 
-  // get cross sections for NC and CC at the current energy
-  // these are in log10(g/cm^2)
-  const LogGrammage CC_cross{cross_section(interactions::ChargedCurrent)};
-  const LogGrammage NC_cross{cross_section(interactions::NeutralCurrent)};
+  // the total interaction length [g/cm^2] and charged current fraction
+  const auto [length, fraction]{PhysicsConfig::current().cross_sections->lookup(energy_)};
 
   // create a uniform number generator to use next.
   static std::uniform_real_distribution<double> uniform(0., 1.);
 
-  // exponential(lambda) has mean=1/lambda so the following have mean 1/{CC,NC}
-  // the result of exponential is in g/cm^2
-  const double CC{-log(uniform(random::generator)) * (1. / (N_A * pow(10, CC_cross)))};
-  const double NC{-log(uniform(random::generator)) * (1. / (N_A * pow(10, NC_cross)))};
+  // the grammage to the next interaction of either type is exponential
+  // with a mean of the total interaction length
+  const double grammage{-log(uniform(random::generator)) * length};
 
-  // decide which interaction happens first based on the cross section
-  const auto current{CC < NC ? interactions::ChargedCurrent : interactions::NeutralCurrent};
+  // and the interaction is charged current with probability `fraction`
+  const auto current{uniform(random::generator) < fraction ? interactions::ChargedCurrent
+                                                           : interactions::NeutralCurrent};
 
   // and return the InteractionInfo object
-  return InteractionInfo(current, fmin(CC, NC));
+  return InteractionInfo(current, grammage);
 }
 
 // evaluate the neutrino cross section
@@ -39,11 +40,11 @@ Neutrino::cross_section(const InteractionType& interaction) const -> LogGrammage
 
     // charged current interaction
   case interactions::ChargedCurrent:
-    return charged_current(Neutrino::cross_section_model, energy_);
+    return PhysicsConfig::current().cross_sections->charged_current(energy_);
 
     // charged current interaction
   case interactions::NeutralCurrent:
-    return neutral_current(Neutrino::cross_section_model, energy_);
+    return PhysicsConfig::current().cross_sections->neutral_current(energy_);
 
   default:
     // there is no amonut of grammage that the propagator to give
@@ -53,6 +54,18 @@ Neutrino::cross_section(const InteractionType& interaction) const -> LogGrammage
   } // END: switch(interaction)
 }
 
+// sample the inelasticity of an interaction
+auto
+Neutrino::sample_inelasticity() const -> double {
+  return InelasticityTable::get(PhysicsConfig::current().y_factor_model).sample(energy_);
+}
+
+// sample the energy of the outgoing lepton
+auto
+Neutrino::sample_lepton_energy() const -> LogEnergy {
+  return energy_ + log10(1. - sample_inelasticity());
+}
+
 // return a particle from a flavor and energy.
 auto
 Neutrino::from_generation(const Generation gen, const double energy)
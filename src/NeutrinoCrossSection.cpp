@@ -4,61 +4,99 @@
 
 using namespace apricot;
 
-// a function to evalute the cross section polynomial
-auto
-evaluate(const double energy, const std::array<double, 4>& coeff) -> double {
-  // this stores the final cross section value
-  double xsection{0.};
-
-  // iterate over the polynomial powers
-  for (int i = 0; i < 4; i += 1) {
-    xsection += coeff[i] * pow(energy, float(i));
-  }
-  // and take a final power
-  return xsection;
-}
-
-// get the charged current cross section
-auto
-apricot::charged_current(const NeutrinoCrossSectionModel model, const LogEnergy energy)
-    -> LogGrammage {
+namespace {
 
   // the following cross section parametrizations are copied directly from
   // https://github.com/harmscho/NuTauSim/
   // starting L708:simu_elost.cxx
   // these are taken from arXiV:1102.0691
 
-  switch (model) {
+  // the cubic coefficients of the charged current cross section
+  auto
+  charged_coefficients(const NeutrinoCrossSectionModel model) -> std::array<double, 4> {
+
+    switch (model) {
+
+    case NeutrinoCrossSectionModel::ConnollyLower:
+      // Connolly et al. 2011 lower model (ARW's parametrization)
+      return {{-4.26355014e+01, 4.89151126e-01, 2.94975025e-02, -1.32969832e-03}};
 
-  case NeutrinoCrossSectionModel::ConnollyMiddle: {
-    // Connolly et al. 2011 middle model (ARW's parametrization)
-    const std::array<double, 4> p{
-        {-5.35400180e+01, 2.65901551e+00, -1.14017685e-01, 1.82495442e-03}};
-    return evaluate(energy, p);
+    case NeutrinoCrossSectionModel::ConnollyUpper:
+      // Connolly et al. 2011 upper model (ARW's parametrization)
+      return {{-5.31078363e+01, 2.72995742e+00, -1.28808188e-01, 2.36800261e-03}};
+
+    case NeutrinoCrossSectionModel::ConnollyMiddle:
+    case NeutrinoCrossSectionModel::Gorham: // this is not a polynomial
+    default:
+      // Connolly et al. 2011 middle model (ARW's parametrization)
+      return {{-5.35400180e+01, 2.65901551e+00, -1.14017685e-01, 1.82495442e-03}};
+
+    } // end: switch
+  }
+
+  // the cubic coefficients of the neutral current cross section
+  auto
+  neutral_coefficients(const NeutrinoCrossSectionModel model) -> std::array<double, 4> {
+
+    switch (model) {
+
+    case NeutrinoCrossSectionModel::ConnollyLower:
+      // Connolly et al. 2011 lower model (ARW's parametrization)
+      return {{-4.42377028e+01, 7.07758518e-01, 1.55925146e-02, -1.02484763e-03}};
+
+    case NeutrinoCrossSectionModel::ConnollyUpper:
+      // Connolly et al. 2011 upper model (ARW's parametrization)
+      return {{-5.36713302e+01, 2.72528813e+00, -1.27067769e-01, 2.31235293e-03}};
+
+    case NeutrinoCrossSectionModel::ConnollyMiddle:
+    case NeutrinoCrossSectionModel::Gorham: // this is not a polynomial
+    default:
+      // Connolly et al. 2011 middle model (ARW's parametrization)
+      return {{-5.41463399e+01, 2.65465169e+00, -1.11848922e-01, 1.75469643e-03}};
+
+    } // end: switch
   }
 
-  case NeutrinoCrossSectionModel::ConnollyLower: {
-    // Connolly et al. 2011 lower model (ARW's parametrization)
-    const std::array<double, 4> p{
-        {-4.26355014e+01, 4.89151126e-01, 2.94975025e-02, -1.32969832e-03}};
-    return evaluate(energy, p);
+  // evaluate the cross section polynomial with Horner's method
+  auto
+  evaluate(const double energy, const std::array<double, 4>& coeff) -> double {
+    return ((coeff[3] * energy + coeff[2]) * energy + coeff[1]) * energy + coeff[0];
   }
 
-  case NeutrinoCrossSectionModel::ConnollyUpper: {
-    // Connolly et al. 2011 upper model (ARW's parametrization){
-    const std::array<double, 4> p{
-        {-5.31078363e+01, 2.72995742e+00, -1.28808188e-01, 2.36800261e-03}};
-    return evaluate(energy, p);
+  // evaluate the cross section polynomial over many energies - this is a
+  // single Eigen expression so it is evaluated with SIMD instructions
+  auto
+  evaluate(const EnergiesView& energies, const std::array<double, 4>& coeff) -> Array {
+    return ((coeff[3] * energies + coeff[2]) * energies + coeff[1]) * energies + coeff[0];
   }
 
-  case NeutrinoCrossSectionModel::Gorham:
-  default: // this is also the fall-through model
-  {
-    // this model is lifted straight from Peter Gorham's original MC
+  // the ratio of the Gorham charged and neutral current cross sections
+  const double GORHAM_RATIO{std::log10(2.39)};
+
+  // this model is lifted straight from Peter Gorham's original MC
+  auto
+  gorham(const double energy) -> double {
     return log10(1.e-36 * exp(82.893 - 98.8 * (pow((energy - 9.) / log10(M_E), -0.0964))));
   }
 
-  } // end: switch
+  // the same model over many energies - the log10(exp(...)) is expanded
+  auto
+  gorham(const EnergiesView& energies) -> Array {
+    return -36. +
+           log10(M_E) * (82.893 - 98.8 * ((energies - 9.) / log10(M_E)).pow(-0.0964));
+  }
+
+} // namespace
+
+// get the charged current cross section
+auto
+apricot::charged_current(const NeutrinoCrossSectionModel model, const LogEnergy energy)
+    -> LogGrammage {
+
+  // the Gorham model is not a polynomial
+  if (model == NeutrinoCrossSectionModel::Gorham) return gorham(energy);
+
+  return evaluate(energy, charged_coefficients(model));
 }
 
 // get cross-section at a given energy for a given cross-section model
@@ -66,42 +104,31 @@ auto
 apricot::neutral_current(const NeutrinoCrossSectionModel model, const LogEnergy energy)
     -> LogGrammage {
 
-  // the following cross section parametrizations are copied directly from
-  // https://github.com/harmscho/NuTauSim/
-  // starting L708:simu_elost.cxx
+  // this had NC as CC/2.39 but `getChargedCurrentCrossSection` returns
+  // log-space Xsection
+  if (model == NeutrinoCrossSectionModel::Gorham) return gorham(energy) - GORHAM_RATIO;
 
-  switch (model) {
+  return evaluate(energy, neutral_coefficients(model));
+}
 
-  case NeutrinoCrossSectionModel::ConnollyMiddle: {
-    // Connolly et al. 2011 middle model (ARW's parametrization)
-    const std::array<double, 4> p{
-        {-5.41463399e+01, 2.65465169e+00, -1.11848922e-01, 1.75469643e-03}};
-    return evaluate(energy, p);
-  }
+// get the charged current cross section at many energies
+auto
+apricot::charged_current(const NeutrinoCrossSectionModel model, const EnergiesView& energies)
+    -> Array {
 
-  case NeutrinoCrossSectionModel::ConnollyLower: {
-    // Connolly et al. 2011 lower model (ARW's parametrization)
-    const std::array<double, 4> p{
-        {-4.42377028e+01, 7.07758518e-01, 1.55925146e-02, -1.02484763e-03}};
-    return evaluate(energy, p);
-  }
+  // the Gorham model is not a polynomial
+  if (model == NeutrinoCrossSectionModel::Gorham) return gorham(energies);
 
-  case NeutrinoCrossSectionModel::ConnollyUpper: {
-    // Connolly et al. 2011 upper model (ARW's parametrization)
-    const std::array<double, 4> p{
-        {-5.36713302e+01, 2.72528813e+00, -1.27067769e-01, 2.31235293e-03}};
-    return evaluate(energy, p);
-  }
+  return evaluate(energies, charged_coefficients(model));
+}
 
-  case NeutrinoCrossSectionModel::Gorham:
-  default: // this is also the fall-through model
-  {
-    // this model is lifted straight from Peter Gorham's original MC
-    // this had NC as CC/2.39 but `getChargedCurrentCrossSection` returns
-    // log-space Xsection
-    return charged_current(NeutrinoCrossSectionModel::Gorham, energy) - log10(2.39);
-  }
+// get the neutral current cross section at many energies
+auto
+apricot::neutral_current(const NeutrinoCrossSectionModel model, const EnergiesView& energies)
+    -> Array {
+
+  // the Gorham NC cross section is CC/2.39
+  if (model == NeutrinoCrossSectionModel::Gorham) return gorham(energies) - GORHAM_RATIO;
 
-  } // end switch
-    //
+  return evaluate(energies, neutral_coefficients(model));
 }
@@ -0,0 +1,263 @@
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
+#include "apricot/Constants.hpp"
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The name of a built-in cross section model.
+   */
+  auto
+  name_of(const NeutrinoCrossSectionModel model) -> std::string {
+    switch (model) {
+    case NeutrinoCrossSectionModel::ConnollyLower:
+      return "ConnollyLower";
+    case NeutrinoCrossSectionModel::ConnollyMiddle:
+      return "ConnollyMiddle";
+    case NeutrinoCrossSectionModel::ConnollyUpper:
+      return "ConnollyUpper";
+    case NeutrinoCrossSectionModel::Gorham:
+    default:
+      return "Gorham";
+    } // END: switch (model)
+  }
+
+  /**
+   * Convert cross sections [cm^2] into log10(cm^2).
+   */
+  auto
+  log_cross_sections(const std::vector<double>& sigma) -> std::vector<double> {
+    std::vector<double> logs(sigma.size());
+    for (std::size_t i = 0; i < sigma.size(); ++i) {
+      if (!(sigma[i] > 0.) || !std::isfinite(sigma[i])) {
+        throw std::invalid_argument(
+            "NeutrinoCrossSectionTable: cross sections must be positive.");
+      }
+      logs[i] = std::log10(sigma[i]);
+    }
+    return logs;
+  }
+
+  /**
+   * The registry of every named model.
+   */
+  struct Registry {
+    std::mutex mutex;                                               ///< Guards the registry.
+    std::map<std::string, const NeutrinoCrossSectionTable*> models; ///< The model of each name.
+    std::vector<std::unique_ptr<NeutrinoCrossSectionTable>> tables; ///< Every added model.
+  };
+
+  /**
+   * The built-in models by name.
+   */
+  auto
+  builtins() -> std::map<std::string, const NeutrinoCrossSectionTable*> {
+    std::map<std::string, const NeutrinoCrossSectionTable*> models;
+    for (const auto model : {NeutrinoCrossSectionModel::ConnollyLower,
+                             NeutrinoCrossSectionModel::ConnollyMiddle,
+                             NeutrinoCrossSectionModel::ConnollyUpper,
+                             NeutrinoCrossSectionModel::Gorham}) {
+      models[name_of(model)] = &NeutrinoCrossSectionTable::get(model);
+    }
+    return models;
+  }
+
+  /**
+   * Get the registry - this starts with the built-in models.
+   */
+  auto
+  registry() -> Registry& {
+    static Registry state{{}, builtins(), {}};
+    return state;
+  }
+
+} // namespace
+
+NeutrinoCrossSectionTable::NeutrinoCrossSectionTable(const NeutrinoCrossSectionModel model) :
+    name_(name_of(model)), model_(model) {
+  tabulate();
+}
+
+NeutrinoCrossSectionTable::NeutrinoCrossSectionTable(const std::string& name,
+                                                     const std::vector<LogEnergy>& energies,
+                                                     const std::vector<double>& charged,
+                                                     const std::vector<double>& neutral) :
+    name_(name) {
+
+  // check that we have one cross section of each type per energy
+  if (charged.size() != energies.size() || neutral.size() != energies.size()) {
+    throw std::invalid_argument(
+        "NeutrinoCrossSectionTable: there must be one cross section of each type per energy.");
+  }
+
+  // build the splines in log-log space
+  charged_.emplace(energies, log_cross_sections(charged));
+  neutral_.emplace(energies, log_cross_sections(neutral));
+
+  tabulate();
+}
+
+auto
+NeutrinoCrossSectionTable::tabulate() -> void {
+
+  // the spacing of the energy grid
+  constexpr double step{(EMAX - EMIN) / NBINS};
+
+  // evaluate the model at every node
+  lengths_.resize(NBINS + 1);
+  fractions_.resize(NBINS + 1);
+  for (int i = 0; i <= NBINS; ++i) {
+    std::tie(lengths_[i], fractions_[i]) = evaluate(EMIN + i * step);
+  }
+}
+
+auto
+NeutrinoCrossSectionTable::get(const NeutrinoCrossSectionModel model)
+    -> const NeutrinoCrossSectionTable& {
+
+  // one table per model - these are only built once
+  static const NeutrinoCrossSectionTable lower{NeutrinoCrossSectionModel::ConnollyLower};
+  static const NeutrinoCrossSectionTable middle{NeutrinoCrossSectionModel::ConnollyMiddle};
+  static const NeutrinoCrossSectionTable upper{NeutrinoCrossSectionModel::ConnollyUpper};
+  static const NeutrinoCrossSectionTable gorham{NeutrinoCrossSectionModel::Gorham};
+
+  switch (model) {
+  case NeutrinoCrossSectionModel::ConnollyLower:
+    return lower;
+  case NeutrinoCrossSectionModel::ConnollyMiddle:
+    return middle;
+  case NeutrinoCrossSectionModel::ConnollyUpper:
+    return upper;
+  case NeutrinoCrossSectionModel::Gorham:
+  default:
+    return gorham;
+  } // END: switch (model)
+}
+
+auto
+NeutrinoCrossSectionTable::get(const std::string& name) -> const NeutrinoCrossSectionTable& {
+
+  // look for the model in the registry
+  auto& state{registry()};
+  std::lock_guard<std::mutex> lock{state.mutex};
+  const auto model{state.models.find(name)};
+
+  // and check that we found it
+  if (model == state.models.end()) {
+    throw std::invalid_argument("NeutrinoCrossSectionTable: unknown model '" + name + "'.");
+  }
+
+  return *model->second;
+}
+
+auto
+NeutrinoCrossSectionTable::add(const std::string& name,
+                               const std::vector<LogEnergy>& energies,
+                               const std::vector<double>& charged,
+                               const std::vector<double>& neutral)
+    -> const NeutrinoCrossSectionTable& {
+
+  // build the table before we take the lock
+  auto table{std::make_unique<NeutrinoCrossSectionTable>(name, energies, charged, neutral)};
+
+  // and register it
+  auto& state{registry()};
+  std::lock_guard<std::mutex> lock{state.mutex};
+  state.tables.push_back(std::move(table));
+  state.models[name] = state.tables.back().get();
+
+  return *state.tables.back();
+}
+
+auto
+NeutrinoCrossSectionTable::load(const std::string& name, const std::string& filename)
+    -> const NeutrinoCrossSectionTable& {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open cross section file '" + filename + "'.");
+  }
+
+  // the energy and cross sections of each row
+  std::vector<LogEnergy> energies;
+  std::vector<double> charged;
+  std::vector<double> neutral;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // read every value in this row
+    std::istringstream row{line};
+    std::vector<double> values;
+    for (double value{0.}; row >> value;) values.push_back(value);
+
+    // skip any empty lines
+    if (values.empty() && row.eof()) continue;
+
+    // we need the neutrino (and optionally anti-neutrino) cross sections
+    if (!row.eof() || (values.size() != 3 && values.size() != 5)) {
+      throw std::runtime_error(filename + ":" + std::to_string(lineno) +
+                               ": expected '<energy> <CC> <NC> [<CC-bar> <NC-bar>]'.");
+    }
+
+    // and average neutrinos and anti-neutrinos
+    energies.push_back(values[0]);
+    charged.push_back(values.size() == 5 ? 0.5 * (values[1] + values[3]) : values[1]);
+    neutral.push_back(values.size() == 5 ? 0.5 * (values[2] + values[4]) : values[2]);
+  }
+
+  return add(name, energies, charged, neutral);
+}
+
+auto
+NeutrinoCrossSectionTable::names() -> std::vector<std::string> {
+
+  // the name of every registered model
+  auto& state{registry()};
+  std::lock_guard<std::mutex> lock{state.mutex};
+  std::vector<std::string> names;
+  for (const auto& model : state.models) names.push_back(model.first);
+
+  return names;
+}
+
+auto
+NeutrinoCrossSectionTable::charged_current(const LogEnergy energy) const -> LogGrammage {
+  return model_ ? apricot::charged_current(*model_, energy) : (*charged_)(energy);
+}
+
+auto
+NeutrinoCrossSectionTable::neutral_current(const LogEnergy energy) const -> LogGrammage {
+  return model_ ? apricot::neutral_current(*model_, energy) : (*neutral_)(energy);
+}
+
+auto
+NeutrinoCrossSectionTable::evaluate(const LogEnergy energy) const -> std::pair<double, double> {
+
+  // the charged and neutral current cross sections [cm^2]
+  const auto CC{std::pow(10., charged_current(energy))};
+  const auto NC{std::pow(10., neutral_current(energy))};
+
+  // the total interaction length [g/cm^2] and the CC branching ratio
+  return {1. / (N_A * (CC + NC)), CC / (CC + NC)};
+}
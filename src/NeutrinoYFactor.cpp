@@ -4,74 +4,82 @@
 
 using namespace apricot;
 
-// we create a lambda expression and wrap E in a closure
-// so that we only need to provide the coefficients
-// double E = this->getEnergy();
-static auto evaluate(const double E, const std::array<double, 3> &coeff)
-    -> double {
-
-  // convert base 10 energies to natural logarithm in GeV
-  const double En{log(10) * (E - 9)};
-
-  // and return
-  return coeff[0] + coeff[1] * En + coeff[2] * En * En;
-}
-
-// use the Y-factor parametrization to estimate <y> at a given energy
-auto apricot::y_factor(const LogEnergy energy, const NeutrinoYFactorModel &model)
-    -> double {
+// the {y0, y1, y2} coefficients of a y-factor model below (or above) 10^17 eV
+static auto coefficients(const NeutrinoYFactorModel &model, const bool high)
+    -> std::array<double, 3> {
 
   // we provide the three 3-parameter parametrizations on
   // Pg. 9 of  arXiv::1704.00050
-  // the following arrays are {y0, y1, y2}
   // <y>(E) = y0 + y1*ln(E) + y2*(ln(E)^2
   // E is in GeV
   //
   // according to authors, this has <1% error between 10^6 and 10^13 GeV
 
   // these parametrizations are split into two parts
-  if (energy <= 17) {
+  if (!high) {
 
     switch (model) {
 
-    case NeutrinoYFactorModel::BDHM: {
-      const std::array<double, 3> coeff{{0.909, -5.95e-2, 1.17e-3}};
-      return evaluate(energy, coeff);
-    }
+    case NeutrinoYFactorModel::BDHM:
+      return {{0.909, -5.95e-2, 1.17e-3}};
 
-    case NeutrinoYFactorModel::Soyez: {
-      const std::array<double, 3> coeff{{1.08, -8.55e-2, 2.07e-3}};
-      return evaluate(energy, coeff);
-    }
+    case NeutrinoYFactorModel::Soyez:
+      return {{1.08, -8.55e-2, 2.07e-3}};
 
     case NeutrinoYFactorModel::ALLM:
-    default: {
-      const std::array<double, 3> coeff{{1.17, -9.99e-2, 2.59e-3}};
-      return evaluate(energy, coeff);
-    }
+    default:
+      return {{1.17, -9.99e-2, 2.59e-3}};
 
     }    // END: switch(model)
-  }      // if (energy <= 17)
+  }      // if (!high)
   else { // for energies greater than 17
 
     switch (model) {
 
-    case NeutrinoYFactorModel::BDHM: {
-      const std::array<double, 3> coeff{{0.654, -3.35e-2, 5.01e-4}};
-      return evaluate(energy, coeff);
-    }
+    case NeutrinoYFactorModel::BDHM:
+      return {{0.654, -3.35e-2, 5.01e-4}};
 
-    case NeutrinoYFactorModel::Soyez: {
-      const std::array<double, 3> coeff{{0.478, -2.05e-2, 2.98e-4}};
-      return evaluate(energy, coeff);
-    }
+    case NeutrinoYFactorModel::Soyez:
+      return {{0.478, -2.05e-2, 2.98e-4}};
 
     case NeutrinoYFactorModel::ALLM:
-    default: {
-      const std::array<double, 3> coeff{{0.356, -1.25e-2, 2.27e-4}};
-      return evaluate(energy, coeff);
-    }
+    default:
+      return {{0.356, -1.25e-2, 2.27e-4}};
 
     } // END: switch (model)
   }   // END: else
 }
+
+// evaluate a y-factor parametrization with Horner's method
+static auto evaluate(const double E, const std::array<double, 3> &coeff)
+    -> double {
+
+  // convert base 10 energies to natural logarithm in GeV
+  const double En{log(10) * (E - 9)};
+
+  // and return
+  return (coeff[2] * En + coeff[1]) * En + coeff[0];
+}
+
+// use the Y-factor parametrization to estimate <y> at a given energy
+auto apricot::y_factor(const LogEnergy energy, const NeutrinoYFactorModel &model)
+    -> double {
+  return evaluate(energy, coefficients(model, energy > 17));
+}
+
+// use the Y-factor parametrization to estimate <y> at many energies
+auto apricot::y_factor(const EnergiesView &energies,
+                       const NeutrinoYFactorModel &model) -> Array {
+
+  // the coefficients below and above 10^17 eV
+  const auto low{coefficients(model, false)};
+  const auto high{coefficients(model, true)};
+
+  // convert base 10 energies to natural logarithm in GeV
+  const Array En{log(10) * (energies - 9)};
+
+  // evaluate both parts with SIMD instructions and select between them
+  return (energies <= 17)
+      .select((low[2] * En + low[1]) * En + low[0],
+              (high[2] * En + high[1]) * En + high[0]);
+}
@@ -1,9 +1,39 @@
 #include "apricot/earth/PREM.hpp"
+#include "apricot/DensityModel.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 // using namespace Eigen;
 using namespace apricot;
 
+namespace {
+
+  // the normalized outer radius of each PREM shell (see PREM::density)
+  constexpr std::array<double, 10> BOUNDARIES{
+      {0.19216, 0.54745, 0.89684, 0.90628, 0.93759, 0.96590, 0.99658, 0.99752, 0.99941,
+       0.999984}};
+
+  // the polynomial coefficients in x of each PREM shell
+  constexpr std::array<std::array<double, 4>, 10> COEFFS{{{{13.0885, 0., -8.8381, 0.}},
+                                                          {{12.5815, -1.2638, -3.6426, -5.5281}},
+                                                          {{7.9565, -6.4761, 5.5283, -3.0807}},
+                                                          {{5.3197, -1.4836, 0., 0.}},
+                                                          {{11.2494, -8.0298, 0., 0.}},
+                                                          {{7.1089, -3.8045, 0., 0.}},
+                                                          {{2.691, 0.6924, 0., 0.}},
+                                                          {{2.9, 0., 0., 0.}},
+                                                          {{2.6, 0., 0., 0.}},
+                                                          {{1.02, 0., 0., 0.}}}};
+
+  // the antiderivative of a shell polynomial at x
+  auto
+  antiderivative(const std::array<double, 4>& c, const double x) -> double {
+    return x * (c[0] + x * (c[1] / 2. + x * (c[2] / 3. + x * c[3] / 4.)));
+  }
+
+} // namespace
+
 // Get the density (in g/cm^3) at a given radius.
 auto PREM::density(const double radius, const double Rearth) -> double {
   // both arguments in kilometers
@@ -45,3 +75,55 @@ auto PREM::density(const double radius, const double Rearth) -> double {
   // otherwise we are not in the Earth
   return 0.;
 }
+
+// Get the material at a given radius.
+auto PREM::material(const double radius, const double Rearth) -> MaterialID {
+
+  // get dimensionless constant as a function of Earth radius
+  const auto x{radius / Rearth};
+
+  if (x < 0.54745) // 3480 km
+    return materials::Core;
+
+  if (x < 0.99658) // 6335 km
+    return materials::Mantle;
+
+  if (x < 0.99941) // 6353 km
+    return materials::Rock;
+
+  if (x < 0.999984) // 6356.655 km
+    return materials::Water;
+
+  // otherwise we are not in the Earth
+  return materials::Vacuum;
+}
+
+// Get the column density between two radii.
+auto PREM::column(const double r0, const double r1, const double Rearth) -> double {
+
+  // integrate from the lower to the upper radius
+  if (r1 < r0) return -column(r1, r0, Rearth);
+
+  // the normalized range that we integrate over
+  const auto x0{r0 / Rearth};
+  const auto x1{r1 / Rearth};
+
+  // the integral in x
+  double total{0.};
+
+  // loop over the shells
+  for (std::size_t i = 0; i < BOUNDARIES.size(); ++i) {
+
+    // the part of this shell that is in the range
+    const auto lower{std::max(x0, i == 0 ? 0. : BOUNDARIES[i - 1])};
+    const auto upper{std::min(x1, BOUNDARIES[i])};
+
+    // and add the exact integral over this part of the shell
+    if (upper > lower) {
+      total += antiderivative(COEFFS[i], upper) - antiderivative(COEFFS[i], lower);
+    }
+  }
+
+  // and convert back into a radial integral
+  return Rearth * total;
+}
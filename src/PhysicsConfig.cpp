@@ -0,0 +1,31 @@
+#include "apricot/PhysicsConfig.hpp"
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The configuration installed on this thread (if any).
+   */
+  thread_local const PhysicsConfig* active{nullptr};
+
+} // namespace
+
+auto
+PhysicsConfig::global() -> PhysicsConfig& {
+  static PhysicsConfig config;
+  return config;
+}
+
+auto
+PhysicsConfig::current() -> const PhysicsConfig& {
+  return active ? *active : global();
+}
+
+PhysicsConfig::Scope::Scope(const PhysicsConfig& config) : previous_(active) {
+  active = &config;
+}
+
+PhysicsConfig::Scope::~Scope() {
+  active = previous_;
+}
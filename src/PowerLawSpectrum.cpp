@@ -0,0 +1,130 @@
+#include "apricot/fluxes/PowerLawFlux.hpp"
+#include "apricot/Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The integral of t^-γ for t in [1, exp(L)].
+   *
+   * @param index     The spectral index, γ.
+   * @param length    The natural log of the ratio of the end points, L.
+   */
+  auto
+  unit_integral(const double index, const double length) -> double {
+    const auto a{1. - index};
+    return std::abs(a * length) < 1e-9 ? length : std::expm1(a * length) / a;
+  }
+
+} // namespace
+
+PowerLawSpectrum::PowerLawSpectrum(const std::vector<LogEnergy>& energies,
+                                   const std::vector<double>& indices)
+    : energies_(energies), indices_(indices) {
+
+  // check that we have a valid spectrum
+  if (energies_.size() < 2 || indices_.size() + 1 != energies_.size()) {
+    throw std::invalid_argument(
+        "PowerLawSpectrum: needs at least two energies and one index between each pair.");
+  }
+  for (std::size_t i = 0; i + 1 < energies_.size(); ++i) {
+    if (!(energies_[i] < energies_[i + 1])) {
+      throw std::invalid_argument("PowerLawSpectrum: energies must be strictly increasing.");
+    }
+    if (!std::isfinite(indices_[i])) {
+      throw std::invalid_argument("PowerLawSpectrum: indices must be finite.");
+    }
+  }
+
+  // the spectrum is continuous at each break and we choose the
+  // amplitude at the first energy so that each segment is O(1)
+  const auto ln10{std::log(10.)};
+  amplitudes_.assign(indices_.size(), -ln10 * energies_.front());
+  for (std::size_t i = 1; i < indices_.size(); ++i) {
+    amplitudes_[i] =
+        amplitudes_[i - 1] - indices_[i - 1] * ln10 * (energies_[i] - energies_[i - 1]);
+  }
+
+  // integrate the spectrum over each segment
+  cdf_.assign(energies_.size(), 0.);
+  for (std::size_t i = 0; i < indices_.size(); ++i) {
+    const auto length{ln10 * (energies_[i + 1] - energies_[i])};
+    cdf_[i + 1] = cdf_[i] + std::exp(amplitudes_[i] + ln10 * energies_[i]) *
+                                unit_integral(indices_[i], length);
+  }
+
+  // check that there is something to sample
+  total_ = cdf_.back();
+  if (!(total_ > 0.) || !std::isfinite(total_)) {
+    throw std::invalid_argument("PowerLawSpectrum: the spectrum must have a finite integral.");
+  }
+
+  // and normalize the cumulative spectrum
+  for (auto& c : cdf_) c /= total_;
+  cdf_.back() = 1.;
+}
+
+auto
+PowerLawSpectrum::segment(const LogEnergy energy) const -> std::size_t {
+  const auto above{static_cast<std::size_t>(
+      std::upper_bound(energies_.begin(), energies_.end(), energy) - energies_.begin())};
+  return std::min(above > 0 ? above - 1 : 0, indices_.size() - 1);
+}
+
+auto
+PowerLawSpectrum::sample() const -> LogEnergy {
+
+  // pick a random point in the cumulative spectrum
+  const auto x{random::uniform<double>()};
+
+  // find the segment that contains it
+  const auto above{static_cast<std::size_t>(
+      std::upper_bound(cdf_.begin(), cdf_.end(), x) - cdf_.begin())};
+  const auto i{std::min(above > 0 ? above - 1 : 0, indices_.size() - 1)};
+
+  // the fraction of this segment that lies below our point
+  const auto width{cdf_[i + 1] - cdf_[i]};
+  const auto v{width > 0. ? std::clamp((x - cdf_[i]) / width, 0., 1.) : 0.};
+
+  // and invert the integral of t^-γ over this segment
+  const auto ln10{std::log(10.)};
+  const auto length{ln10 * (energies_[i + 1] - energies_[i])};
+  const auto a{1. - indices_[i]};
+  const auto offset{std::abs(a * length) < 1e-9 ? v * length
+                                                : std::log1p(v * std::expm1(a * length)) / a};
+
+  return std::clamp(energies_[i] + offset / ln10, energies_[i], energies_[i + 1]);
+}
+
+auto
+PowerLawSpectrum::log_pdf(const LogEnergy energy) const -> double {
+
+  // find the segment that contains this energy
+  const auto i{segment(energy)};
+
+  // and evaluate the normalized power-law in this segment
+  const auto ln10{std::log(10.)};
+  return amplitudes_[i] - indices_[i] * ln10 * (energy - energies_[i]) - std::log(total_);
+}
+
+auto
+PowerLawSpectrum::pdf(const LogEnergy energy) const -> double {
+
+  // the spectrum is zero outside of the breaks
+  if (energy < energies_.front() || energy > energies_.back()) return 0.;
+
+  return std::exp(log_pdf(energy));
+}
+
+auto
+PowerLawSpectrum::weight(const LogEnergy energy) const -> double {
+
+  // these energies are never generated
+  if (energy < energies_.front() || energy > energies_.back()) return 0.;
+
+  return std::exp(-log_pdf(energy));
+}
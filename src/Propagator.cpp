@@ -14,6 +14,9 @@ Propagator::propagate(Source& source,
                       const Detector& detector,
                       const int N) const -> Events {
 
+  // use the physics models of this propagator on this thread
+  const PhysicsConfig::Scope physics{get_physics()};
+
   // create a new InteractionTree
   Events interactions;
 
@@ -50,37 +53,36 @@ Propagator::new_trial(Source& source, Flux& flux) const
 auto
 Propagator::step(const ParticlePtr& particle,
                  CartesianCoordinate& location,
-                 Vector& direction) const -> double {
-
+                 Vector& direction,
+                 const double remaining) const -> double {
 
   // get the step size at the current location
-  const auto step_length{this->step_size(particle, location)};
-
-  // compute one-half of the step-length
-  const auto half_step{0.5 * step_length * direction};
-
-  // step the particle to the midpoint
-  location += half_step;
-
-  // get the density at the midpoint
-  const double density{earth_.density(location)};
+  const auto length{this->step_size(particle, location)};
 
-  // and step the particle the rest of the way
-  location += half_step;
-
-  // increment the grammage we have travelled through
-  return density * 1e5 * step_length; // grammage in cm, step_size in km
+  // and take the step through the Earth and atmosphere
+  return advance<Earth, Atmosphere>(earth_, location, direction, length, remaining);
 }
 
 auto
 Propagator::step_size(const std::unique_ptr<Particle>& particle,
                       const CartesianCoordinate& location) const -> double {
 
+  // get the radius of this point normalized to an average Earth radius.
+  return step_length(location.norm() / earth_.radius(location),
+                     earth_.analytic(),
+                     earth_.analytic_atmosphere());
+}
+
+auto
+Propagator::step_length(const double x, const bool analytic, const bool air) -> double {
+
+  // with an analytic interior, we take large steps up to the surface
+  if (analytic && x < 1.) return x < 0.99 ? step_length(x) : 1.; // 1km
 
-    // get the radius of this point normalized to an average Earth radius.
-  const double x{location.norm() / earth_.radius(location)};
+  // with an analytic atmosphere, we take large steps through the air
+  if (air && x >= 1.) return 1.; // 1km
 
-  // and do a four-piece step function returning step size in km
+  // a four-piece step function returning step size in km
   if (x < 0.85)
     return 10; // 10km
   if (x < 0.9)
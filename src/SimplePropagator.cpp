@@ -4,24 +4,194 @@
 #include "apricot/Flux.hpp"
 #include "apricot/Interaction.hpp"
 #include "apricot/Source.hpp"
+#include "apricot/atmospheres/ExponentialAtmosphere.hpp"
+#include "apricot/atmospheres/LinsleyAtmosphere.hpp"
+#include "apricot/atmospheres/SoundingAtmosphere.hpp"
+#include "apricot/detectors/AntarcticDetector.hpp"
+#include "apricot/detectors/OrbitalDetector.hpp"
+#include "apricot/detectors/PerfectDetector.hpp"
+#include "apricot/earth/SphericalEarth.hpp"
+#include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/particles/Neutrino.hpp"
+#include "apricot/particles/StochasticLossTable.hpp"
+#include "apricot/sources/SphericalCapSource.hpp"
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
 
 using namespace apricot;
 
+namespace {
+
+  /**
+   * Call `function` with `object` cast to the first matching type in Ts.
+   *
+   * This returns false if `object` is not an instance of any of Ts,
+   * otherwise it returns the result of `function`.
+   */
+  template <typename... Ts, typename Base, typename Function>
+  auto
+  dispatch(Base& object, Function&& function) -> bool {
+
+    // the (possibly const) derived type that we test against
+    auto matches = [&](auto* derived) -> std::optional<bool> {
+      if (derived == nullptr) return std::nullopt;
+      return function(*derived);
+    };
+
+    // the result of the first match
+    std::optional<bool> result;
+
+    // and try each type in order
+    ((result = matches(
+          dynamic_cast<std::conditional_t<std::is_const_v<Base>, const Ts, Ts>*>(&object))) ||
+     ...);
+
+    return result.value_or(false);
+  }
+
+  /**
+   * Call `function` with a pointer to the first matching atmosphere in Ts.
+   *
+   * The pointer is only used for its type; an Earth without an
+   * atmosphere is dispatched as the abstract Atmosphere type.
+   */
+  template <typename... Ts, typename Function>
+  auto
+  dispatch_atmosphere(const Atmosphere* atmosphere, Function&& function) -> bool {
+
+    // with no atmosphere, the atmosphere type is never used
+    if (atmosphere == nullptr) return function(static_cast<const Atmosphere*>(nullptr));
+
+    // the atmosphere type that we test against
+    auto matches = [&](auto* derived) -> std::optional<bool> {
+      if (derived == nullptr) return std::nullopt;
+      return function(derived);
+    };
+
+    // the result of the first match
+    std::optional<bool> result;
+
+    // and try each type in order
+    ((result = matches(dynamic_cast<const Ts*>(atmosphere))) || ...);
+
+    return result.value_or(false);
+  }
+
+} // namespace
+
+auto
+SimplePropagator::propagate(Source& source,
+                            Flux& flux,
+                            const Detector& detector,
+                            const int N) const -> Events {
+
+  // use the physics models of this propagator on this thread
+  const PhysicsConfig::Scope physics{get_physics()};
+
+  // the events that we propagate
+  Events events;
+
+  // try and find a statically typed kernel for these models
+  const bool found{dispatch<SphericalEarth>(earth_, [&](const auto& earth) {
+    using EarthT = std::decay_t<decltype(earth)>;
+
+    return dispatch_atmosphere<ExponentialAtmosphere, LinsleyAtmosphere, SoundingAtmosphere>(
+        earth.get_atmosphere().get(), [&](const auto* atmosphere) {
+          using AtmosphereT = std::decay_t<decltype(*atmosphere)>;
+
+          return dispatch<OrbitalDetector, PerfectDetector, AntarcticDetector>(
+              detector, [&](const auto& typed_detector) {
+                using DetectorT = std::decay_t<decltype(typed_detector)>;
+
+                return dispatch<SphericalCapSource>(source, [&](auto& typed_source) {
+                  using SourceT = std::decay_t<decltype(typed_source)>;
+
+                  // run the kernel for exactly these types
+                  events = kernel<EarthT, AtmosphereT, DetectorT, SourceT, Flux>(
+                      earth, typed_source, flux, typed_detector, N);
+
+                  return true;
+                });
+              });
+        });
+  })};
+
+  // if we found a kernel, we are done
+  if (found) return events;
+
+  // otherwise use the generic kernel
+  return kernel<Earth, Atmosphere, Detector, Source, Flux>(earth_, source, flux, detector, N);
+}
+
 auto
 SimplePropagator::propagate(Source& source, Flux& flux, const Detector& detector) const
     -> InteractionTree {
 
+  // use the physics models of this propagator on this thread
+  const PhysicsConfig::Scope physics{get_physics()};
+
+  return trial<Earth, Atmosphere, Detector, Source, Flux>(earth_, source, flux, detector);
+}
+
+template <typename EarthT,
+          typename AtmosphereT,
+          typename DetectorT,
+          typename SourceT,
+          typename FluxT>
+auto
+SimplePropagator::kernel(const EarthT& earth,
+                         SourceT& source,
+                         FluxT& flux,
+                         const DetectorT& detector,
+                         const int N) const -> Events {
+
+  // create a new list of interactions
+  Events interactions;
+
+  // resize it to store the number of events that were requested
+  interactions.reserve(N);
+
+  // loop over the number of interactions
+  for (int i = 0; i < N; ++i) {
+    // propagate one particle
+    interactions.push_back(
+        trial<EarthT, AtmosphereT, DetectorT, SourceT, FluxT>(earth, source, flux, detector));
+  }
+
+  // and we are done
+  return interactions;
+}
+
+template <typename EarthT,
+          typename AtmosphereT,
+          typename DetectorT,
+          typename SourceT,
+          typename FluxT>
+auto
+SimplePropagator::trial(const EarthT& earth,
+                        SourceT& source,
+                        FluxT& flux,
+                        const DetectorT& detector) const -> InteractionTree {
+
   // create the tree to store the particles
   InteractionTree tree;
 
-  // get a new trial particle to propagate
-  auto [particle, location, direction, info]{new_trial(source, flux)};
+  // random pick a new particle from this source
+  auto particle{flux.get_particle()};
+
+  // randomly pick a new start location and direction
+  auto [location, direction]{source.get_origin()};
+
+  // get the next interaction by this particle
+  const auto info{particle->get_interaction()};
 
   // check if this is a good particle
   if (!detector.is_good(particle, location, direction)) return tree;
 
-  // this is the grammage that we accumulate over this trial
-  double grammage{0.};
+  // this is the grammage that remains until the interaction
+  double remaining{info.grammage_};
 
   // compute the dot product weight for this trial
   const double weight{location.normalized().dot(direction)};
@@ -29,17 +199,21 @@ SimplePropagator::propagate(Source& source, Flux& flux, const Detector& detector
   // now loop through the Earth until we reach our propagation limits
   while (!detector.cut(particle, location, direction)) {
 
-    // step the particle along the direction and accumulate the grammage
-    grammage += this->step(particle, location, direction);
+    // step the particle along the direction and subtract the grammage
+    if constexpr (std::is_same_v<EarthT, Earth>) {
+      remaining -= this->step(particle, location, direction, remaining);
+    } else {
+      remaining -= step<EarthT, AtmosphereT>(earth, location, direction, remaining);
+    }
 
     // if we have reached our interaction grammage
-    if (grammage >= info.grammage_) {
+    if (remaining <= 0.) {
 
       // if the particle is detectable, return the interaction
       if (detector.detectable(info, particle, location, direction)) {
 
         // compute the altitude of the interaction
-        const auto altitude{location.norm() - earth_.radius(location)};
+        const auto altitude{location.norm() - earth.radius(location)};
 
         // return the interaction that occured
         tree.emplace_back(std::make_unique<Interaction>(
@@ -49,11 +223,40 @@ SimplePropagator::propagate(Source& source, Flux& flux, const Detector& detector
 
       } // END: if (detector.detectable...
 
+      // a tau neutrino charged current interaction creates a tau
+      // that might still decay somewhere detectable
+      if (taus_ && info.type_ == interactions::ChargedCurrent &&
+          std::abs(particle->get_id()) == PDG::TauNeutrino) {
+
+        // the energy of the outgoing tau
+        const auto energy{static_cast<const Neutrino&>(*particle).sample_lepton_energy()};
+
+        // and transport it along the same direction
+        transport<EarthT, AtmosphereT, DetectorT>(
+            earth, detector, energy, location, direction, weight, tree);
+      }
+
+      // and a muon neutrino charged current interaction creates a
+      // muon that might have catastrophic losses somewhere detectable
+      if (muons_ && info.type_ == interactions::ChargedCurrent &&
+          std::abs(particle->get_id()) == PDG::MuonNeutrino) {
+
+        // the energy of the outgoing muon
+        const auto energy{static_cast<const Neutrino&>(*particle).sample_lepton_energy()};
+
+        // and transport it along the same direction
+        transport_muon<EarthT, AtmosphereT, DetectorT>(
+            earth, detector, energy, location, direction, weight, tree);
+      }
+
+      // any leptons carry the generation weight of the neutrino
+      for (auto& interaction : tree) interaction->generation_weight_ = particle->get_weight();
+
       // we have interacted but it was not detected
       // so break from our loop to try again
       break; // this breaks from while (!detector...
 
-    } // END: if (grammage >= info.grammage)
+    } // END: if (remaining <= 0.)
 
   } // END: while (!detector.cut..
 
@@ -64,4 +267,177 @@ SimplePropagator::propagate(Source& source, Flux& flux, const Detector& detector
   // so return the (empty) tree
   return tree;
 
-} // END: propagate
+} // END: trial
+
+template <typename EarthT, typename AtmosphereT, typename DetectorT>
+auto
+SimplePropagator::transport(const EarthT& earth,
+                            const DetectorT& detector,
+                            const LogEnergy energy,
+                            CartesianCoordinate location,
+                            Vector direction,
+                            const double weight,
+                            InteractionTree& tree) const -> void {
+
+  // the tau that we transport
+  ParticlePtr tau{std::make_unique<Tau>(energy)};
+
+  // the continuous energy loss of taus
+  const auto& losses{EnergyLossTable::get(PDG::Tau, PhysicsConfig::current().energy_loss_model)};
+
+  // the decay length at the initial energy, converted into the
+  // (energy-independent) proper decay length c*tau [km]
+  const auto& initial{static_cast<const Tau&>(*tau)};
+  auto proper{initial.decay_length() / initial.gamma()};
+
+  // taus never have a grammage interaction
+  constexpr auto never{std::numeric_limits<double>::infinity()};
+
+  // step the tau until it is cut by the detector
+  while (!detector.cut(tau, location, direction)) {
+
+    // the start of this step and the energy at the start
+    const CartesianCoordinate start{location};
+    const auto before{tau->get_energy()};
+
+    // take a step and get the grammage that we crossed
+    double grammage;
+    if constexpr (std::is_same_v<EarthT, Earth>) {
+      grammage = this->step(tau, location, direction, never);
+    } else {
+      grammage = step<EarthT, AtmosphereT>(earth, location, direction, never);
+    }
+
+    // the length of the step and the energy at its end
+    const auto length{(location - start).norm()};
+    const auto after{losses.energy(before, grammage)};
+
+    // the Lorentz factors at the start and end of the step
+    const auto mass{static_cast<const Tau&>(*tau).mass_};
+    const auto gamma0{std::pow(10., before - mass)};
+    const auto gamma1{std::pow(10., after - mass)};
+
+    // the energy decays exponentially along the step with this rate [1/km]
+    const auto rate{length > 0. ? std::log(gamma0 / gamma1) / length : 0.};
+
+    // the proper decay length elapsed in this step, the integral of 1/gamma
+    const auto elapsed{rate > 1e-12 ? (1. / gamma1 - 1. / gamma0) / rate : length / gamma0};
+
+    // if the tau decays within this step
+    if (elapsed >= proper) {
+
+      // the distance along the step where the tau decays
+      const auto distance{rate > 1e-12 ? std::log1p(proper * rate * gamma0) / rate
+                                       : proper * gamma0};
+      const auto fraction{length > 0. ? std::clamp(distance / length, 0., 1.) : 0.};
+
+      // move the tau back to the decay point
+      location = start + fraction * length * direction;
+      tau->set_energy(before + fraction * (after - before));
+
+      // the decay of the tau
+      const InteractionInfo decay(interactions::Decay, -1.);
+
+      // and save it if it is detectable
+      if (detector.detectable(decay, tau, location, direction)) {
+
+        // compute the altitude of the decay
+        const auto altitude{location.norm() - earth.radius(location)};
+
+        tree.emplace_back(std::make_unique<Interaction>(
+            tau, interactions::Decay, location, direction, weight, altitude));
+      }
+
+      return;
+    }
+
+    // otherwise, the tau survived this step
+    proper -= elapsed;
+    tau->set_energy(after);
+
+    // and check if it has ranged out
+    if (after <= EnergyLossTable::EMIN) return;
+
+  } // END: while (!detector.cut...
+}
+
+template <typename EarthT, typename AtmosphereT, typename DetectorT>
+auto
+SimplePropagator::transport_muon(const EarthT& earth,
+                                 const DetectorT& detector,
+                                 const LogEnergy energy,
+                                 CartesianCoordinate location,
+                                 Vector direction,
+                                 const double weight,
+                                 InteractionTree& tree) const -> void {
+
+  // the muon that we transport
+  ParticlePtr muon{std::make_unique<Muon>(energy)};
+
+  // the continuous and stochastic energy losses of muons
+  const auto& table{StochasticLossTable::get(PDG::Muon, PhysicsConfig::current().energy_loss_model)};
+  const auto& losses{table.continuous()};
+
+  // the energy at the next catastrophic loss and the grammage until it
+  auto next{table.next_loss(energy)};
+  auto remaining{next > EnergyLossTable::EMIN ? losses.grammage(energy, next)
+                                              : std::numeric_limits<double>::infinity()};
+
+  // step the muon until it is cut by the detector
+  while (!detector.cut(muon, location, direction)) {
+
+    // take a step and subtract the grammage that we crossed
+    const auto before{muon->get_energy()};
+    double grammage;
+    if constexpr (std::is_same_v<EarthT, Earth>) {
+      grammage = this->step(muon, location, direction, remaining);
+    } else {
+      grammage = step<EarthT, AtmosphereT>(earth, location, direction, remaining);
+    }
+    remaining -= grammage;
+
+    // if we have not reached the next loss, the muon only slows down
+    if (remaining > 0.) {
+      muon->set_energy(losses.energy(before, grammage));
+
+      // and check if it has ranged out
+      if (muon->get_energy() <= EnergyLossTable::EMIN) return;
+
+      continue;
+    }
+
+    // otherwise, the muon has a catastrophic loss here
+    const auto process{table.sample_process(next)};
+    const auto fraction{table.sample_fraction(process)};
+    const InteractionInfo loss(StochasticLossTable::interaction(process), -1.);
+
+    // the detector only sees the energy deposited by the loss
+    const auto deposited{next + std::log10(fraction)};
+    muon->set_energy(deposited);
+
+    // and save it, with the energy of the loss, if it is detectable
+    if (detector.detectable(loss, muon, location, direction)) {
+
+      // compute the altitude of the loss
+      const auto altitude{location.norm() - earth.radius(location)};
+
+      tree.emplace_back(std::make_unique<Interaction>(PDG::Muon,
+                                                      deposited,
+                                                      loss.type_,
+                                                      location,
+                                                      direction,
+                                                      weight,
+                                                      altitude));
+    }
+
+    // the muon continues with the energy that remains
+    muon->set_energy(next + std::log10(1. - fraction));
+    if (muon->get_energy() <= EnergyLossTable::EMIN) return;
+
+    // and sample its next catastrophic loss
+    next      = table.next_loss(muon->get_energy());
+    remaining = next > EnergyLossTable::EMIN ? losses.grammage(muon->get_energy(), next)
+                                             : std::numeric_limits<double>::infinity();
+
+  } // END: while (!detector.cut...
+}
@@ -0,0 +1,255 @@
+#include "apricot/atmospheres/SlantDepthTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace apricot;
+
+SlantDepthTable::SlantDepthTable(const std::shared_ptr<Atmosphere>& atmosphere,
+                                 const double Rearth,
+                                 const int nheights,
+                                 const int nzeniths) :
+    atmosphere_(atmosphere), Rearth_(Rearth), nheights_(nheights), nzeniths_(nzeniths) {
+
+  // check that we have a valid table
+  if (atmosphere_ == nullptr || Rearth_ <= 0. || nheights_ < 2 || nzeniths_ < 2) {
+    throw std::invalid_argument("SlantDepthTable: invalid table parameters.");
+  }
+
+  // and build the table
+  tabulate();
+}
+
+auto
+SlantDepthTable::rebuild() -> void {
+
+  // only re-tabulate if the atmosphere has changed
+  if (stale()) tabulate();
+}
+
+auto
+SlantDepthTable::tabulate() -> void {
+
+  // the revision of the atmosphere that we tabulate
+  revision_ = atmosphere_->revision();
+
+  // the spacing of the altitude and sqrt(cos(zenith)) nodes
+  const auto dh{Atmosphere::TOP / (nheights_ - 1)};
+  const auto dq{1. / (nzeniths_ - 1)};
+
+  // integrate the slant depth at every node
+  table_.resize(static_cast<std::size_t>(nheights_) * nzeniths_);
+  for (int i = 0; i < nheights_; ++i) {
+    for (int j = 0; j < nzeniths_; ++j) {
+      const auto cosz{(j * dq) * (j * dq)};
+      table_[i * nzeniths_ + j] = std::log(std::max(FLOOR, integrate(i * dh, std::acos(cosz))));
+    }
+  }
+
+  // and measure the interpolation error at the center of every cell
+  error_ = 0.;
+  for (int i = 1; i < nheights_; ++i) {
+    for (int j = 1; j < nzeniths_; ++j) {
+
+      // the center of this cell
+      const auto altitude{(i - 0.5) * dh};
+      const auto cosz{((j - 0.5) * dq) * ((j - 0.5) * dq)};
+
+      // the exact slant depth at this center
+      const auto exact{integrate(altitude, std::acos(cosz))};
+      if (exact < 1.) continue;
+
+      // and compare against the table
+      error_ = std::max(error_, std::abs(lookup(altitude, cosz) / exact - 1.));
+    }
+  }
+}
+
+auto
+SlantDepthTable::lookup(const double altitude, const double cosz) const -> double {
+
+  // the fractional index of the altitude
+  const auto x{std::clamp(altitude, 0., Atmosphere::TOP) / Atmosphere::TOP * (nheights_ - 1)};
+  const auto i{std::min(static_cast<int>(x), nheights_ - 2)};
+  const auto fx{x - i};
+
+  // and of sqrt(cos(zenith))
+  const auto y{std::sqrt(std::clamp(cosz, 0., 1.)) * (nzeniths_ - 1)};
+  const auto j{std::min(static_cast<int>(y), nzeniths_ - 2)};
+  const auto fy{y - j};
+
+  // the four corners of this cell
+  const auto* lower{&table_[i * nzeniths_ + j]};
+  const auto* upper{lower + nzeniths_};
+
+  // and bilinearly interpolate log(X)
+  return std::exp((1. - fx) * ((1. - fy) * lower[0] + fy * lower[1]) +
+                  fx * ((1. - fy) * upper[0] + fy * upper[1]));
+}
+
+auto
+SlantDepthTable::depth(const double altitude, const double zenith) const -> double {
+
+  // the radius of the start of the ray and the cosine of the zenith angle
+  const auto radius{Rearth_ + altitude};
+  const auto cosz{std::cos(zenith)};
+
+  // upward rays are tabulated directly
+  if (cosz >= 0.) return lookup(altitude, cosz);
+
+  // the closest approach of the ray to the center of the Earth
+  const auto impact{radius * std::sin(zenith)};
+
+  // if the ray reaches the surface, the depth is the difference of
+  // the depths of the reversed ray from the surface and the start
+  if (impact < Rearth_) {
+    return std::max(0., lookup(0., std::sqrt(Rearth_ * Rearth_ - impact * impact) / Rearth_) -
+                            lookup(altitude, -cosz));
+  }
+
+  // otherwise, the ray crosses the atmosphere twice at its tangent point
+  return std::max(0., 2. * lookup(impact - Rearth_, 0.) - lookup(altitude, -cosz));
+}
+
+auto
+SlantDepthTable::distance(const double altitude,
+                          const double zenith,
+                          const double grammage) const -> double {
+
+  // the radius of the start of the ray
+  const auto radius{Rearth_ + altitude};
+
+  // the closest approach of the ray to the center of the Earth
+  const auto impact{radius * std::sin(zenith)};
+
+  // the signed distance of the start of the ray from its tangent point
+  const auto start{radius * std::cos(zenith)};
+
+  // the slant depth, up to a constant, at a signed distance from the tangent
+  // point - this is decreasing along the ray
+  const auto tangent{impact >= Rearth_ ? 2. * lookup(impact - Rearth_, 0.) : 0.};
+  const auto column{[&](const double t) -> double {
+    const auto r{std::hypot(impact, t)};
+    return t >= 0. ? lookup(r - Rearth_, t / r) : tangent - lookup(r - Rearth_, -t / r);
+  }};
+
+  // the end of the ray - either the surface or the top of the atmosphere
+  const auto top{Rearth_ + Atmosphere::TOP};
+  const auto end{(start < 0. && impact < Rearth_)
+                     ? -std::sqrt(Rearth_ * Rearth_ - impact * impact)
+                     : std::sqrt(std::max(0., top * top - impact * impact))};
+
+  // the slant depth at the start of the ray
+  const auto initial{column(start)};
+
+  // if we never reach this grammage, there is no interaction point
+  if (end <= start || initial - column(end) < grammage) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // the grammage crossed up to a point, less the target, and its
+  // gradient (the density along the ray) - this increases along the ray
+  const auto error{[&](const double t) { return initial - column(t) - grammage; }};
+  const auto gradient{[&](const double t) {
+    return 1e5 * atmosphere_->density(std::hypot(impact, t) - Rearth_);
+  }};
+
+  // solve for the point where we reach this grammage with Newton's
+  // method, falling back to bisection if a step leaves the bracket
+  double lower{start};
+  double upper{end};
+  double t{start};
+  for (int i = 0; i < MAX_ITERATIONS; ++i) {
+
+    // the error at this point and shrink the bracket around the root
+    const auto f{error(t)};
+    (f < 0. ? lower : upper) = t;
+
+    // take a Newton step - or bisect if it would leave the bracket
+    const auto slope{gradient(t)};
+    const auto newton{slope > 0. ? t - f / slope : upper};
+    const auto next{(newton > lower && newton < upper) ? newton : 0.5 * (lower + upper)};
+
+    // and stop once the point has converged
+    const auto step{std::abs(next - t)};
+    t = next;
+    if (step < TOLERANCE) break;
+  }
+
+  return t - start;
+}
+
+auto
+SlantDepthTable::integrate(const double altitude, const double zenith) const -> double {
+
+  // the radius of the start of the ray and the cosine of the zenith angle
+  const auto radius{Rearth_ + altitude};
+  const auto cosz{std::cos(zenith)};
+
+  // the closest approach of the ray to the center of the Earth
+  const auto impact{radius * std::sin(zenith)};
+
+  // the distance from the tangent point to the top of the atmosphere
+  const auto top{Rearth_ + Atmosphere::TOP};
+  const auto outgoing{std::sqrt(std::max(0., top * top - impact * impact))};
+
+  // an upward ray goes straight to the top of the atmosphere
+  if (cosz >= 0.) return integrate(radius, cosz, 0., outgoing - radius * cosz);
+
+  // the distance to the tangent point of a downward ray
+  const auto tangent{-radius * cosz};
+
+  // this ray might reach the surface first
+  if (impact < Rearth_) {
+    return integrate(
+        radius, cosz, 0., tangent - std::sqrt(Rearth_ * Rearth_ - impact * impact));
+  }
+
+  // otherwise, integrate down to the tangent point and then back up
+  return integrate(radius, cosz, 0., tangent) +
+         integrate(radius, cosz, tangent, tangent + outgoing);
+}
+
+auto
+SlantDepthTable::integrate(const double radius,
+                           const double cosz,
+                           const double s0,
+                           const double s1) const -> double {
+
+  // an empty part of the ray has no grammage
+  if (s1 <= s0) return 0.;
+
+  // the number of intervals that we use
+  constexpr int nsteps{200};
+
+  // concentrate the nodes at the lower end of this part
+  const bool downward{(s0 + s1) < -2. * radius * cosz};
+
+  // the distance along the ray for a parameter in [0, 1], and its derivative
+  const auto width{s1 - s0};
+  const auto position{[&](const double u) { return downward ? s1 - width * u * u * u
+                                                            : s0 + width * u * u * u; }};
+
+  // the density times ds/du at a parameter in [0, 1]
+  const auto integrand{[&](const double u) {
+    const auto s{position(u)};
+    const auto r{std::sqrt(radius * radius + s * s + 2. * radius * s * cosz)};
+    return atmosphere_->density(r - Rearth_) * 3. * width * u * u;
+  }};
+
+  // the offset of the outer Gauss-Legendre nodes
+  const auto du{1. / nsteps};
+  const auto offset{0.5 * du * 0.7745966692414834}; // sqrt(3/5)
+
+  // integrate each interval with a three-point Gauss-Legendre rule
+  double column{0.};
+  for (int i = 0; i < nsteps; ++i) {
+    const auto center{(i + 0.5) * du};
+    column += (5. / 9.) * integrand(center - offset) + (8. / 9.) * integrand(center) +
+              (5. / 9.) * integrand(center + offset);
+  }
+
+  // and convert from g/cm^3 * km into g/cm^2
+  return 1e5 * 0.5 * du * column;
+}
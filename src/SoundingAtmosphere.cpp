@@ -0,0 +1,371 @@
+#include "apricot/atmospheres/SoundingAtmosphere.hpp"
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The number of cells in the altitude grid.
+   */
+  const auto NCELLS{static_cast<std::size_t>(std::lround(Atmosphere::TOP /
+                                                         SoundingAtmosphere::STEP))};
+
+  /**
+   * The density of dry air from its pressure and temperature [g/cm^3].
+   *
+   * @param pressure       The pressure [hPa].
+   * @param temperature    The temperature [K].
+   */
+  auto
+  ideal_gas(const double pressure, const double temperature) -> double {
+
+    // the molar mass of dry air [kg/mol] and the gas constant [J mol^-1 K^-1]
+    constexpr double M{0.028966};
+    constexpr double R{8.3145};
+
+    // the density in kg/m^3 converted into g/cm^3
+    return 1e-3 * (100. * pressure) * M / (R * temperature);
+  }
+
+} // namespace
+
+SoundingAtmosphere::SoundingAtmosphere(const std::string& filename) : period_(0.), time_(0.) {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open sounding file '" + filename + "'.");
+  }
+
+  // the altitudes and densities of every profile
+  std::vector<std::vector<double>> altitudes;
+  std::vector<std::vector<double>> densities;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // and read the first value on this row
+    std::istringstream row{line};
+    std::string keyword;
+
+    // skip any empty lines
+    if (!(row >> keyword)) continue;
+
+    // a message prefix for any errors
+    const auto where{filename + ":" + std::to_string(lineno) + ": "};
+
+    if (keyword == "period") {
+      if (!(row >> period_)) {
+        throw std::runtime_error(where + "expected 'period <period>'.");
+      }
+    } else if (keyword == "profile") {
+
+      // the time of this profile
+      double time;
+      if (!(row >> time)) {
+        throw std::runtime_error(where + "expected 'profile <time>'.");
+      }
+
+      // and start a new profile
+      times_.push_back(time);
+      altitudes.emplace_back();
+      densities.emplace_back();
+
+    } else {
+
+      // every other row is a point in the current profile
+      if (times_.empty()) {
+        throw std::runtime_error(where + "expected 'profile <time>' before any data.");
+      }
+
+      // read all of the values on this row
+      std::istringstream values{line};
+      std::vector<double> columns;
+      double value;
+      while (values >> value) columns.push_back(value);
+
+      // check that we read the whole row
+      if (!values.eof() || (columns.size() != 2 && columns.size() != 3)) {
+        throw std::runtime_error(
+            where + "expected '<altitude> <density>' or '<altitude> <pressure> <temperature>'.");
+      }
+
+      // and save this point
+      altitudes.back().push_back(columns[0]);
+      densities.back().push_back(columns.size() == 2 ? columns[1]
+                                                     : ideal_gas(columns[1], columns[2]));
+    }
+
+  } // END: while (std::getline...
+
+  // resample every profile onto the altitude grid
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    profiles_.push_back(resample(altitudes[i], densities[i]));
+  }
+
+  // and activate the first profile
+  initialize();
+}
+
+SoundingAtmosphere::SoundingAtmosphere(const std::vector<double>& times,
+                                       const std::vector<std::vector<double>>& altitudes,
+                                       const std::vector<std::vector<double>>& densities,
+                                       const double period) :
+    times_(times), period_(period), time_(0.) {
+
+  // we need a set of altitudes and densities for every time
+  if (altitudes.size() != times_.size() || densities.size() != times_.size()) {
+    throw std::invalid_argument("SoundingAtmosphere: expected one profile per time.");
+  }
+
+  // resample every profile onto the altitude grid
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    profiles_.push_back(resample(altitudes[i], densities[i]));
+  }
+
+  // and activate the first profile
+  initialize();
+}
+
+auto
+SoundingAtmosphere::Profile::depth(const std::size_t i, const double altitude) const
+    -> double {
+
+  // the density at this altitude and the top of the cell
+  const auto rho{density(i, altitude)};
+  const auto upper{std::exp(log_density[i + 1])};
+
+  // the exact integral of the exponential up to the top of the cell
+  const auto column{std::abs(slopes[i]) > 1e-12 ? (upper - rho) / slopes[i]
+                                                : rho * ((i + 1) * STEP - altitude)};
+
+  // and add the depth above this cell
+  return depths[i + 1] + 1e5 * column;
+}
+
+auto
+SoundingAtmosphere::resample(const std::vector<double>& altitudes,
+                             const std::vector<double>& densities) -> Profile {
+
+  // check that we have a valid profile
+  if (altitudes.size() < 2 || altitudes.size() != densities.size()) {
+    throw std::invalid_argument("SoundingAtmosphere: a profile needs at least two points.");
+  }
+  for (std::size_t i = 0; i < altitudes.size(); ++i) {
+    if (densities[i] <= 0. || (i > 0 && altitudes[i] <= altitudes[i - 1])) {
+      throw std::invalid_argument(
+          "SoundingAtmosphere: profiles need increasing altitudes and positive densities.");
+    }
+  }
+
+  // the density must decrease above the profile so that we can extrapolate it
+  const auto last{altitudes.size() - 1};
+  if (densities[last] >= densities[last - 1]) {
+    throw std::invalid_argument(
+        "SoundingAtmosphere: the density must decrease at the top of a profile.");
+  }
+
+  // the profile on the altitude grid
+  Profile profile;
+  profile.log_density.resize(NCELLS + 1);
+
+  // the current segment of the profile
+  std::size_t j{0};
+
+  // interpolate (or extrapolate) log(density) at every node
+  for (std::size_t i = 0; i <= NCELLS; ++i) {
+
+    // the altitude of this node
+    const auto altitude{i * STEP};
+
+    // find the segment of the profile to use for this node
+    while (j + 2 < altitudes.size() && altitude > altitudes[j + 1]) ++j;
+
+    // and interpolate linearly in log(density)
+    const auto fraction{(altitude - altitudes[j]) / (altitudes[j + 1] - altitudes[j])};
+    profile.log_density[i] =
+        std::log(densities[j]) + fraction * std::log(densities[j + 1] / densities[j]);
+  }
+
+  // the gradient of log(density) in each cell
+  profile.slopes.resize(NCELLS);
+  for (std::size_t i = 0; i < NCELLS; ++i) {
+    profile.slopes[i] = (profile.log_density[i + 1] - profile.log_density[i]) / STEP;
+  }
+
+  // and integrate the depth down from the top of the grid
+  profile.depths.assign(NCELLS + 1, 0.);
+  for (std::size_t i = NCELLS; i-- > 0;) profile.depths[i] = profile.depth(i, i * STEP);
+
+  return profile;
+}
+
+auto
+SoundingAtmosphere::initialize() -> void {
+
+  // check that we have at least one profile
+  if (times_.empty()) {
+    throw std::invalid_argument("SoundingAtmosphere: expected at least one profile.");
+  }
+
+  // sort the profiles by time
+  std::vector<std::size_t> order(times_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](auto a, auto b) { return times_[a] < times_[b]; });
+
+  // and reorder the times and profiles
+  std::vector<double> times;
+  std::vector<Profile> profiles;
+  for (const auto i : order) {
+    times.push_back(times_[i]);
+    profiles.push_back(std::move(profiles_[i]));
+  }
+  times_    = std::move(times);
+  profiles_ = std::move(profiles);
+
+  // the times must be distinct and fit within one period
+  for (std::size_t i = 1; i < times_.size(); ++i) {
+    if (times_[i] <= times_[i - 1]) {
+      throw std::invalid_argument("SoundingAtmosphere: profile times must be distinct.");
+    }
+  }
+  if (period_ < 0. || (period_ > 0. && times_.back() - times_.front() >= period_)) {
+    throw std::invalid_argument("SoundingAtmosphere: the profiles must fit within one period.");
+  }
+
+  // and activate the first profile
+  set_time(times_.front());
+}
+
+auto
+SoundingAtmosphere::set_time(const double time, const bool interpolate) -> void {
+
+  // save the time
+  time_ = time;
+
+  // the time to look up - wrapped into the first period if we have one
+  const auto t{period_ > 0.
+                   ? times_.front() + std::fmod(std::fmod(time - times_.front(), period_) +
+                                                    period_,
+                                                period_)
+                   : time};
+
+  // the last profile at or before this time (or the first one)
+  const auto after{std::upper_bound(times_.begin(), times_.end(), t)};
+  const auto k{after == times_.begin() ? 0 : static_cast<std::size_t>(after - times_.begin()) - 1};
+
+  // the next profile - wrapping around if we are periodic
+  const auto periodic{period_ > 0. && k + 1 == times_.size()};
+  const auto next{periodic ? 0 : std::min<std::size_t>(k + 1, times_.size() - 1)};
+
+  // the time of the next profile
+  const auto tnext{periodic ? times_.front() + period_ : times_[next]};
+
+  // the weight of the next profile
+  auto weight{tnext > times_[k] ? std::clamp((t - times_[k]) / (tnext - times_[k]), 0., 1.)
+                                : 0.};
+
+  // without interpolation, pick the closest profile
+  if (!interpolate) weight = weight < 0.5 ? 0. : 1.;
+
+  // and select the (precomputed) profiles to mix
+  lower_  = weight < 1. ? k : next;
+  upper_  = next;
+  weight_ = weight < 1. ? weight : 0.;
+
+  // and let any tables built from this atmosphere know it has changed
+  ++revision_;
+}
+
+auto
+SoundingAtmosphere::depth(const double altitude) const -> double {
+
+  // above the grid, there is no atmosphere
+  if (altitude >= Atmosphere::TOP) return 0.;
+
+  // the cell containing this altitude
+  const auto i{cell(altitude)};
+
+  // the depth of the active profile
+  const auto depth{profiles_[lower_].depth(i, altitude)};
+
+  // and mix in the later profile if we are between two
+  if (!(weight_ > 0.)) return depth;
+  return (1. - weight_) * depth + weight_ * profiles_[upper_].depth(i, altitude);
+}
+
+auto
+SoundingAtmosphere::altitude(const double depth) const -> double {
+
+  // at zero depth, we are at the top of the atmosphere
+  if (depth <= 0.) return Atmosphere::TOP;
+
+  // find the first node whose depth is at most this depth
+  std::size_t first{0};
+  std::size_t count{NCELLS + 1};
+  while (count > 0) {
+    const auto half{count / 2};
+    if (node_depth(first + half) > depth) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+
+  // and the cell above the node (or the first cell if we are below the grid)
+  const auto i{first == 0 ? 0 : first - 1};
+
+  // with a single profile, we invert the exact integral of the exponential
+  if (!(weight_ > 0.)) {
+    const auto& profile{profiles_[lower_]};
+
+    // the depth within this cell and the density at its top
+    const auto column{(depth - profile.depths[i + 1]) / 1e5};
+    const auto upper{std::exp(profile.log_density[i + 1])};
+
+    // with a constant density, the depth is linear in altitude
+    if (std::abs(profile.slopes[i]) <= 1e-12) return (i + 1) * STEP - column / upper;
+
+    // otherwise invert the exact integral of the exponential
+    return i * STEP +
+           (std::log(upper - profile.slopes[i] * column) - profile.log_density[i]) /
+               profile.slopes[i];
+  }
+
+  // between two profiles, solve for the altitude with Newton's method
+  // starting from a linear interpolation of the depth in this cell
+  const auto top{node_depth(i + 1)};
+  const auto bottom{node_depth(i)};
+  const auto lower{first == 0 ? -std::numeric_limits<double>::infinity() : i * STEP};
+  const auto upper{(i + 1) * STEP};
+  auto altitude{upper - STEP * (depth - top) / std::max(bottom - top, 1e-300)};
+  for (int iteration = 0; iteration < 50; ++iteration) {
+
+    // the error in depth and its gradient at this altitude
+    const auto error{this->depth(altitude) - depth};
+    const auto gradient{-1e5 * density(altitude)};
+
+    // and take a step towards the solution - staying within this cell
+    const auto previous{altitude};
+    altitude = std::clamp(altitude - error / gradient, lower, upper);
+    if (std::abs(altitude - previous) < 1e-10) break;
+  }
+
+  return altitude;
+}
@@ -0,0 +1,198 @@
+#include "apricot/fluxes/TabulatedFlux.hpp"
+#include "apricot/Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The index of the interval of a table that contains a value.
+   *
+   * Values beyond the ends of the table use the first or last interval.
+   *
+   * @param nodes    The (strictly increasing) nodes of the table.
+   * @param value    The value to look for.
+   */
+  auto
+  interval(const std::vector<double>& nodes, const double value) -> std::size_t {
+    const auto above{static_cast<std::size_t>(
+        std::upper_bound(nodes.begin(), nodes.end(), value) - nodes.begin())};
+    return std::min(above > 0 ? above - 1 : 0, nodes.size() - 2);
+  }
+
+} // namespace
+
+SpectrumTable::SpectrumTable(const std::vector<LogEnergy>& energies,
+                             const std::vector<double>& flux) {
+  compile(energies, flux);
+}
+
+SpectrumTable::SpectrumTable(const std::string& filename) {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open spectrum file '" + filename + "'.");
+  }
+
+  // the energies and fluxes in the file
+  std::vector<LogEnergy> energies;
+  std::vector<double> flux;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // and read the values on this row
+    std::istringstream row{line};
+    double energy;
+    double value;
+
+    // skip any empty lines
+    if (!(row >> energy)) continue;
+
+    // check that we have a valid row
+    if (!(row >> value)) {
+      throw std::runtime_error(filename + ":" + std::to_string(lineno) +
+                               ": expected '<log10(E/eV)> <dN/dE>'.");
+    }
+
+    energies.push_back(energy);
+    flux.push_back(value);
+  }
+
+  compile(energies, flux);
+}
+
+auto
+SpectrumTable::compile(const std::vector<LogEnergy>& energies, const std::vector<double>& flux)
+    -> void {
+
+  // check that we have a valid spectrum
+  if (energies.size() < 2 || energies.size() != flux.size()) {
+    throw std::invalid_argument(
+        "SpectrumTable: needs at least two energies and one flux per energy.");
+  }
+  for (std::size_t i = 0; i < energies.size(); ++i) {
+    if (i > 0 && !(energies[i - 1] < energies[i])) {
+      throw std::invalid_argument("SpectrumTable: energies must be strictly increasing.");
+    }
+    if (!(flux[i] >= 0.) || !std::isfinite(flux[i])) {
+      throw std::invalid_argument("SpectrumTable: fluxes must be non-negative.");
+    }
+  }
+
+  // convert dN/dE into dN/dlog10(E) = ln(10) E dN/dE
+  energies_ = energies;
+  densities_.resize(flux.size());
+  for (std::size_t i = 0; i < flux.size(); ++i) {
+    densities_[i] = std::log(10.) * std::pow(10., energies[i]) * flux[i];
+  }
+
+  // integrate the spectrum over each interval
+  cdf_.assign(energies_.size(), 0.);
+  for (std::size_t i = 0; i + 1 < energies_.size(); ++i) cdf_[i + 1] = cdf_[i] + segment(i);
+
+  // check that there is something to sample
+  total_ = cdf_.back();
+  if (!(total_ > 0.) || !std::isfinite(total_)) {
+    throw std::invalid_argument("SpectrumTable: the spectrum must have a positive integral.");
+  }
+
+  // and normalize the cumulative spectrum
+  for (auto& c : cdf_) c /= total_;
+  cdf_.back() = 1.;
+}
+
+auto
+SpectrumTable::segment(const std::size_t i) const -> double {
+
+  // the width and end points of this interval
+  const auto width{energies_[i + 1] - energies_[i]};
+  const auto lower{densities_[i]};
+  const auto upper{densities_[i + 1]};
+
+  // if either end is zero, dN/dlog10(E) is linear in the interval
+  if (!(lower > 0.) || !(upper > 0.)) {
+    return 0.5 * width * (lower + upper);
+  }
+
+  // otherwise, it is a power law
+  const auto slope{std::log(upper / lower)};
+  if (std::abs(slope) < 1e-9) return width * lower;
+  return width * lower * std::expm1(slope) / slope;
+}
+
+auto
+SpectrumTable::sample() const -> LogEnergy {
+
+  // pick a random point in the cumulative spectrum
+  const auto x{random::uniform<double>()};
+
+  // find the interval that contains it
+  const auto i{interval(cdf_, x)};
+
+  // the width and end points of this interval
+  const auto width{energies_[i + 1] - energies_[i]};
+  const auto lower{densities_[i]};
+  const auto upper{densities_[i + 1]};
+
+  // the (unnormalized) spectrum that we need within this interval
+  const auto mass{(x - cdf_[i]) * total_ / width};
+  if (!(mass > 0.)) return energies_[i];
+
+  // and invert the integral of this interval
+  double fraction;
+  if (!(lower > 0.) || !(upper > 0.)) {
+
+    // solve lower f + (upper - lower) f^2 / 2 = mass in a stable form
+    const auto a{upper - lower};
+    fraction = 2. * mass / (lower + std::sqrt(std::max(lower * lower + 2. * a * mass, 0.)));
+
+  } else {
+
+    // invert lower (exp(slope f) - 1) / slope = mass
+    const auto slope{std::log(upper / lower)};
+    fraction = std::abs(slope) < 1e-9 ? mass / lower
+                                      : std::log1p(slope * mass / lower) / slope;
+  }
+
+  return energies_[i] + width * std::clamp(fraction, 0., 1.);
+}
+
+auto
+SpectrumTable::flux(const LogEnergy energy) const -> double {
+
+  // the spectrum is zero outside of the table
+  if (energy < energies_.front() || energy > energies_.back()) return 0.;
+
+  // find the interval that contains this energy
+  const auto i{interval(energies_, energy)};
+
+  // the fraction of the interval below this energy
+  const auto f{(energy - energies_[i]) / (energies_[i + 1] - energies_[i])};
+
+  // interpolate dN/dlog10(E) in this interval
+  const auto lower{densities_[i]};
+  const auto upper{densities_[i + 1]};
+  const auto density{!(lower > 0.) || !(upper > 0.)
+                         ? lower + f * (upper - lower)
+                         : lower * std::pow(upper / lower, f)};
+
+  // and convert it back into dN/dE
+  return density / (std::log(10.) * std::pow(10., energy));
+}
@@ -1,9 +1,23 @@
 #include "apricot/sources/SphericalCapSource.hpp"
 #include "apricot/Geometry.hpp"
 #include <cmath>
+#include <stdexcept>
 
 using namespace apricot;
 
+SphericalCapSource::SphericalCapSource(const CartesianCoordinate& target,
+                                       const double cone,
+                                       const double radius,
+                                       const double theta,
+                                       const double center) :
+    radius_(radius), theta_(theta), center_(center), target_(target), cone_(cone) {
+
+  // check that we have a valid cone
+  if (!(cone > 0.) || cone > M_PI) {
+    throw std::invalid_argument("SphericalCapSource: the cone angle must be in (0, pi].");
+  }
+}
+
 auto
 SphericalCapSource::get_origin() const -> std::pair<CartesianCoordinate, Vector> {
 
@@ -19,10 +33,22 @@ SphericalCapSource::get_origin() const -> std::pair<CartesianCoordinate, Vector>
   // and scale it by the desired radius
   origin *= this->radius_;
 
-  // and pick a vector uniformly in 4\pi steradians
-  const auto direction{random_spherical_point()};
+  // and pick a vector uniformly in the cone around the target
+  // or, if we don't have a target, in 4\pi steradians
+  const auto direction{target_ ? random_cone_point(*target_ - origin, cone_)
+                               : random_spherical_point()};
 
   // and return the pair
   return std::make_pair(origin, direction);
   
 }
+
+auto
+SphericalCapSource::solid_angle() const -> double {
+
+  // without a target, we sample all directions
+  if (!target_) return 4. * M_PI;
+
+  // otherwise, the solid angle of the cone
+  return 2. * M_PI * (1. - cos(cone_));
+}
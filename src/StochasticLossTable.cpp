@@ -0,0 +1,290 @@
+#include "apricot/particles/StochasticLossTable.hpp"
+#include "apricot/Particle.hpp"
+#include "apricot/Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The spacing of the energy grid [log10(eV)].
+   */
+  constexpr double STEP{(EnergyLossTable::EMAX - EnergyLossTable::EMIN) /
+                        EnergyLossTable::NBINS};
+
+  /**
+   * The smallest loss fraction that we integrate the spectra down to.
+   */
+  constexpr double VMIN{1e-5};
+
+  /**
+   * The number of intervals used to integrate each spectrum.
+   */
+  constexpr int NSAMPLES{4096};
+
+  /**
+   * The energy-weighted spectrum, v dN/dv, of each process.
+   */
+  auto
+  spectrum(const LossProcess process) -> std::function<double(double)> {
+    switch (process) {
+    case LossProcess::Bremsstrahlung:
+      return [](const double v) { return (4. / 3.) * (1. - v) + v * v; };
+    case LossProcess::PairProduction:
+      return [](const double v) { return (1. - v) / v; };
+    case LossProcess::Photonuclear:
+    default:
+      return [](const double v) { return 1. - v + 0.5 * v * v; };
+    } // END: switch (process)
+  }
+
+  /**
+   * Integrate a function of ln(v) with the trapezoid rule.
+   *
+   * @param function    The integrand as a function of ln(v).
+   * @param lower       The lower limit of ln(v).
+   * @param upper       The upper limit of ln(v).
+   */
+  auto
+  integrate(const std::function<double(double)>& function, const double lower, const double upper)
+      -> double {
+    const auto h{(upper - lower) / NSAMPLES};
+    double sum{0.5 * (function(lower) + function(upper))};
+    for (int i = 1; i < NSAMPLES; ++i) sum += function(lower + i * h);
+    return h * sum;
+  }
+
+  /**
+   * The fractional index of an energy on the grid, clamped to the table.
+   *
+   * @param energy    The energy [log10(eV)].
+   */
+  auto
+  index(const LogEnergy energy) -> std::pair<int, double> {
+    const auto x{std::clamp((energy - EnergyLossTable::EMIN) / STEP,
+                            0.,
+                            1. * EnergyLossTable::NBINS)};
+    const auto i{std::min(static_cast<int>(x), EnergyLossTable::NBINS - 1)};
+    return {i, x - i};
+  }
+
+  /**
+   * Linearly interpolate a table on the energy grid.
+   *
+   * @param table     The value at each node.
+   * @param energy    The energy [log10(eV)].
+   */
+  auto
+  interpolate(const std::vector<double>& table, const LogEnergy energy) -> double {
+    const auto [i, f]{index(energy)};
+    return table[i] + f * (table[i + 1] - table[i]);
+  }
+
+} // namespace
+
+StochasticLossTable::StochasticLossTable(const ParticleID id,
+                                         const LeptonEnergyLossModel model,
+                                         const double vcut) :
+    vcut_(vcut),
+    continuous_(std::vector<double>(EnergyLossTable::NBINS + 1, 0.)) {
+
+  // check that we have a valid threshold
+  if (!(vcut > VMIN) || !(vcut < 1.)) {
+    throw std::invalid_argument("StochasticLossTable: vcut must be between 1e-5 and 1.");
+  }
+
+  // the fraction of each loss that is continuous, and the
+  // number of catastrophic losses per unit of beta
+  PerProcess<double> continuous;
+  PerProcess<double> stochastic;
+
+  for (std::size_t p = 0; p < NPROCESSES; ++p) {
+
+    // the spectrum of this process
+    const auto phi{spectrum(static_cast<LossProcess>(p))};
+
+    // the energy lost below and above vcut - we integrate in ln(v)
+    const auto energy{[&](const double x) { return phi(std::exp(x)) * std::exp(x); }};
+    const auto below{integrate(energy, std::log(VMIN), std::log(vcut))};
+    const auto above{integrate(energy, std::log(vcut), 0.)};
+
+    // the cumulative number of losses above vcut
+    const auto h{-std::log(vcut) / NSAMPLES};
+    std::vector<double> cdf(NSAMPLES + 1, 0.);
+    for (int i = 1; i <= NSAMPLES; ++i) {
+      const auto x{std::log(vcut) + i * h};
+      cdf[i] = cdf[i - 1] + 0.5 * h * (phi(std::exp(x - h)) + phi(std::exp(x)));
+    }
+
+    continuous[p] = below / (below + above);
+    stochastic[p] = cdf.back() / (below + above);
+
+    // and invert the CDF at evenly-spaced quantiles
+    for (std::size_t k = 0; k < NQUANTILES; ++k) {
+
+      // the number of losses below this quantile
+      const auto target{cdf.back() * static_cast<double>(k) / (NQUANTILES - 1)};
+
+      // the first sample above this quantile
+      const auto upper{std::upper_bound(cdf.begin(), cdf.end(), target)};
+      const auto i{std::clamp(static_cast<int>(upper - cdf.begin()), 1, NSAMPLES)};
+
+      // and interpolate within this sample
+      const auto f{std::min((target - cdf[i - 1]) / (cdf[i] - cdf[i - 1]), 1.)};
+      logv_[p][k] = std::log(vcut) + (i - 1 + f) * h;
+    }
+  }
+
+  // evaluate the continuous beta and the rate of each process at every node
+  std::vector<double> betas(EnergyLossTable::NBINS + 1);
+  for (auto& rate : rates_) rate.resize(EnergyLossTable::NBINS + 1);
+  for (int i = 0; i <= EnergyLossTable::NBINS; ++i) {
+
+    // the contribution of each process to beta(E)
+    const auto [em, nuclear]{
+        EnergyLossTable::contributions(id, model, EnergyLossTable::EMIN + i * STEP)};
+    const PerProcess<double> beta{{BREMSSTRAHLUNG * em, (1. - BREMSSTRAHLUNG) * em, nuclear}};
+
+    // and split each contribution at vcut
+    betas[i] = 0.;
+    for (std::size_t p = 0; p < NPROCESSES; ++p) {
+      betas[i] += beta[p] * continuous[p];
+      rates_[p][i] = beta[p] * stochastic[p];
+    }
+  }
+
+  // the rate of change of the number of losses with log10(E),
+  // dT/du = R(E) ln(10) E / (alpha + beta_c E)
+  const auto dTdu{[&](const double energy, const double rate, const double beta) {
+    const auto E{std::pow(10., energy)};
+    return rate * std::log(10.) * E / (EnergyLossTable::ALPHA + beta * E);
+  }};
+
+  // the total rate at node i
+  const auto total{[&](const int i) {
+    double sum{0.};
+    for (const auto& rate : rates_) sum += rate[i];
+    return sum;
+  }};
+
+  // and integrate the number of losses up from EMIN with Simpson's rule
+  depths_.assign(EnergyLossTable::NBINS + 1, 0.);
+  for (int i = 1; i <= EnergyLossTable::NBINS; ++i) {
+    const auto lower{EnergyLossTable::EMIN + (i - 1) * STEP};
+    depths_[i] = depths_[i - 1] +
+                 (STEP / 6.) * (dTdu(lower, total(i - 1), betas[i - 1]) +
+                                4. * dTdu(lower + 0.5 * STEP,
+                                          0.5 * (total(i - 1) + total(i)),
+                                          0.5 * (betas[i - 1] + betas[i])) +
+                                dTdu(lower + STEP, total(i), betas[i]));
+  }
+
+  // and build the continuous loss table
+  continuous_ = EnergyLossTable(std::move(betas));
+}
+
+auto
+StochasticLossTable::get(const ParticleID id, const LeptonEnergyLossModel model)
+    -> const StochasticLossTable& {
+
+  // the models in the order of the enum
+  constexpr std::array<LeptonEnergyLossModel, 4> models{{LeptonEnergyLossModel::BDHM,
+                                                         LeptonEnergyLossModel::Soyez,
+                                                         LeptonEnergyLossModel::ALLM,
+                                                         LeptonEnergyLossModel::BS}};
+
+  // build every table once - the muons and then the taus
+  static const auto tables{[&]() {
+    std::vector<StochasticLossTable> built;
+    for (const auto lepton : {PDG::Muon, PDG::Tau}) {
+      for (const auto m : models) built.emplace_back(lepton, m);
+    }
+    return built;
+  }()};
+
+  // check that we have a supported lepton
+  if (std::abs(id) != PDG::Muon && std::abs(id) != PDG::Tau) {
+    throw std::invalid_argument("StochasticLossTable: only muons and taus are supported.");
+  }
+
+  // and return the table for this lepton and model
+  return tables[(std::abs(id) == PDG::Tau ? models.size() : 0) +
+                static_cast<std::size_t>(model)];
+}
+
+auto
+StochasticLossTable::rate(const LossProcess process, const LogEnergy energy) const -> double {
+  return interpolate(rates_[static_cast<std::size_t>(process)], energy);
+}
+
+auto
+StochasticLossTable::rate(const LogEnergy energy) const -> double {
+  double total{0.};
+  for (const auto& rate : rates_) total += interpolate(rate, energy);
+  return total;
+}
+
+auto
+StochasticLossTable::next_loss(const LogEnergy energy) const -> LogEnergy {
+
+  // the number of losses that remain after the next loss
+  const auto remaining{interpolate(depths_, energy) - random::exponential(1.)};
+
+  // if this is negative, the lepton ranges out first
+  if (remaining <= 0.) return EnergyLossTable::EMIN;
+
+  // find the first node with more losses
+  const auto upper{std::upper_bound(depths_.begin(), depths_.end(), remaining)};
+  const auto i{std::clamp(static_cast<int>(upper - depths_.begin()), 1, EnergyLossTable::NBINS)};
+
+  // and invert the linear interpolation of the number of losses
+  const auto f{(remaining - depths_[i - 1]) / (depths_[i] - depths_[i - 1])};
+  return EnergyLossTable::EMIN + (i - 1 + std::min(f, 1.)) * STEP;
+}
+
+auto
+StochasticLossTable::sample_process(const LogEnergy energy) const -> LossProcess {
+
+  // pick a random point in the total rate
+  auto target{random::uniform<double>() * rate(energy)};
+
+  // and find the process that contains it
+  for (std::size_t p = 0; p + 1 < NPROCESSES; ++p) {
+    target -= interpolate(rates_[p], energy);
+    if (target < 0.) return static_cast<LossProcess>(p);
+  }
+
+  return static_cast<LossProcess>(NPROCESSES - 1);
+}
+
+auto
+StochasticLossTable::sample_fraction(const LossProcess process) const -> double {
+
+  // the quantiles of this process
+  const auto& logv{logv_[static_cast<std::size_t>(process)]};
+
+  // pick a random quantile
+  const auto x{random::uniform<double>() * (NQUANTILES - 1)};
+  const auto k{std::min(static_cast<std::size_t>(x), NQUANTILES - 2)};
+
+  // and interpolate between the two quantiles around it
+  return std::exp(logv[k] + (x - k) * (logv[k + 1] - logv[k]));
+}
+
+auto
+StochasticLossTable::interaction(const LossProcess process) -> InteractionType {
+  switch (process) {
+  case LossProcess::Bremsstrahlung:
+    return interactions::Bremsstrahlung;
+  case LossProcess::PairProduction:
+    return interactions::PairProduction;
+  case LossProcess::Photonuclear:
+  default:
+    return interactions::Photonuclear;
+  } // END: switch (process)
+}
@@ -19,18 +19,20 @@ Tau::get_interaction() const -> InteractionInfo {
 auto
 Tau::get_decay_product() const -> std::unique_ptr<Particle> {
 
-  // get a random decay from the decay table
-  const auto decay{decaytable_.random_final_state()};
+  // get a random decay from the decay table - taus from tau neutrino
+  // charged current interactions are left-handed
+  const auto decay{TauDecayTable::get().random_final_state(energy_, -1.)};
 
   // we currently only generate neutrinos from the decay
   // interactions and we currently only generate the
-  // neutrino with the highest neutrino.
+  // neutrino with the highest neutrino. The table stores the
+  // fraction of the tau energy, so convert it to log10(eV).
   if (decay.nu_tau >= decay.nu_e && decay.nu_tau >= decay.nu_muon) {
-    return std::make_unique<TauNeutrino>(decay.nu_tau);
+    return std::make_unique<TauNeutrino>(energy_ + log10(decay.nu_tau));
   } else if (decay.nu_muon >= decay.nu_e && decay.nu_muon >= decay.nu_tau) {
-    return std::make_unique<MuonNeutrino>(decay.nu_muon);
+    return std::make_unique<MuonNeutrino>(energy_ + log10(decay.nu_muon));
   } else {
-    return std::make_unique<ElectronNeutrino>(decay.nu_e);
+    return std::make_unique<ElectronNeutrino>(energy_ + log10(decay.nu_e));
   }
 
   // and we should never get here.
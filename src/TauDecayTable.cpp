@@ -1,60 +1,481 @@
-#include <fstream>
-#include <string>
-
 #include "apricot/particles/TauDecayTable.hpp"
+#include "apricot/EmbeddedData.hpp"
 #include "apricot/Random.hpp"
 
-#include <filesystem>
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace apricot;
 
-auto TauDecayTable::load_decay_table() const -> decltype(finalstates_) {
+namespace {
+
+  /**
+   * The magic bytes at the start of every binary table.
+   */
+  constexpr char MAGIC[8]{'A', 'P', 'T', 'A', 'U', 'D', 'K', '1'};
+
+  /**
+   * The header of a binary table.
+   *
+   * This is followed by the (nbins + 1) uint64 offsets of the first
+   * row of each bin and then the rows of every bin.
+   */
+  struct Header {
+    char magic[8];                ///< The magic bytes.
+    std::uint64_t nstates;        ///< The number of rows.
+    std::uint32_t nenergies;      ///< The number of energy bins.
+    std::uint32_t npolarizations; ///< The number of polarization bins.
+    double emin;                  ///< The lower edge of the energy bins [log10(eV)].
+    double emax;                  ///< The upper edge of the energy bins [log10(eV)].
+  };
+
+  // the rows that follow the header are 8-byte aligned
+  static_assert(sizeof(Header) == 40 && sizeof(TauDecayTable::Row) == 32);
+
+  /**
+   * Build the rows, and Walker alias table, of one bin.
+   *
+   * @param states     The decay states in this bin.
+   * @param weights    The weight of each state.
+   */
+  auto
+  build(const std::vector<TauDecayTable::State>& states, const std::vector<double>& weights)
+      -> std::vector<TauDecayTable::Row> {
+
+    // the number of rows in this bin
+    const auto n{states.size()};
+
+    // the probabilities scaled so that their mean is one
+    const auto total{std::accumulate(weights.begin(), weights.end(), 0.)};
+    std::vector<double> scaled(n);
+    for (std::size_t i = 0; i < n; ++i) scaled[i] = weights[i] * n / total;
+
+    // split the rows into those below and above the mean
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < n; ++i) {
+      (scaled[i] < 1. ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // every row starts as its own alias
+    std::vector<TauDecayTable::Row> rows(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < TauDecayTable::NPARTICLES; ++j) {
+        rows[i].fractions[j] = static_cast<float>(states[i][j]);
+      }
+      rows[i].probability = 1.f;
+      rows[i].alias       = static_cast<std::uint32_t>(i);
+    }
+
+    // and fill each small row with part of a large row
+    while (!small.empty() && !large.empty()) {
+      const auto lower{small.back()};
+      const auto upper{large.back()};
+      small.pop_back();
+
+      // the small row is kept with its scaled probability
+      rows[lower].probability = static_cast<float>(scaled[lower]);
+      rows[lower].alias       = upper;
+
+      // and the large row gives up the rest
+      scaled[upper] -= 1. - scaled[lower];
+      if (scaled[upper] < 1.) {
+        large.pop_back();
+        small.push_back(upper);
+      }
+    }
+
+    return rows;
+  }
+
+  /**
+   * The shared state of the default table.
+   */
+  struct Defaults {
+    std::mutex mutex;                                   ///< Guards `tables`.
+    std::vector<std::unique_ptr<TauDecayTable>> tables; ///< Every default table (kept alive).
+    std::atomic<const TauDecayTable*> current{nullptr}; ///< The current default table.
+  };
+
+  /**
+   * Get the shared state of the default table.
+   */
+  auto
+  defaults() -> Defaults& {
+    static Defaults state;
+    return state;
+  }
+
+} // namespace
+
+TauDecayTable::TauDecayTable(const std::string& filename) {
 
   // try and open the file
-  // std::ifstream
-  std::ifstream table{std::string(DATA_DIRECTORY)+std::string("/data/particles/tau/")+filename_};
-  // std::ifstream table{std::string("data/particles/tau/") + filename_};
+  const auto descriptor{::open(filename.c_str(), O_RDONLY)};
+  if (descriptor < 0) {
+    throw std::runtime_error("Unable to open tau decay table '" + filename + "'.");
+  }
 
-  // check that it is good to read
-  if (!table.good()) {
-    std::cout << std::string(DATA_DIRECTORY)
-              << std::string("/data/particles/tau/") + filename_ << "\n";
-    throw std::runtime_error("Unable to open tau decay file.");
+  // get the size of the file
+  struct stat info;
+  if (::fstat(descriptor, &info) != 0) {
+    ::close(descriptor);
+    throw std::runtime_error("Unable to read tau decay table '" + filename + "'.");
   }
+  const auto bytes{static_cast<std::size_t>(info.st_size)};
+
+  // check for the magic bytes of a binary table
+  char magic[sizeof(MAGIC)]{};
+  const bool binary{bytes >= sizeof(Header) &&
+                    ::pread(descriptor, magic, sizeof(magic), 0) ==
+                        static_cast<ssize_t>(sizeof(magic)) &&
+                    std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0};
 
-  // create a file to load the data into
-  std::decay_t<decltype(finalstates_)> states;
+  // a text table is parsed into a single bin in memory
+  if (!binary) {
+    ::close(descriptor);
 
-  // walk through the file adding data
-  for (size_t state = 0; state < nstates_; ++state) {
-    for (size_t pid = 0; pid < nparticles_; ++pid) {
-      table >> states[state * nparticles_ + pid];
+    // parse the states with uniform weights
+    adopt(parse(filename), {});
+    return;
+  }
+
+  // otherwise, map the whole file
+  mapping_ = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::runtime_error("Unable to map tau decay table '" + filename + "'.");
+  }
+  size_ = bytes;
+
+  // read the header
+  Header header;
+  std::memcpy(&header, mapping_, sizeof(Header));
+  binning_.nenergies      = static_cast<int>(header.nenergies);
+  binning_.npolarizations = static_cast<int>(header.npolarizations);
+  binning_.emin           = header.emin;
+  binning_.emax           = header.emax;
+  nstates_                = header.nstates;
+
+  // the number of bins and the size that this table should have
+  const auto nbins{static_cast<std::size_t>(header.nenergies) * header.npolarizations};
+  const auto expected{sizeof(Header) + (nbins + 1) * sizeof(std::uint64_t) +
+                      nstates_ * sizeof(Row)};
+
+  // unmap the table if it is invalid
+  const auto invalid{[&](const std::string& message) {
+    ::munmap(mapping_, size_);
+    mapping_ = nullptr;
+    return std::runtime_error("'" + filename + "' " + message);
+  }};
+
+  // check that the header is consistent with the file
+  if (nbins == 0 || nstates_ == 0 || !(header.emin < header.emax) || bytes != expected) {
+    throw invalid("is not a valid tau decay table.");
+  }
+
+  // point the table into the mapping
+  const auto* start{static_cast<const char*>(mapping_)};
+  offsets_ = reinterpret_cast<const std::uint64_t*>(start + sizeof(Header));
+  rows_    = reinterpret_cast<const Row*>(start + sizeof(Header) +
+                                       (nbins + 1) * sizeof(std::uint64_t));
+
+  // and check that every bin is a valid, non-empty range of rows
+  for (std::size_t bin = 0; bin < nbins; ++bin) {
+    if (!(offsets_[bin] < offsets_[bin + 1])) throw invalid("has an empty bin.");
+  }
+  if (offsets_[0] != 0 || offsets_[nbins] != nstates_) throw invalid("has invalid bins.");
+}
+
+TauDecayTable::TauDecayTable(const std::vector<State>& states,
+                             const std::vector<double>& weights) {
+  adopt(states, weights);
+}
+
+auto
+TauDecayTable::adopt(const std::vector<State>& states, const std::vector<double>& weights)
+    -> void {
+
+  // check that we have a valid set of states
+  if (states.empty()) {
+    throw std::invalid_argument("TauDecayTable: a table needs at least one decay.");
+  }
+  if (!weights.empty() && weights.size() != states.size()) {
+    throw std::invalid_argument("TauDecayTable: there must be one weight for each decay.");
+  }
+  for (const auto weight : weights) {
+    if (!(weight > 0.) || !std::isfinite(weight)) {
+      throw std::invalid_argument("TauDecayTable: weights must be positive.");
     }
   }
 
-  // and return the array
-  return states;
+  // build the rows of the single bin
+  owned_rows_    = build(states, weights.empty() ? std::vector<double>(states.size(), 1.) : weights);
+  owned_offsets_ = {0, states.size()};
+
+  // and point the table at them
+  nstates_ = states.size();
+  offsets_ = owned_offsets_.data();
+  rows_    = owned_rows_.data();
 }
 
-auto TauDecayTable::random_state() const
-    -> std::array<double, TauDecayTable::nparticles_> {
+TauDecayTable::~TauDecayTable() {
+  if (mapping_ != nullptr) ::munmap(mapping_, size_);
+  mapping_ = nullptr;
+}
 
-  // generate a random index into a state
-  const size_t start{size_t(random::uniform_int(0, nstates_) * nparticles_)};
+auto
+TauDecayTable::get() -> const TauDecayTable& {
 
-  // create a new smaller array to fill in the values
-  std::array<double, TauDecayTable::nparticles_> states;
+  // the current default table
+  auto& state{defaults()};
+  if (const auto* table{state.current.load(std::memory_order_acquire)}) return *table;
 
-  // and fill in the values
-  for (size_t idx = 0; idx < nparticles_; ++idx) {
-    states[idx] = finalstates_[start + idx];
+  // otherwise, load the table
+  std::lock_guard<std::mutex> lock{state.mutex};
+  if (state.current.load() == nullptr) {
+
+    // the compiled-in TAUOLA table (if it was available at build time)
+    const auto embedded{data::find_table("particles/tau/tau_decay_tauola.dat")};
+
+    // an override in the environment takes precedence
+    if (const auto* path{std::getenv("APRICOT_TAU_DECAY_TABLE")}) {
+      state.tables.push_back(std::make_unique<TauDecayTable>(std::string(path)));
+    } else if (embedded && embedded->columns == NPARTICLES) {
+
+      // copy the embedded rows into decay states
+      std::vector<State> states(embedded->rows);
+      for (std::size_t i = 0; i < states.size(); ++i) {
+        std::copy_n(embedded->values + i * NPARTICLES, NPARTICLES, states[i].begin());
+      }
+      state.tables.push_back(std::make_unique<TauDecayTable>(states));
+    } else {
+      // and fall back to the file in the data directory
+      state.tables.push_back(std::make_unique<TauDecayTable>(
+          std::string(DATA_DIRECTORY) + "/data/particles/tau/tau_decay_tauola.dat"));
+    }
+
+    state.current.store(state.tables.back().get(), std::memory_order_release);
+  }
+
+  return *state.current.load();
+}
+
+auto
+TauDecayTable::set_default(const std::string& filename) -> void {
+
+  // load the table before we replace the current table
+  auto table{std::make_unique<TauDecayTable>(filename)};
+
+  // and make it the default
+  auto& state{defaults()};
+  std::lock_guard<std::mutex> lock{state.mutex};
+  state.tables.push_back(std::move(table));
+  state.current.store(state.tables.back().get(), std::memory_order_release);
+}
+
+auto
+TauDecayTable::write(const std::string& filename,
+                     const std::vector<State>& states,
+                     const std::vector<double>& weights,
+                     const std::vector<LogEnergy>& energies,
+                     const std::vector<double>& polarizations,
+                     const Binning& binning) -> void {
+
+  // check that we have a valid binning
+  if (binning.nenergies < 1 || binning.npolarizations < 1 || !(binning.emin < binning.emax)) {
+    throw std::invalid_argument("TauDecayTable: invalid binning.");
+  }
+
+  // and that every state has what it needs
+  const auto n{states.size()};
+  if ((!weights.empty() && weights.size() != n) ||
+      (binning.nenergies > 1 && energies.size() != n) ||
+      (binning.npolarizations > 1 && polarizations.size() != n)) {
+    throw std::invalid_argument(
+        "TauDecayTable: weights, energies, and polarizations must match the states.");
+  }
+
+  // split the states into their bins
+  const auto nbins{static_cast<std::size_t>(binning.nenergies) * binning.npolarizations};
+  std::vector<std::vector<State>> binned(nbins);
+  std::vector<std::vector<double>> binweights(nbins);
+  for (std::size_t i = 0; i < n; ++i) {
+
+    // the energy and polarization bin of this state
+    const auto ie{binning.nenergies == 1
+                      ? 0
+                      : std::clamp(static_cast<int>(std::floor((energies[i] - binning.emin) /
+                                                               (binning.emax - binning.emin) *
+                                                               binning.nenergies)),
+                                   0,
+                                   binning.nenergies - 1)};
+    const auto ip{binning.npolarizations == 1
+                      ? 0
+                      : std::clamp(static_cast<int>(std::floor(0.5 * (polarizations[i] + 1.) *
+                                                               binning.npolarizations)),
+                                   0,
+                                   binning.npolarizations - 1)};
+
+    // check that the weight is valid
+    const auto weight{weights.empty() ? 1. : weights[i]};
+    if (!(weight > 0.) || !std::isfinite(weight)) {
+      throw std::invalid_argument("TauDecayTable: weights must be positive.");
+    }
+
+    binned[ie * binning.npolarizations + ip].push_back(states[i]);
+    binweights[ie * binning.npolarizations + ip].push_back(weight);
+  }
+
+  // build the header and the offsets of each bin
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.nstates        = n;
+  header.nenergies      = static_cast<std::uint32_t>(binning.nenergies);
+  header.npolarizations = static_cast<std::uint32_t>(binning.npolarizations);
+  header.emin           = binning.emin;
+  header.emax           = binning.emax;
+  std::vector<std::uint64_t> offsets(nbins + 1, 0);
+  for (std::size_t bin = 0; bin < nbins; ++bin) {
+    if (binned[bin].empty()) {
+      throw std::invalid_argument("TauDecayTable: every bin needs at least one state.");
+    }
+    offsets[bin + 1] = offsets[bin] + binned[bin].size();
+  }
+
+  // try and open the file
+  std::ofstream file{filename, std::ios::binary};
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open '" + filename + "' for writing.");
+  }
+
+  // write the header and offsets
+  file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  file.write(reinterpret_cast<const char*>(offsets.data()),
+             static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+
+  // and the rows of every bin
+  for (std::size_t bin = 0; bin < nbins; ++bin) {
+    const auto rows{build(binned[bin], binweights[bin])};
+    file.write(reinterpret_cast<const char*>(rows.data()),
+               static_cast<std::streamsize>(rows.size() * sizeof(Row)));
+  }
+
+  // check that everything was written
+  if (!file) {
+    throw std::runtime_error("Unable to write tau decay table '" + filename + "'.");
+  }
+}
+
+auto
+TauDecayTable::convert(const std::string& text, const std::string& binary) -> void {
+  write(binary, parse(text));
+}
+
+auto
+TauDecayTable::parse(const std::string& filename) -> std::vector<State> {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open tau decay table '" + filename + "'.");
+  }
+
+  // the states in the file
+  std::vector<State> states;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // read every value on this row
+    std::istringstream row{line};
+    std::vector<double> values;
+    for (double value; row >> value;) values.push_back(value);
+
+    // skip any empty lines
+    if (values.empty() && row.eof()) continue;
+
+    // the first line of a NuTauSim table is the number of decays and particles
+    if (states.empty() && values.size() == 2 && row.eof()) continue;
+
+    // check that we have a valid row
+    if (values.size() != NPARTICLES || !row.eof()) {
+      throw std::runtime_error(filename + ":" + std::to_string(lineno) + ": expected " +
+                               std::to_string(NPARTICLES) + " energy fractions.");
+    }
+
+    State state;
+    std::copy(values.begin(), values.end(), state.begin());
+    states.push_back(state);
+  }
+
+  // we need at least one decay
+  if (states.empty()) {
+    throw std::runtime_error("No tau decays found in '" + filename + "'.");
   }
 
-  // and return the corresponding FinalState
   return states;
 }
 
-auto TauDecayTable::random_final_state() const -> TauDecayProducts {
-  return TauDecayProducts(random_state());
+auto
+TauDecayTable::random_final_state(const LogEnergy energy, const double polarization) const
+    -> TauDecayProducts {
+
+  // the energy and polarization bin of this tau
+  const auto ie{binning_.nenergies == 1
+                    ? 0
+                    : std::clamp(static_cast<int>((energy - binning_.emin) /
+                                                  (binning_.emax - binning_.emin) *
+                                                  binning_.nenergies),
+                                 0,
+                                 binning_.nenergies - 1)};
+  const auto ip{binning_.npolarizations == 1
+                    ? 0
+                    : std::clamp(static_cast<int>(0.5 * (polarization + 1.) *
+                                                  binning_.npolarizations),
+                                 0,
+                                 binning_.npolarizations - 1)};
+  const auto bin{static_cast<std::size_t>(ie) * binning_.npolarizations + ip};
+
+  // the rows of this bin
+  const auto* rows{rows_ + offsets_[bin]};
+  const auto n{offsets_[bin + 1] - offsets_[bin]};
+
+  // a uniform column of the alias table, and the fraction within it
+  const auto u{random::uniform<double>() * n};
+  const auto column{std::min(static_cast<std::uint64_t>(u), n - 1)};
+
+  // keep the column, or take its alias
+  const auto& chosen{u - column < rows[column].probability
+                         ? rows[column]
+                         : rows[std::min<std::uint64_t>(rows[column].alias, n - 1)]};
+
+  // and convert it into a decay
+  State state;
+  std::copy(std::begin(chosen.fractions), std::end(chosen.fractions), state.begin());
+  return TauDecayProducts(state);
 }
@@ -0,0 +1,89 @@
+#include "apricot/propagators/TauExitPropagator.hpp"
+#include "apricot/Detector.hpp"
+#include "apricot/Earth.hpp"
+#include "apricot/Flux.hpp"
+#include "apricot/Interaction.hpp"
+#include "apricot/Source.hpp"
+#include "apricot/particles/ChargedLepton.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+TauExitPropagator::TauExitPropagator(const Earth& earth,
+                                     const std::shared_ptr<TauExitTable>& table) :
+    Propagator(earth), table_(table) {
+
+  // we need a table to sample from
+  if (table_ == nullptr) {
+    throw std::invalid_argument("TauExitPropagator: a TauExitTable is required.");
+  }
+}
+
+auto
+TauExitPropagator::propagate(Source& source, Flux& flux, const Detector& detector) const
+    -> InteractionTree {
+
+  // use the physics models of this propagator on this thread
+  const PhysicsConfig::Scope physics{get_physics()};
+
+  // create the tree to store the particles
+  InteractionTree tree;
+
+  // random pick a new particle from this source
+  const auto particle{flux.get_particle()};
+
+  // randomly pick a new start location and direction
+  const auto [location, direction]{source.get_origin()};
+
+  // check if this is a good particle
+  if (!detector.is_good(particle, location, direction)) return tree;
+
+  // only tau neutrinos can create taus
+  if (std::abs(particle->get_id()) != PDG::TauNeutrino) return tree;
+
+  // compute the dot product weight for this trial
+  const double weight{location.normalized().dot(direction)};
+
+  // the intersections of the trajectory with the surface are at
+  // distances -b +/- sqrt(b^2 - c) along the trajectory
+  const auto Rearth{earth_.radius(location)};
+  const auto b{location.dot(direction)};
+  const auto c{location.squaredNorm() - Rearth * Rearth};
+
+  // if the trajectory misses the Earth, or has already left it, there is no tau
+  if (b * b - c <= 0. || -b + std::sqrt(b * b - c) <= 0.) return tree;
+
+  // the exit point of the trajectory
+  const CartesianCoordinate exit{location + (-b + std::sqrt(b * b - c)) * direction};
+
+  // the emergence angle of the chord at the exit point [degrees]
+  const auto angle{std::asin(std::clamp(exit.normalized().dot(direction), 0., 1.)) * 180. /
+                   M_PI};
+
+  // sample an exiting tau from the table
+  const auto energy{table_->sample(particle->get_energy(), angle)};
+  if (!energy) return tree;
+
+  // the tau decays after a random decay length in the air
+  ParticlePtr tau{std::make_unique<Tau>(*energy)};
+  tau->set_weight(particle->get_weight());
+  const auto decay{exit + static_cast<const Tau&>(*tau).decay_length() * direction};
+
+  // check whether the detector cuts the tau here
+  if (detector.cut(tau, decay, direction)) return tree;
+
+  // and whether the decay is detectable
+  if (detector.detectable(InteractionInfo(interactions::Decay, -1.), tau, decay, direction)) {
+
+    // compute the altitude of the decay
+    const auto altitude{decay.norm() - earth_.radius(decay)};
+
+    // and return the decay
+    tree.emplace_back(std::make_unique<Interaction>(
+        tau, interactions::Decay, decay, direction, weight, altitude));
+  }
+
+  return tree;
+}
@@ -0,0 +1,436 @@
+#include "apricot/propagators/TauExitTable.hpp"
+#include "apricot/Earth.hpp"
+#include "apricot/PhysicsConfig.hpp"
+#include "apricot/Random.hpp"
+#include "apricot/particles/ChargedLepton.hpp"
+#include "apricot/particles/InelasticityTable.hpp"
+#include "apricot/particles/Neutrino.hpp"
+#include "apricot/particles/NeutrinoCrossSectionTable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The number of segments in the column depth of each chord.
+   */
+  constexpr int NSEGMENTS{20000};
+
+  /**
+   * The magic bytes at the start of every table file.
+   */
+  constexpr char MAGIC[8]{'A', 'P', 'T', 'A', 'U', 'E', 'X', '1'};
+
+  /**
+   * The column depth along a chord that emerges at an angle.
+   */
+  struct Column {
+    double length;                ///< The length of the chord [km].
+    std::vector<double> grammage; ///< The grammage from the entry to each node [g/cm^2].
+  };
+
+  /**
+   * Tabulate the column depth along the chord that exits at the
+   * North Pole with a given emergence angle.
+   *
+   * @param earth    The Earth model.
+   * @param angle    The emergence angle [degrees].
+   */
+  auto
+  tabulate(const Earth& earth, const double angle) -> Column {
+
+    // the exit point at the North Pole and the direction of the chord
+    const auto elevation{angle * M_PI / 180.};
+    const CartesianCoordinate pole{0., 0., earth.radius(CartesianCoordinate{0., 0., 1.})};
+    const Vector direction{std::cos(elevation), 0., std::sin(elevation)};
+
+    // the length of the chord and its entry point
+    const auto length{2. * pole.norm() * std::sin(elevation)};
+    const CartesianCoordinate entry{pole - length * direction};
+
+    // and integrate the grammage of each segment
+    Column column{length, std::vector<double>(NSEGMENTS + 1, 0.)};
+    for (int k = 0; k < NSEGMENTS; ++k) {
+      const CartesianCoordinate start{entry + (length * k / NSEGMENTS) * direction};
+      const CartesianCoordinate end{entry + (length * (k + 1) / NSEGMENTS) * direction};
+      column.grammage[k + 1] =
+          column.grammage[k] + earth.grammage(start, end, earth.radius(0.5 * (start + end)));
+    }
+
+    return column;
+  }
+
+  /**
+   * Throw a tau neutrino along a chord and return the energy of an exiting tau.
+   *
+   * @param column    The column depth along the chord.
+   * @param energy    The neutrino energy [log10(eV)].
+   * @param physics   The physics models to use.
+   */
+  auto
+  trial(const Column& column, LogEnergy energy, const PhysicsConfig& physics)
+      -> std::optional<LogEnergy> {
+
+    // the shared physics tables
+    const auto& xsections{*physics.cross_sections};
+    const auto& inelasticity{InelasticityTable::get(physics.y_factor_model)};
+    const auto& losses{EnergyLossTable::get(PDG::Tau, physics.energy_loss_model)};
+
+    // the total grammage of the chord
+    const auto total{column.grammage.back()};
+
+    // the grammage that the neutrino has crossed
+    double grammage{0.};
+
+    // follow the neutrino until it makes a tau
+    while (true) {
+
+      // the interaction length and CC fraction at this energy
+      const auto [length, fraction]{xsections.lookup(energy)};
+
+      // move to the next interaction - if any
+      grammage += random::exponential<double>(1. / length);
+      if (grammage >= total) return std::nullopt;
+
+      // the energy of the outgoing lepton
+      energy += std::log10(1. - inelasticity.sample(energy));
+
+      // a charged current interaction creates a tau
+      if (random::uniform<double>() < fraction) break;
+
+      // a neutral current interaction continues with a lower energy
+      if (energy < NeutrinoCrossSectionTable::EMIN) return std::nullopt;
+    }
+
+    // check that the tau is above the range tables
+    if (!(energy > EnergyLossTable::EMIN)) return std::nullopt;
+
+    // the segment of the chord containing the interaction
+    const auto upper{std::upper_bound(column.grammage.begin(), column.grammage.end(), grammage)};
+    auto k{std::clamp(static_cast<int>(upper - column.grammage.begin()), 1, NSEGMENTS)};
+
+    // the length of each segment
+    const auto width{column.length / NSEGMENTS};
+
+    // the position of the interaction along this segment
+    const auto span{column.grammage[k] - column.grammage[k - 1]};
+    auto position{(k - 1 + (span > 0. ? (grammage - column.grammage[k - 1]) / span : 0.)) *
+                  width};
+
+    // the tau, and its random proper decay length c*tau [km]
+    const Tau tau{energy};
+    auto proper{tau.decay_length() / tau.gamma()};
+
+    // walk the tau to the end of each segment
+    for (; k <= NSEGMENTS; ++k) {
+
+      // the length and grammage of the rest of this segment
+      const auto distance{k * width - position};
+      const auto crossed{column.grammage[k] - grammage};
+
+      // the energy at the end of this segment
+      const auto after{losses.energy(energy, crossed)};
+
+      // the energy decays exponentially along the step with this rate [1/km]
+      const auto rate{distance > 0. ? std::log(10.) * (energy - after) / distance : 0.};
+
+      // the proper decay length elapsed in this segment, the integral of 1/gamma
+      const auto gamma0{std::pow(10., energy - tau.mass_)};
+      const auto gamma1{std::pow(10., after - tau.mass_)};
+      const auto elapsed{rate > 1e-12 ? (1. / gamma1 - 1. / gamma0) / rate : distance / gamma0};
+
+      // the tau decays inside the Earth
+      if (elapsed >= proper) return std::nullopt;
+
+      // otherwise, move to the end of this segment
+      proper -= elapsed;
+      energy   = after;
+      grammage = column.grammage[k];
+      position = k * width;
+
+      // and check if it has ranged out
+      if (energy <= EnergyLossTable::EMIN) return std::nullopt;
+    }
+
+    // the tau has reached the surface
+    return energy;
+  }
+
+  /**
+   * Write a contiguous range of values to a binary stream.
+   */
+  template <typename T>
+  auto
+  write(std::ofstream& file, const T* values, const std::size_t count) -> void {
+    file.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+  }
+
+  /**
+   * Read a contiguous range of values from a binary stream.
+   */
+  template <typename T>
+  auto
+  read(std::ifstream& file, T* values, const std::size_t count) -> void {
+    file.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+  }
+
+} // namespace
+
+TauExitTable::TauExitTable(const Earth& earth,
+                           const LogEnergy emin,
+                           const LogEnergy emax,
+                           const int nenergies,
+                           const std::vector<double>& angles,
+                           const int ntrials,
+                           const int nthreads) :
+    emin_(emin), emax_(emax), nenergies_(nenergies), nquantiles_(NQUANTILES), angles_(angles) {
+
+  // check that we have a valid table
+  validate();
+  if (ntrials < 1) {
+    throw std::invalid_argument("TauExitTable: we need at least one trial per cell.");
+  }
+
+  // the number of cells in the table
+  const auto nangles{static_cast<int>(angles_.size())};
+  const auto ncells{nenergies_ * nangles};
+
+  // tabulate the column depth of every chord
+  std::vector<Column> columns;
+  for (const auto angle : angles_) columns.push_back(tabulate(earth, angle));
+
+  // the workers use the physics models of the calling thread
+  const PhysicsConfig physics{PhysicsConfig::current()};
+
+  // make sure that the shared physics tables are built before we start
+  InelasticityTable::get(physics.y_factor_model);
+  EnergyLossTable::get(PDG::Tau, physics.energy_loss_model);
+
+  // a seed for every cell so that the table does not depend on the threads
+  std::vector<std::uint64_t> seeds(ncells);
+  for (auto& seed : seeds) seed = random::generator();
+
+  // the output tables
+  probability_.assign(ncells, 0.f);
+  quantiles_.assign(static_cast<std::size_t>(ncells) * (nquantiles_ + 1), 0.f);
+
+  // the next cell that has to be generated
+  std::atomic<int> next{0};
+
+  // generate cells until there are none left
+  const auto work{[&]() {
+    std::vector<double> exits;
+    for (int cell = next++; cell < ncells; cell = next++) {
+
+      // seed the generator of this thread for this cell
+      random::generator.seed(seeds[cell]);
+
+      // the energy and chord of this cell
+      const auto energy{emin_ + (emax_ - emin_) * (cell / nangles) / (nenergies_ - 1)};
+      const auto& column{columns[cell % nangles]};
+
+      // throw the neutrinos
+      exits.clear();
+      for (int n = 0; n < ntrials; ++n) {
+        if (const auto tau{trial(column, energy, physics)}) exits.push_back(*tau);
+      }
+
+      // save the exit probability
+      probability_[cell] = static_cast<float>(static_cast<double>(exits.size()) / ntrials);
+      if (exits.empty()) continue;
+
+      // and the quantiles of the exit energies
+      std::sort(exits.begin(), exits.end());
+      for (int j = 0; j <= nquantiles_; ++j) {
+        const auto x{static_cast<double>(j) * (exits.size() - 1) / nquantiles_};
+        const auto i{std::min(static_cast<std::size_t>(x), exits.size() - 1)};
+        const auto upper{std::min(i + 1, exits.size() - 1)};
+        quantiles_[static_cast<std::size_t>(cell) * (nquantiles_ + 1) + j] =
+            static_cast<float>(exits[i] + (x - i) * (exits[upper] - exits[i]));
+      }
+    }
+  }};
+
+  // and run the workers
+  const auto nworkers{nthreads > 0 ? nthreads
+                                   : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+  std::vector<std::thread> workers;
+  for (int w = 0; w < std::min(nworkers, ncells); ++w) workers.emplace_back(work);
+  for (auto& worker : workers) worker.join();
+}
+
+TauExitTable::TauExitTable(const std::string& filename) {
+
+  // try and open the file
+  std::ifstream file{filename, std::ios::binary};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open tau exit table '" + filename + "'.");
+  }
+
+  // check the magic bytes
+  char magic[sizeof(MAGIC)];
+  read(file, magic, sizeof(MAGIC));
+  if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("'" + filename + "' is not a tau exit table.");
+  }
+
+  // the shape of the table
+  std::uint32_t shape[3];
+  read(file, shape, 3);
+  nenergies_  = static_cast<int>(shape[0]);
+  nquantiles_ = static_cast<int>(shape[2]);
+
+  // the energy range
+  double energies[2];
+  read(file, energies, 2);
+  emin_ = energies[0];
+  emax_ = energies[1];
+
+  // check that the shape is sensible before we allocate anything
+  if (!file || shape[1] == 0 || shape[1] > 100'000 || nenergies_ < 2 ||
+      nenergies_ > 100'000 || nquantiles_ < 1 || nquantiles_ > 100'000) {
+    throw std::runtime_error("'" + filename + "' has an invalid tau exit table header.");
+  }
+
+  // and read the tables
+  const auto ncells{static_cast<std::size_t>(nenergies_) * shape[1]};
+  angles_.resize(shape[1]);
+  probability_.resize(ncells);
+  quantiles_.resize(ncells * (nquantiles_ + 1));
+  read(file, angles_.data(), angles_.size());
+  read(file, probability_.data(), probability_.size());
+  read(file, quantiles_.data(), quantiles_.size());
+
+  // check that we read the whole table
+  if (!file) {
+    throw std::runtime_error("'" + filename + "' is truncated.");
+  }
+
+  // and that it is valid
+  validate();
+}
+
+auto
+TauExitTable::save(const std::string& filename) const -> void {
+
+  // try and open the file
+  std::ofstream file{filename, std::ios::binary};
+
+  // check that it is good to write
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open '" + filename + "' for writing.");
+  }
+
+  // the header
+  const std::uint32_t shape[3]{static_cast<std::uint32_t>(nenergies_),
+                               static_cast<std::uint32_t>(angles_.size()),
+                               static_cast<std::uint32_t>(nquantiles_)};
+  const double energies[2]{emin_, emax_};
+  write(file, MAGIC, sizeof(MAGIC));
+  write(file, shape, 3);
+  write(file, energies, 2);
+
+  // and the tables
+  write(file, angles_.data(), angles_.size());
+  write(file, probability_.data(), probability_.size());
+  write(file, quantiles_.data(), quantiles_.size());
+
+  // check that everything was written
+  if (!file) {
+    throw std::runtime_error("Unable to write tau exit table '" + filename + "'.");
+  }
+}
+
+auto
+TauExitTable::validate() const -> void {
+
+  // check the energy grid
+  if (!(emin_ < emax_) || nenergies_ < 2) {
+    throw std::invalid_argument("TauExitTable: we need at least two increasing energies.");
+  }
+
+  // and the angles
+  if (angles_.empty() || !(angles_.front() > 0.) || !(angles_.back() <= 90.) ||
+      std::adjacent_find(angles_.begin(), angles_.end(), std::greater_equal<double>()) !=
+          angles_.end()) {
+    throw std::invalid_argument("TauExitTable: angles must be increasing in (0, 90] degrees.");
+  }
+}
+
+auto
+TauExitTable::locate(const LogEnergy energy, const double angle) const
+    -> std::tuple<int, double, int, double> {
+
+  // the fractional index of the energy
+  const auto x{std::clamp((energy - emin_) / (emax_ - emin_) * (nenergies_ - 1),
+                          0.,
+                          nenergies_ - 1.)};
+  const auto i{std::min(static_cast<int>(x), nenergies_ - 2)};
+
+  // the first angle above this angle
+  const auto upper{std::upper_bound(angles_.begin(), angles_.end(), angle)};
+  const auto nangles{static_cast<int>(angles_.size())};
+  const auto above{static_cast<int>(upper - angles_.begin())};
+  const auto j{std::max(std::min(above, nangles), 1) - 1};
+
+  // and the fraction between the two angles around it
+  const auto fy{j < nangles - 1 ? std::clamp((angle - angles_[j]) / (angles_[j + 1] - angles_[j]),
+                                             0.,
+                                             1.)
+                                : 0.};
+
+  return {i, x - i, j, fy};
+}
+
+auto
+TauExitTable::probability(const LogEnergy energy, const double angle) const -> double {
+
+  // the cell containing this energy and angle
+  const auto [i, fx, j, fy]{locate(energy, angle)};
+
+  // the exit probability of a node
+  const auto nangles{static_cast<int>(angles_.size())};
+  const auto node{[&](const int ie, const int ja) -> double {
+    return probability_[ie * nangles + std::min(ja, nangles - 1)];
+  }};
+
+  // and interpolate bilinearly
+  return (1. - fx) * ((1. - fy) * node(i, j) + fy * node(i, j + 1)) +
+         fx * ((1. - fy) * node(i + 1, j) + fy * node(i + 1, j + 1));
+}
+
+auto
+TauExitTable::sample(const LogEnergy energy, const double angle) const
+    -> std::optional<LogEnergy> {
+
+  // the cell containing this energy and angle
+  const auto [i, fx, j, fy]{locate(energy, angle)};
+
+  // pick one of the four nodes with the interpolation weights
+  const auto nangles{static_cast<int>(angles_.size())};
+  const auto ie{random::uniform<double>() < fx ? i + 1 : i};
+  const auto ja{std::min(random::uniform<double>() < fy ? j + 1 : j, nangles - 1)};
+  const auto cell{static_cast<std::size_t>(ie) * nangles + ja};
+
+  // check if a tau exits
+  if (!(random::uniform<double>() < probability_[cell])) return std::nullopt;
+
+  // the fractional index of a random quantile
+  const auto u{random::uniform<double>() * nquantiles_};
+  const auto k{std::min(static_cast<int>(u), nquantiles_ - 1)};
+
+  // and interpolate the inverse CDF
+  const auto* q{&quantiles_[cell * (nquantiles_ + 1) + k]};
+  return q[0] + (u - k) * (q[1] - q[0]);
+}
@@ -0,0 +1,84 @@
+#include "apricot/propagators/UHECRPropagator.hpp"
+#include "apricot/Detector.hpp"
+#include "apricot/Earth.hpp"
+#include "apricot/Flux.hpp"
+#include "apricot/Interaction.hpp"
+#include "apricot/Source.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace apricot;
+
+UHECRPropagator::UHECRPropagator(const Earth& earth,
+                                 const std::shared_ptr<SlantDepthTable>& table) :
+    Propagator(earth), table_(table) {
+
+  // if we were given a table, we are done
+  if (table_ != nullptr) return;
+
+  // otherwise we need an atmosphere to tabulate
+  if (earth.get_atmosphere() == nullptr) {
+    throw std::invalid_argument("UHECRPropagator: the Earth model has no atmosphere.");
+  }
+
+  // and build the table at the radius of the North Pole
+  table_ = std::make_shared<SlantDepthTable>(earth.get_atmosphere(),
+                                             earth.radius(CartesianCoordinate{0., 0., 1.}));
+}
+
+auto
+UHECRPropagator::propagate(Source& source, Flux& flux, const Detector& detector) const
+    -> InteractionTree {
+
+  // the table must describe the current atmosphere
+  if (table_->stale()) {
+    throw std::runtime_error("UHECRPropagator: the atmosphere has changed since the slant depth "
+                             "table was built; call `get_table()->rebuild()` first.");
+  }
+
+  // use the physics models of this propagator on this thread
+  const PhysicsConfig::Scope physics{get_physics()};
+
+  // create the tree to store the particles
+  InteractionTree tree;
+
+  // create a new particle and trajectory
+  auto [particle, location, direction, info]{new_trial(source, flux)};
+
+  // check if this is a good particle
+  if (!detector.is_good(particle, location, direction)) return tree;
+
+  // compute the dot product weight for this trial
+  const double weight{location.normalized().dot(direction)};
+
+  // the altitude and local zenith angle at the start of the trajectory
+  const auto radius{location.norm()};
+  const auto altitude{radius - earth_.radius(location)};
+  const auto zenith{std::acos(std::clamp(weight, -1., 1.))};
+
+  // find the distance at which we reach the interaction grammage
+  const auto distance{table_->distance(altitude, zenith, info.grammage_)};
+
+  // if we never reach it, there is no interaction
+  if (!std::isfinite(distance)) return tree;
+
+  // move the particle to the interaction point
+  location += distance * direction;
+
+  // check whether the detector cuts the particle here
+  if (detector.cut(particle, location, direction)) return tree;
+
+  // and whether the particle is detectable
+  if (detector.detectable(info, particle, location, direction)) {
+
+    // compute the altitude of the interaction
+    const auto interaction{location.norm() - earth_.radius(location)};
+
+    // and return the interaction that occured
+    tree.emplace_back(std::make_unique<Interaction>(
+        particle, info.type_, location, direction, weight, interaction));
+  }
+
+  return tree;
+}
@@ -0,0 +1,287 @@
+#include "apricot/earth/VoxelDensity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace apricot;
+
+VoxelDensity::VoxelDensity(const Vector& origin,
+                           const Vector& spacing,
+                           const std::array<int, 3>& shape,
+                           const std::vector<double>& densities,
+                           const std::vector<MaterialID>& materials) :
+    origin_(origin),
+    spacing_(spacing),
+    shape_(shape),
+    densities_(densities),
+    materials_(materials) {
+  validate();
+}
+
+VoxelDensity::VoxelDensity(const std::string& filename) :
+    origin_(Vector::Zero()), spacing_(Vector::Zero()), shape_{{0, 0, 0}} {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open voxel file '" + filename + "'.");
+  }
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // and read the keyword for this row
+    std::istringstream row{line};
+    std::string keyword;
+
+    // skip any empty lines
+    if (!(row >> keyword)) continue;
+
+    // a message prefix for any errors
+    const auto where{filename + ":" + std::to_string(lineno) + ": "};
+
+    // the grid must be defined before we can set any voxels
+    if ((keyword == "fill" || keyword == "voxel") && densities_.empty()) {
+      validate();
+    }
+
+    if (keyword == "origin") {
+      if (!(row >> origin_.x() >> origin_.y() >> origin_.z())) {
+        throw std::runtime_error(where + "expected 'origin <x> <y> <z>'.");
+      }
+    } else if (keyword == "spacing") {
+      if (!(row >> spacing_.x() >> spacing_.y() >> spacing_.z())) {
+        throw std::runtime_error(where + "expected 'spacing <dx> <dy> <dz>'.");
+      }
+    } else if (keyword == "shape") {
+      if (!(row >> shape_[0] >> shape_[1] >> shape_[2])) {
+        throw std::runtime_error(where + "expected 'shape <nx> <ny> <nz>'.");
+      }
+    } else if (keyword == "fill") {
+
+      // the material and density of every voxel
+      std::string material;
+      double density;
+      if (!(row >> material >> density)) {
+        throw std::runtime_error(where + "expected 'fill <material> <density>'.");
+      }
+
+      // and fill the grid
+      std::fill(densities_.begin(), densities_.end(), density);
+      std::fill(materials_.begin(), materials_.end(), material_from_string(material));
+
+    } else if (keyword == "voxel") {
+
+      // the index, material and density of this voxel
+      int i, j, k;
+      std::string material;
+      double density;
+      if (!(row >> i >> j >> k >> material >> density)) {
+        throw std::runtime_error(where + "expected 'voxel <i> <j> <k> <material> <density>'.");
+      }
+
+      // check that the voxel is inside the grid
+      if (i < 0 || j < 0 || k < 0 || i >= shape_[0] || j >= shape_[1] || k >= shape_[2]) {
+        throw std::runtime_error(where + "voxel index is outside the grid.");
+      }
+
+      // and save this voxel
+      const auto index{static_cast<std::size_t>(i + shape_[0] * (j + shape_[1] * k))};
+      densities_[index] = density;
+      materials_[index] = material_from_string(material);
+
+    } else {
+      throw std::runtime_error(where + "unknown keyword '" + keyword + "'.");
+    }
+
+  } // END: while (std::getline...
+
+  // a grid without any voxel rows is empty
+  if (densities_.empty()) validate();
+}
+
+auto
+VoxelDensity::validate() -> void {
+
+  // the voxels must have a positive size
+  if ((spacing_.array() <= 0.).any()) {
+    throw std::invalid_argument("VoxelDensity: the voxel spacing must be positive.");
+  }
+
+  // and there must be at least one voxel along each axis
+  if (*std::min_element(shape_.begin(), shape_.end()) <= 0) {
+    throw std::invalid_argument("VoxelDensity: the grid shape must be positive.");
+  }
+
+  // the total number of voxels in the grid
+  const auto nvoxels{static_cast<std::size_t>(shape_[0]) * shape_[1] * shape_[2]};
+
+  // if we have no voxels yet, create an empty (vacuum) grid
+  if (densities_.empty() && materials_.empty()) {
+    densities_.assign(nvoxels, 0.);
+    materials_.assign(nvoxels, materials::Vacuum);
+  }
+
+  // check that we have a value for every voxel
+  if (densities_.size() != nvoxels || materials_.size() != nvoxels) {
+    throw std::invalid_argument("VoxelDensity: expected " + std::to_string(nvoxels) +
+                                " densities and materials.");
+  }
+
+  // and compute the upper corner of the grid
+  upper_ = origin_ + (Eigen::Array3d(shape_[0], shape_[1], shape_[2]) * spacing_.array())
+                         .matrix();
+}
+
+auto
+VoxelDensity::index(const CartesianCoordinate& location) const -> std::size_t {
+
+  // the integer index along each axis - clamped for points on the edge
+  std::array<int, 3> idx;
+  for (int axis = 0; axis < 3; ++axis) {
+    const auto i{static_cast<int>((location[axis] - origin_[axis]) / spacing_[axis])};
+    idx[axis] = std::clamp(i, 0, shape_[axis] - 1);
+  }
+
+  return static_cast<std::size_t>(idx[0] + shape_[0] * (idx[1] + shape_[1] * idx[2]));
+}
+
+auto
+VoxelDensity::entry(const CartesianCoordinate& location, const Vector& direction) const
+    -> double {
+
+  // the entry and exit distance through the grid
+  double tmin{0.};
+  double tmax{std::numeric_limits<double>::infinity()};
+
+  // intersect the ray with each pair of planes (the slab method)
+  for (int axis = 0; axis < 3; ++axis) {
+
+    // a ray parallel to this slab must already be between the planes
+    if (std::abs(direction[axis]) < std::numeric_limits<double>::epsilon()) {
+      if (location[axis] < origin_[axis] || location[axis] >= upper_[axis]) {
+        return std::numeric_limits<double>::infinity();
+      }
+      continue;
+    }
+
+    // the distance to each of the planes
+    const auto t0{(origin_[axis] - location[axis]) / direction[axis]};
+    const auto t1{(upper_[axis] - location[axis]) / direction[axis]};
+
+    // and shrink the overlap of the slabs
+    tmin = std::max(tmin, std::min(t0, t1));
+    tmax = std::min(tmax, std::max(t0, t1));
+  }
+
+  // if the slabs don't overlap, we never enter the grid
+  if (tmin > tmax) return std::numeric_limits<double>::infinity();
+
+  return tmin;
+}
+
+auto
+VoxelDensity::walk(CartesianCoordinate& location,
+                   const Vector& direction,
+                   const double grammage,
+                   const double length) const -> double {
+
+  // the current voxel, the direction we step along each axis,
+  // the distance to the next boundary along each axis, and
+  // the distance between boundaries along each axis
+  std::array<int, 3> idx;
+  std::array<int, 3> step;
+  std::array<double, 3> tmax;
+  std::array<double, 3> tdelta;
+
+  // initialize the traversal along each axis
+  for (int axis = 0; axis < 3; ++axis) {
+
+    // the voxel containing the start of the ray
+    const auto i{static_cast<int>(
+        std::floor((location[axis] - origin_[axis]) / spacing_[axis]))};
+    idx[axis] = std::clamp(i, 0, shape_[axis] - 1);
+
+    // a ray parallel to this axis never crosses a boundary
+    if (std::abs(direction[axis]) < std::numeric_limits<double>::epsilon()) {
+      step[axis]   = 0;
+      tmax[axis]   = std::numeric_limits<double>::infinity();
+      tdelta[axis] = std::numeric_limits<double>::infinity();
+      continue;
+    }
+
+    // the direction of travel along this axis
+    step[axis] = direction[axis] > 0. ? 1 : -1;
+
+    // the location of the next boundary along this axis
+    const auto boundary{origin_[axis] + (idx[axis] + (step[axis] > 0)) * spacing_[axis]};
+
+    // and the distances to it, and between boundaries
+    tmax[axis]   = std::max(0., (boundary - location[axis]) / direction[axis]);
+    tdelta[axis] = spacing_[axis] / std::abs(direction[axis]);
+  }
+
+  // the distance we have travelled and the grammage we have crossed
+  double t{0.};
+  double crossed{0.};
+
+  // walk through the voxels until we interact or leave the grid
+  while (true) {
+
+    // the axis whose boundary we cross next
+    const int axis{tmax[0] < tmax[1] ? (tmax[0] < tmax[2] ? 0 : 2)
+                                     : (tmax[1] < tmax[2] ? 1 : 2)};
+
+    // the density of the current voxel in g/cm^3 * cm/km
+    const auto density{
+        1e5 * densities_[static_cast<std::size_t>(idx[0] +
+                                                  shape_[0] * (idx[1] + shape_[1] * idx[2]))]};
+
+    // the end of this voxel, or of the walk if that comes first
+    const auto end{std::min(tmax[axis], length)};
+
+    // the grammage across the rest of this voxel
+    const auto segment{density * (end - t)};
+
+    // if we reach our grammage in this voxel, stop exactly there
+    if (crossed + segment >= grammage) {
+      if (density > 0.) t += (grammage - crossed) / density;
+      location += t * direction;
+      return grammage;
+    }
+
+    // if we have walked our maximum length, stop at the end of the walk
+    if (end >= length) {
+      location += length * direction;
+      return crossed + segment;
+    }
+
+    // otherwise, step to the next voxel
+    crossed += segment;
+    t = tmax[axis];
+    idx[axis] += step[axis];
+
+    // if we have left the grid, step just outside it and finish
+    if (idx[axis] < 0 || idx[axis] >= shape_[axis]) {
+      location += (t + EDGE) * direction;
+      return crossed;
+    }
+
+    // and update the distance to the next boundary on this axis
+    tmax[axis] += tdelta[axis];
+
+  } // END: while (true)
+}
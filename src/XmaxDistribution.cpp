@@ -0,0 +1,188 @@
+#include "apricot/particles/XmaxDistribution.hpp"
+#include "apricot/Random.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace apricot;
+
+namespace {
+
+  /**
+   * The probability of the k'th stored quantile.
+   */
+  auto
+  probability_of(const std::size_t k) -> double {
+    return (static_cast<double>(k) + 0.5) / XmaxDistribution::NQUANTILES;
+  }
+
+  /**
+   * The Euler-Mascheroni constant.
+   */
+  constexpr double EULER{0.57721566490153286};
+
+  /**
+   * pi
+   */
+  constexpr double PI{3.14159265358979323846};
+
+} // namespace
+
+XmaxDistribution::XmaxDistribution(const std::vector<LogEnergy>& energies,
+                                   const std::vector<double>& xmax) {
+  compile(energies, xmax);
+}
+
+XmaxDistribution::XmaxDistribution(const std::string& filename) {
+
+  // try and open the file
+  std::ifstream file{filename};
+
+  // check that it is good to read
+  if (!file.good()) {
+    throw std::runtime_error("Unable to open Xmax file '" + filename + "'.");
+  }
+
+  // the energy and Xmax of each shower
+  std::vector<LogEnergy> energies;
+  std::vector<double> xmax;
+
+  // the current line that we are reading
+  std::string line;
+  int lineno{0};
+
+  // walk through the file one line at a time
+  while (std::getline(file, line)) {
+    ++lineno;
+
+    // strip any comments from the line
+    line = line.substr(0, line.find('#'));
+
+    // skip any empty lines
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+    // and read the energy and Xmax of this shower
+    std::istringstream row{line};
+    double energy{0.};
+    double grammage{0.};
+    if (!(row >> energy >> grammage) || !(grammage > 0.)) {
+      throw std::runtime_error(filename + ":" + std::to_string(lineno) +
+                               ": expected '<energy> <Xmax>'.");
+    }
+    energies.push_back(energy);
+    xmax.push_back(grammage);
+  }
+
+  compile(energies, xmax);
+}
+
+auto
+XmaxDistribution::gumbel(const std::function<double(LogEnergy)>& mean,
+                         const std::function<double(LogEnergy)>& sigma,
+                         const LogEnergy emin,
+                         const LogEnergy emax,
+                         const int nenergies) -> XmaxDistribution {
+
+  // check that we have a valid energy grid
+  if (nenergies < 2 || !(emin < emax)) {
+    throw std::invalid_argument("XmaxDistribution: invalid energy grid.");
+  }
+
+  XmaxDistribution distribution;
+  distribution.inverse_step_ = (nenergies - 1.) / (emax - emin);
+  distribution.energies_.resize(nenergies);
+  distribution.quantiles_.resize(nenergies * NQUANTILES);
+
+  // fill in the quantiles at each energy
+  for (int i = 0; i < nenergies; ++i) {
+    const auto energy{emin + (emax - emin) * i / (nenergies - 1.)};
+    distribution.energies_[i] = energy;
+
+    // the scale and location that give this mean and RMS
+    const auto beta{sigma(energy) * std::sqrt(6.) / PI};
+    const auto mu{mean(energy) - EULER * beta};
+
+    // and the inverse CDF of the Gumbel distribution
+    for (std::size_t k = 0; k < NQUANTILES; ++k) {
+      distribution.quantiles_[i * NQUANTILES + k] =
+          mu - beta * std::log(-std::log(probability_of(k)));
+    }
+  }
+
+  return distribution;
+}
+
+auto
+XmaxDistribution::compile(const std::vector<LogEnergy>& energies, const std::vector<double>& xmax)
+    -> void {
+
+  // check that we have a valid set of showers
+  if (energies.empty() || energies.size() != xmax.size()) {
+    throw std::invalid_argument(
+        "XmaxDistribution: there must be at least one shower and one Xmax per energy.");
+  }
+
+  // sort the showers by energy and then Xmax
+  std::vector<std::pair<LogEnergy, double>> showers(energies.size());
+  for (std::size_t i = 0; i < showers.size(); ++i) showers[i] = {energies[i], xmax[i]};
+  std::sort(showers.begin(), showers.end());
+
+  // and walk through each group of showers with the same energy
+  for (auto first{showers.begin()}; first != showers.end();) {
+    const auto last{std::find_if(
+        first, showers.end(), [&](const auto& shower) { return first->first < shower.first; })};
+    const auto n{static_cast<double>(std::distance(first, last))};
+
+    // the empirical quantiles of Xmax at this energy
+    energies_.push_back(first->first);
+    for (std::size_t k = 0; k < NQUANTILES; ++k) {
+      const auto position{std::clamp(probability_of(k) * n - 0.5, 0., n - 1.)};
+      const auto below{static_cast<std::size_t>(position)};
+      const auto above{std::min(below + 1, static_cast<std::size_t>(n - 1.))};
+      const auto t{position - below};
+      quantiles_.push_back((1. - t) * first[below].second + t * first[above].second);
+    }
+
+    first = last;
+  }
+}
+
+auto
+XmaxDistribution::quantile(const LogEnergy energy, const double probability) const -> double {
+
+  // the node at or below this energy and the weight of the next node
+  const auto nenergies{energies_.size()};
+  std::size_t i{0};
+  double s{0.};
+  if (inverse_step_ > 0.) {
+    const auto position{
+        std::clamp((energy - energies_.front()) * inverse_step_, 0., nenergies - 1.)};
+    i = std::min(static_cast<std::size_t>(position), nenergies - 2);
+    s = position - i;
+  } else if (nenergies > 1) {
+    const auto above{
+        std::upper_bound(energies_.begin() + 1, energies_.end() - 1, energy) - energies_.begin()};
+    i = static_cast<std::size_t>(above) - 1;
+    s = std::clamp((energy - energies_[i]) / (energies_[i + 1] - energies_[i]), 0., 1.);
+  }
+  const auto j{std::min(i + 1, nenergies - 1)};
+
+  // the stored quantile at or below this probability and the weight of the next one
+  const auto position{std::clamp(probability * NQUANTILES - 0.5, 0., NQUANTILES - 1.)};
+  const auto k{std::min(static_cast<std::size_t>(position), NQUANTILES - 2)};
+  const auto t{position - k};
+
+  // and interpolate in quantile at both energies and then in energy
+  const auto* lower{&quantiles_[i * NQUANTILES + k]};
+  const auto* upper{&quantiles_[j * NQUANTILES + k]};
+  return (1. - s) * ((1. - t) * lower[0] + t * lower[1]) +
+         s * ((1. - t) * upper[0] + t * upper[1]);
+}
+
+auto
+XmaxDistribution::sample(const LogEnergy energy) const -> double {
+  return quantile(energy, random::uniform<double>());
+}
@@ -98,3 +98,186 @@ def test_add_earth():
 
     # check that they agree
     np.testing.assert_allclose(earth_density, atmosphere_density)
+
+
+def test_linsley_atmosphere():
+    """
+    Test the depth and density of the Linsley atmospheres.
+    """
+
+    # the altitudes we sample at [km]
+    altitudes = np.linspace(0, 110, 500)
+
+    for model in ["us-standard", "south-pole-january", "south-pole-august"]:
+
+        # create the atmosphere model
+        atmosphere = apricot.LinsleyAtmosphere(model)
+        assert atmosphere.analytic()
+
+        # the sea-level depth should be close to one atmosphere
+        np.testing.assert_allclose(atmosphere.depth(0.0), 1030.0, rtol=2e-2)
+
+        # and there is no atmosphere above the top
+        np.testing.assert_allclose(atmosphere.depth(atmosphere.top + 1.0), 0.0)
+
+        # the altitude should invert the depth
+        depths = atmosphere.depth(altitudes)
+        np.testing.assert_allclose(atmosphere.altitude(depths), altitudes, atol=1e-8)
+
+        # and the depth should be the integral of the density
+        midpoints = 0.5 * (altitudes[1:] + altitudes[:-1])
+        column = np.sum(atmosphere.density(midpoints) * np.diff(altitudes) * 1e5)
+        np.testing.assert_allclose(depths[0] - depths[-1], column, rtol=1e-3)
+
+    # the exponential atmosphere also has a closed-form depth
+    atmosphere = apricot.ExponentialAtmosphere()
+    assert atmosphere.analytic()
+    np.testing.assert_allclose(
+        atmosphere.altitude(atmosphere.depth(altitudes)), altitudes, atol=1e-8
+    )
+
+    # an unknown parameter set should raise an error
+    try:
+        apricot.LinsleyAtmosphere("mars")
+        assert False
+    except ValueError:
+        pass
+
+
+def test_slant_depth_table():
+    """
+    Test the curved-Earth slant depth tables.
+    """
+
+    # create the atmosphere and its table
+    atmosphere = apricot.LinsleyAtmosphere()
+    table = apricot.SlantDepthTable(atmosphere)
+
+    # the measured interpolation error should be small
+    assert table.error < 5e-3
+
+    # vertical rays should match the vertical depth
+    altitudes = np.linspace(0, 50, 51)
+    np.testing.assert_allclose(
+        table.depth(altitudes, 0.0), atmosphere.depth(altitudes), rtol=1e-3
+    )
+
+    # and every direction should agree with direct integration
+    zeniths = np.radians(np.linspace(0, 180, 37))
+    h, z = np.meshgrid(np.asarray([0.5, 3.0, 12.0]), zeniths)
+    np.testing.assert_allclose(table.depth(h, z), table.integrate(h, z), rtol=5e-3)
+
+    # the horizontal depth is finite on a curved Earth
+    horizontal = table.depth(0.0, np.pi / 2.0)
+    assert 3e4 < horizontal < 4e4
+
+    # rays that hit the surface stop there
+    np.testing.assert_allclose(table.depth(0.0, np.pi), 0.0, atol=1e-6)
+
+    # find the point half way through an upward ray
+    zenith = np.radians(80.0)
+    grammage = 0.5 * table.depth(2.0, zenith)
+    distance = table.distance(2.0, zenith, grammage)
+
+    # the location and local zenith angle at this point
+    R = 6356.752
+    start = np.asarray([0.0, R + 2.0])
+    direction = np.asarray([np.sin(zenith), np.cos(zenith)])
+    point = start + distance * direction
+    radius = np.linalg.norm(point)
+
+    # the depth remaining from this point should be the other half
+    remaining = table.depth(radius - R, np.arccos(point @ direction / radius))
+    np.testing.assert_allclose(remaining, grammage, rtol=1e-2)
+
+    # and rays that cannot reach a grammage return infinity
+    assert np.isinf(table.distance(0.0, 0.0, 2e3))
+
+
+def test_sounding_atmosphere():
+    """
+    Test the time-dependent atmosphere built from density profiles.
+    """
+
+    # the altitudes of our profiles [km]
+    altitudes = np.linspace(0, 30, 61)
+
+    # two exponential profiles half a year apart
+    summer = 1.3e-3 * np.exp(-altitudes / 7.0)
+    winter = 1.2e-3 * np.exp(-altitudes / 8.0)
+
+    # create the atmosphere with a period of one year
+    atmosphere = apricot.SoundingAtmosphere(
+        [0.0, 182.0], [altitudes, altitudes], [summer, winter], period=365.25
+    )
+    assert len(atmosphere) == 2
+    assert atmosphere.analytic()
+
+    # the first profile is active to start with and exponential profiles
+    # are reproduced exactly - even above the tabulated altitudes
+    heights = np.linspace(0, 40, 100)
+    np.testing.assert_allclose(atmosphere.density(heights), 1.3e-3 * np.exp(-heights / 7.0))
+    np.testing.assert_allclose(
+        atmosphere.depth(heights), 1.3e-3 * 7e5 * np.exp(-heights / 7.0), rtol=1e-6
+    )
+
+    # and the altitude inverts the depth
+    np.testing.assert_allclose(
+        atmosphere.altitude(atmosphere.depth(heights)), heights, atol=1e-8
+    )
+
+    # half-way between the profiles, we interpolate
+    atmosphere.set_time(91.0)
+    np.testing.assert_allclose(atmosphere.density(0.0), 1.25e-3)
+
+    # times wrap around with the period
+    atmosphere.set_time(365.25 + 182.0)
+    np.testing.assert_allclose(atmosphere.density(0.0), 1.2e-3)
+    atmosphere.set_time(273.625)
+    np.testing.assert_allclose(atmosphere.density(0.0), 1.25e-3)
+
+    # or we can select the closest profile
+    atmosphere.set_time(100.0, interpolate=False)
+    np.testing.assert_allclose(atmosphere.density(0.0), 1.2e-3)
+
+    # between profiles, the depth is the same mixture of the two depths
+    atmosphere.set_time(91.0)
+    mixture = 0.5 * 1.3e-3 * 7e5 * np.exp(-heights / 7.0) + 0.5 * 1.2e-3 * 8e5 * np.exp(
+        -heights / 8.0
+    )
+    np.testing.assert_allclose(atmosphere.depth(heights), mixture, rtol=1e-6)
+
+    # and the altitude still inverts it
+    np.testing.assert_allclose(
+        atmosphere.altitude(atmosphere.depth(heights)), heights, atol=1e-6
+    )
+
+    # every change of time is counted so tables can tell they are out of date
+    table = apricot.SlantDepthTable(atmosphere, nheights=31, nzeniths=11)
+    assert not table.stale
+    revision = atmosphere.revision
+    atmosphere.set_time(10.0)
+    assert atmosphere.revision != revision
+    assert table.stale
+
+    # until they are rebuilt
+    table.rebuild()
+    assert not table.stale
+
+    # write a file with one profile in pressure and temperature
+    filename = "/tmp/sounding.dat"
+    with open(filename, "w") as f:
+        f.write("period 12\n")
+        f.write("profile 6\n0 1000 250\n10 300 220\n20 60 215\n")
+        f.write("profile 0\n0 1.2e-3\n10 4e-4\n")
+
+    # and load it back - the profiles are sorted by time
+    atmosphere = apricot.SoundingAtmosphere(filename)
+    assert len(atmosphere) == 2
+    np.testing.assert_allclose(atmosphere.density(0.0), 1.2e-3)
+
+    # the ideal gas law gives the density of the other profile
+    atmosphere.set_time(6.0)
+    np.testing.assert_allclose(
+        atmosphere.density(0.0), 1e-3 * 1e5 * 0.028966 / (8.3145 * 250.0)
+    )
@@ -17,3 +17,82 @@ def test_create_particles():
         _ = apricot.Electron(E)
         _ = apricot.Muon(E)
         _ = apricot.Tau(E)
+
+
+def test_energy_loss_tables():
+    """
+    Test the continuous energy loss tables of muons and taus.
+    """
+
+    # check every lepton and model
+    for pid in [13, 15]:
+        for model in [
+            apricot.LeptonEnergyLossModel.BDHM,
+            apricot.LeptonEnergyLossModel.Soyez,
+            apricot.LeptonEnergyLossModel.ALLM,
+            apricot.LeptonEnergyLossModel.BS,
+        ]:
+
+            # get the shared table for this lepton
+            table = apricot.EnergyLossTable.get(pid, model)
+
+            # beta is positive and the range increases with energy
+            energies = np.linspace(12.0, 21.0, 100)
+            assert np.all(table.beta(energies) > 0.0)
+
+            # and beta never grows towards lower energies
+            grid = np.linspace(9.0, 22.0, 500)
+            assert np.all(np.diff(table.beta(grid)) >= 0.0)
+            assert np.all(np.diff(table.range(energies)) > 0.0)
+
+            # crossing two steps is the same as crossing their sum
+            np.testing.assert_allclose(
+                table.energy(table.energy(19.0, 2e5), 3e5), table.energy(19.0, 5e5), atol=1e-6
+            )
+
+            # and the range exhausts the energy of the lepton
+            assert table.energy(18.0, 1.01 * table.range(18.0)) == 9.0
+
+    # with a constant beta, the energy loss is analytic
+    filename = "/tmp/beta.dat"
+    with open(filename, "w") as f:
+        f.write("# log10(E/eV) beta\n10 1e-6\n20 1e-6\n")
+    table = apricot.EnergyLossTable(filename, alpha=2e6)
+
+    # E(X) = (E0 + alpha/beta) exp(-beta X) - alpha/beta
+    grammage = np.linspace(0.0, 5e6, 50)
+    expected = (1e18 + 2e12) * np.exp(-1e-6 * grammage) - 2e12
+    np.testing.assert_allclose(table.energy(18.0, grammage), np.log10(expected), atol=1e-4)
+
+
+def test_stochastic_energy_loss():
+    """
+    Test the continuous and stochastic energy losses of muons.
+    """
+
+    # get the shared muon table
+    model = apricot.LeptonEnergyLossModel.ALLM
+    table = apricot.StochasticLossTable.get(13, model)
+    total = apricot.EnergyLossTable.get(13, model)
+
+    # the continuous loss is only part of the total loss
+    energies = np.linspace(12.0, 21.0, 100)
+    assert np.all(table.continuous.beta(energies) < total.beta(energies))
+    assert np.all(table.rate(energies) > 0.0)
+
+    # sample many catastrophic losses at 1 EeV
+    fractions = np.asarray(
+        [table.sample_fraction(table.sample_process(18.0)) for _ in range(50000)]
+    )
+    assert np.all((fractions >= table.vcut) & (fractions <= 1.0))
+
+    # and the continuous + stochastic loss recovers the total loss
+    beta = table.continuous.beta(18.0) + table.rate(18.0) * fractions.mean()
+    np.testing.assert_allclose(beta, total.beta(18.0), rtol=0.02)
+
+    # the mean grammage between losses is the inverse of the rate
+    grammage = [
+        table.continuous.range(18.0) - table.continuous.range(table.next_loss(18.0))
+        for _ in range(20000)
+    ]
+    np.testing.assert_allclose(np.mean(grammage), 1.0 / table.rate(18.0), rtol=0.05)
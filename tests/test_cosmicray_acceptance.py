@@ -40,3 +40,198 @@ def test_basic_geometric_acceptance():
 
     # and propagate a single particle
     interactions = propagator.propagate(source, flux, detector)
+
+
+def test_uhecr_propagator():
+    """
+    Check that the UHECR propagator finds shower max at Xmax.
+    """
+
+    # the radius that we use for the Earth model
+    Re = apricot.SphericalEarth.polar_radius
+
+    # use a spherical Earth with an atmosphere
+    earth = apricot.SphericalEarth(Re)
+    earth.add(apricot.ExponentialAtmosphere())
+
+    # we pick particles on a cap 150km above the surface
+    source = apricot.SphericalCapSource(radius=Re + 150.0)
+
+    # create a flux model that just creates (10^19) cosmic ray protons.
+    flux = apricot.FixedProtonFlux(19.0)
+
+    # a detector that sees every interaction
+    detector = apricot.PerfectDetector()
+
+    # create the propagator
+    propagator = apricot.UHECRPropagator(earth)
+
+    # and propagate some particles
+    interactions = propagator.propagate(source, flux, detector, 1000)
+
+    # every downward trajectory should reach Xmax in the atmosphere
+    events = [event[0] for event in interactions if len(event) > 0]
+    assert len(events) > 0
+
+    # the slant depth from each interaction back to the top of the atmosphere
+    depths = []
+    for event in events:
+        location = np.asarray(event.location)
+        direction = np.asarray(event.direction)
+        zenith = np.arccos(-location @ direction / np.linalg.norm(location))
+        depths.append(propagator.table.depth(event.altitude, zenith))
+
+    # and these should be distributed around the mean Xmax
+    distribution = apricot.Proton.get_Xmax_distribution()
+    assert np.min(depths) >= 0.995 * distribution.quantile(19.0, 0.0)
+    assert np.max(depths) <= 1.005 * distribution.quantile(19.0, 1.0)
+    np.testing.assert_allclose(
+        np.mean(depths), apricot.Proton.get_Xmax(19.0), atol=5.0 * 57.0 / np.sqrt(len(depths))
+    )
+
+
+def test_batch_matches_single_trials():
+    """
+    Check that the statically typed batch kernel matches single trials.
+    """
+
+    # models that have a statically typed kernel
+    Re = apricot.SphericalEarth.polar_radius
+    earth = apricot.SphericalEarth(Re)
+    earth.add(apricot.ExponentialAtmosphere())
+    source = apricot.SphericalCapSource(radius=Re + 100.0)
+    flux = apricot.FixedTauNeutrinoFlux(18.0)
+    detector = apricot.PerfectDetector()
+    propagator = apricot.SimplePropagator(earth)
+
+    # propagate a batch of trials
+    apricot.seed(1)
+    batch = propagator.propagate(source, flux, detector, 2000)
+
+    # and the same trials one at a time through the generic (virtual) path
+    apricot.seed(1)
+    single = [propagator.propagate(source, flux, detector) for _ in range(2000)]
+
+    # we should get some interactions
+    assert sum(len(event) for event in batch) > 0
+
+    # and exactly the same events
+    assert [len(event) for event in batch] == [len(event) for event in single]
+    for a, b in zip(
+        [i for event in batch for i in event], [i for event in single for i in event]
+    ):
+        assert a.pdgid == b.pdgid and a.energy == b.energy and a.altitude == b.altitude
+        np.testing.assert_array_equal(np.asarray(a.location), np.asarray(b.location))
+
+
+def test_tau_transport_flag():
+    """
+    Check that tau transport is opt-in and leaves cosmic rays unchanged.
+    """
+
+    # use a spherical Earth with an atmosphere
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    earth.add(apricot.ExponentialAtmosphere())
+
+    # tau transport is off by default
+    assert not apricot.SimplePropagator(earth).taus
+
+    # create a propagator that transports taus
+    propagator = apricot.SimplePropagator(earth, taus=True)
+    assert propagator.taus
+
+    # cosmic rays still interact once in the atmosphere
+    source = apricot.SphericalCapSource(radius=apricot.SphericalEarth.polar_radius + 150.0)
+    flux = apricot.FixedProtonFlux(19.0)
+    detector = apricot.PerfectDetector()
+    interactions = propagator.propagate(source, flux, detector, 100)
+    assert all(len(event) <= 1 for event in interactions)
+
+
+def test_muon_transport_flag():
+    """
+    Check that muon transport is opt-in and leaves cosmic rays unchanged.
+    """
+
+    # use a spherical Earth with an atmosphere
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    earth.add(apricot.ExponentialAtmosphere())
+
+    # muon transport is off by default
+    assert not apricot.SimplePropagator(earth).muons
+
+    # create a propagator that transports muons
+    propagator = apricot.SimplePropagator(earth, muons=True)
+    assert propagator.muons and not propagator.taus
+
+    # cosmic rays still interact once in the atmosphere
+    source = apricot.SphericalCapSource(radius=apricot.SphericalEarth.polar_radius + 150.0)
+    flux = apricot.FixedProtonFlux(19.0)
+    detector = apricot.PerfectDetector()
+    interactions = propagator.propagate(source, flux, detector, 100)
+    assert all(len(event) <= 1 for event in interactions)
+
+
+def test_muon_loss_energy_cut():
+    """
+    Check that detectors see the energy deposited by a muon loss.
+    """
+
+    # use a spherical Earth
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    radius = earth.radius(np.asarray([0, 0, -1.0]))
+
+    # and aim neutrinos into the Earth so that they always interact
+    source = apricot.SphericalCapSource(
+        target=np.zeros(3), cone=0.1, radius=radius - 1.0
+    )
+    flux = apricot.FixedMuonNeutrinoFlux(18.0)
+
+    # only accept energies that the neutrino can never deposit
+    detector = apricot.EnergyCutDetector(16.5, 17.5)
+
+    # and transport the muons from charged current interactions
+    propagator = apricot.SimplePropagator(earth, muons=True)
+    interactions = propagator.propagate(source, flux, detector, 200)
+
+    # we record some catastrophic muon losses
+    losses = [i for event in interactions for i in event]
+    assert len(losses) > 0
+    assert all(i.pdgid == apricot.pdg.Muon for i in losses)
+
+    # and every saved loss deposits an energy within the cut
+    energies = np.asarray([i.energy for i in losses])
+    assert np.all((energies > 16.5) & (energies < 17.5))
+
+
+def test_tau_decay_energy_cut():
+    """
+    Check that taus from tau neutrinos are transported until they decay.
+    """
+
+    # use a spherical Earth
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    radius = earth.radius(np.asarray([0, 0, -1.0]))
+
+    # and aim neutrinos into the Earth so that they always interact
+    source = apricot.SphericalCapSource(
+        target=np.zeros(3), cone=0.1, radius=radius - 1.0
+    )
+    flux = apricot.FixedTauNeutrinoFlux(18.0)
+
+    # only accept energies below that of the neutrino
+    detector = apricot.EnergyCutDetector(14.0, 17.999)
+
+    # and transport the taus from charged current interactions
+    propagator = apricot.SimplePropagator(earth, taus=True)
+    interactions = propagator.propagate(source, flux, detector, 500)
+
+    # we record some tau decays
+    decays = [i for event in interactions for i in event]
+    assert len(decays) > 100
+    assert all(i.pdgid == apricot.pdg.Tau for i in decays)
+
+    # and every tau has lost energy before it decays
+    energies = np.asarray([i.energy for i in decays])
+    assert np.all((energies > 14.0) & (energies < 18.0))
+    assert np.mean(energies) < 17.5
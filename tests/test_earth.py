@@ -94,3 +94,146 @@ def test_spherical_earth_density():
 
     # and save the plot
     fig.savefig(f"{os.path.dirname(__file__)}/figures/earth_density.pdf")
+
+
+def test_layered_density_prem():
+    """
+    Check that the PREM layer file reproduces apricot.PREM.
+    """
+
+    # the directory containing our Earth models
+    earth_dir = os.path.join(os.path.dirname(__file__), os.pardir, "data", "earth")
+
+    # load the PREM layer file
+    prem = apricot.LayeredDensity(f"{earth_dir}/prem.dat")
+
+    # the radii that we evaluate at
+    radii = np.linspace(0.0, 6360.0, 10_000)
+
+    # and check that it agrees with the hard-coded PREM model
+    np.testing.assert_allclose(
+        prem.density(radii, 6356.755), apricot.PREM.density(radii, 6356.755)
+    )
+
+    # the core and the ocean should have the right materials
+    assert prem.material(100.0, 6356.755) == apricot.materials.Core
+    assert prem.material(6355.0, 6356.755) == apricot.materials.Water
+    assert prem.material(6400.0, 6356.755) == apricot.materials.Vacuum
+
+    # and we can use it as the interior of an Earth model
+    earth = apricot.SphericalEarth()
+    earth.add(prem)
+
+    # the radii that we evaluate at
+    locations = np.zeros((1_000, 3))
+    locations[:, 2] = np.linspace(0.0, 6356.0, 1_000)
+
+    # and the density should match PREM
+    np.testing.assert_allclose(
+        earth.density(locations),
+        apricot.PREM.density(locations[:, 2], apricot.SphericalEarth.polar_radius),
+    )
+
+
+def test_voxel_density():
+    """
+    Check the density and ray traversal of a voxel grid.
+    """
+
+    # a 10x10x10 grid of 1 km voxels near the south pole
+    densities = np.ones((10, 10, 10))
+    densities[5, 5, 5] = 3.0
+    origin = np.asarray([0.0, 0.0, -6360.0])
+    voxels = apricot.VoxelDensity(origin, np.ones(3), densities)
+
+    # check the shape of the grid
+    assert voxels.shape == [10, 10, 10]
+    assert len(voxels) == 1_000
+
+    # check the density of a few voxels
+    assert voxels.density(origin + [5.5, 5.5, 5.5]) == 3.0
+    assert voxels.density(origin + [0.5, 5.5, 5.5]) == 1.0
+    assert not voxels.contains(origin + [-0.5, 5.5, 5.5])
+
+    # walk along a row of the grid that contains the dense voxel
+    grammage, end = voxels.walk(origin + [0.5, 5.5, 5.5], [1.0, 0.0, 0.0])
+    np.testing.assert_allclose(grammage, 11.5e5)
+    np.testing.assert_allclose(end, origin + [10.0, 5.5, 5.5])
+
+    # and stop exactly inside the dense voxel
+    grammage, end = voxels.walk(origin + [0.5, 5.5, 5.5], [1.0, 0.0, 0.0], 6e5)
+    np.testing.assert_allclose(grammage, 6e5)
+    np.testing.assert_allclose(end, origin + [5.5, 5.5, 5.5])
+
+    # or stop after a maximum length inside the grid
+    grammage, end = voxels.walk(origin + [0.5, 5.5, 5.5], [1.0, 0.0, 0.0], length=5.5)
+    np.testing.assert_allclose(grammage, 7.5e5)
+    np.testing.assert_allclose(end, origin + [6.0, 5.5, 5.5])
+
+    # walk along the diagonal of the grid
+    grammage, end = voxels.walk(origin, np.ones(3) / np.sqrt(3.0))
+    np.testing.assert_allclose(grammage, 12.0 * np.sqrt(3.0) * 1e5)
+
+    # and add it to an Earth model
+    earth = apricot.SphericalEarth()
+    earth.add(voxels)
+
+    # the grid should replace the radial model inside it
+    assert earth.density(origin + [5.5, 5.5, 5.5]) == 3.0
+    np.testing.assert_allclose(
+        earth.density([0.0, 0.0, 6000.0]),
+        apricot.PREM.density(6000.0, apricot.SphericalEarth.polar_radius),
+    )
+
+
+def test_firn_density():
+    """
+    Check the firn profile and its analytic column density.
+    """
+
+    # the radius of the Earth that we use
+    R = apricot.SphericalEarth.polar_radius
+
+    # create the default (South Pole) firn model
+    firn = apricot.FirnDensity()
+    assert firn.analytic
+
+    # which stays analytic over an analytic background
+    assert apricot.FirnDensity(background=apricot.FirnDensity()).analytic
+
+    # check the density at the surface and in deep ice
+    np.testing.assert_allclose(firn.density(R - 1e-9, R), 0.359, rtol=1e-5)
+    np.testing.assert_allclose(firn.density(R - 2.0, R), 0.917, rtol=1e-5)
+
+    # check the materials through the ice sheet
+    assert firn.material(R - 0.01, R) == apricot.materials.Firn
+    assert firn.material(R - 1.0, R) == apricot.materials.Ice
+
+    # below the ice sheet, we use PREM
+    np.testing.assert_allclose(firn.density(R - 10.0, R), apricot.PREM.density(R - 10.0, R))
+
+    # compare the analytic column against a numerical integral
+    radii = np.linspace(R - 5.0, R, 1_000_001)
+    centers = 0.5 * (radii[1:] + radii[:-1])
+    numeric = np.sum(firn.density(centers, R)) * (radii[1] - radii[0])
+    np.testing.assert_allclose(firn.column(R - 5.0, R, R), numeric, rtol=1e-5)
+    np.testing.assert_allclose(firn.column(R, R - 5.0, R), -numeric, rtol=1e-5)
+
+    # and the PREM column should match PREM
+    numeric = np.sum(apricot.PREM.density(centers, R)) * (radii[1] - radii[0])
+    np.testing.assert_allclose(apricot.PREM.column(R - 5.0, R, R), numeric, rtol=1e-5)
+
+    # create an Earth with this ice sheet
+    earth = apricot.SphericalEarth()
+    earth.add(firn)
+
+    # a slanted segment from 3 km deep to the surface
+    start = np.asarray([0.0, 0.0, -(R - 3.0)])
+    end = np.asarray([3.0, 0.0, -R])
+
+    # and compare the grammage against a fine midpoint sum
+    points = start + np.linspace(0.0, 1.0, 100_001)[:, None] * (end - start)
+    midpoints = 0.5 * (points[1:] + points[:-1])
+    length = np.linalg.norm(end - start) / (points.shape[0] - 1)
+    numeric = np.sum(earth.density(midpoints)) * 1e5 * length
+    np.testing.assert_allclose(earth.grammage(start, end), numeric, rtol=1e-4)
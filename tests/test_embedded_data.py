@@ -0,0 +1,41 @@
+"""
+Check the data tables compiled into apricot.
+"""
+import apricot
+import numpy as np
+
+
+def test_embedded_tables():
+    """
+    Check that every compiled-in table can be loaded.
+    """
+
+    # the name of every embedded table
+    names = apricot.embedded_tables()
+
+    # every embedded table is a two-dimensional array
+    for name in names:
+        table = apricot.embedded_table(name)
+        assert table.ndim == 2
+        assert np.all(np.isfinite(table))
+
+    # and unknown tables are not found
+    assert apricot.embedded_table("particles/does_not_exist.dat") is None
+
+
+def test_in_memory_decay_table():
+    """
+    Check that I can create a tau decay table from decay states.
+    """
+
+    # two decays with different weights
+    states = [[0.5, 0.1, 0.1, 0.2, 0.05, 0.05], [0.4, 0.0, 0.0, 0.6, 0.0, 0.0]]
+    table = apricot.TauDecayTable(states, [1.0, 3.0])
+    assert len(table) == 2
+
+    # sample many decays
+    apricot.seed(1)
+    samples = np.asarray([table.random_final_state().nu_tau for _ in range(20000)])
+
+    # and check the frequency of the heavier decay
+    np.testing.assert_allclose(np.mean(np.isclose(samples, 0.4)), 0.75, atol=0.02)
@@ -75,3 +75,174 @@ def test_UniformFlux():
             # and check that we always get the same particle
             assert isinstance(flux.get_particle(), particle)
             assert isinstance(flux.get_particle(), particle)
+
+
+def test_TabulatedFlux(tmp_path):
+    """
+    Check that tabulated spectra are sampled correctly.
+    """
+
+    # write an E^-2 spectrum from 10^17 to 10^20 eV
+    filename = tmp_path / "spectrum.dat"
+    energies = np.linspace(17.0, 20.0, 7)
+    with open(filename, "w") as f:
+        f.write("# log10(E/eV) dN/dE\n")
+        for energy in energies:
+            f.write(f"{energy} {10.0 ** (40.0 - 2.0 * energy)}\n")
+
+    # the various tabulated fluxes that we test
+    ftypes = [apricot.TabulatedProtonFlux, apricot.TabulatedTauNeutrinoFlux]
+    particles = [apricot.Proton, apricot.TauNeutrino]
+
+    for fluxtype, particle in zip(ftypes, particles):
+
+        # create the flux and sample some particles
+        flux = fluxtype(str(filename))
+        samples = [flux.get_particle() for _ in range(20000)]
+        assert all(isinstance(p, particle) for p in samples)
+
+        # all the energies are within the table
+        sampled = np.asarray([p.energy for p in samples])
+        assert np.all((sampled >= 17.0) & (sampled <= 20.0))
+
+        # and dN/dlog10(E) ~ 1/E so ~90% of the energies are below 10^18 eV
+        expected = (1e-17 - 1e-18) / (1e-17 - 1e-20)
+        np.testing.assert_allclose(np.mean(sampled < 18.0), expected, atol=0.01)
+
+    # the interpolated flux goes through the table
+    spectrum = apricot.SpectrumTable(list(energies), list(10.0 ** (40.0 - 2.0 * energies)))
+    np.testing.assert_allclose(spectrum.flux(18.25), 10.0 ** (40.0 - 36.5), rtol=1e-6)
+    assert spectrum.flux(21.0) == 0.0
+
+    # and flux models can share a spectrum
+    flux = apricot.TabulatedIronFlux(spectrum)
+    assert flux.spectrum.max_energy == 20.0
+
+
+def test_PowerLawFlux():
+    """
+    Check that power-law spectra are sampled and weighted correctly.
+    """
+
+    # a few of the power-law fluxes that we test
+    ftypes = [
+        apricot.PowerLawProtonFlux,
+        apricot.PowerLawMuonNeutrinoFlux,
+        apricot.PowerLawTauFlux,
+    ]
+    particles = [apricot.Proton, apricot.MuonNeutrino, apricot.Tau]
+
+    for fluxtype, particle in zip(ftypes, particles):
+
+        # create an E^-2.7 flux and sample some particles
+        flux = fluxtype(2.7, 18.0, 20.0)
+        samples = [flux.get_particle() for _ in range(20000)]
+        assert all(isinstance(p, particle) for p in samples)
+
+        # all the energies are within the spectrum
+        sampled = np.asarray([p.energy for p in samples])
+        assert np.all((sampled >= 18.0) & (sampled <= 20.0))
+
+        # the fraction below 10^19 eV matches the analytic spectrum
+        expected = (1.0 - 10.0 ** -1.7) / (1.0 - 10.0 ** -3.4)
+        np.testing.assert_allclose(np.mean(sampled < 19.0), expected, atol=0.01)
+
+        # each particle carries 1/(dP/dE) as its generation weight
+        weights = np.asarray([p.weight for p in samples])
+        np.testing.assert_allclose(weights, flux.weight(sampled), rtol=1e-9)
+        np.testing.assert_allclose(flux.pdf(sampled) * weights, 1.0, rtol=1e-9)
+
+        # so reweighting to E^-2 recovers its integral
+        reweighted = np.mean(10.0 ** (-2.0 * sampled) * weights)
+        np.testing.assert_allclose(reweighted, 1e-18 - 1e-20, rtol=0.05)
+
+    # a power-law is a broken power-law with a single segment
+    assert apricot.BrokenPowerLawIronFlux is apricot.PowerLawIronFlux
+    flux = apricot.PowerLawIronFlux(2.7, 18.0, 20.0)
+    assert flux.energies == [18.0, 20.0] and flux.indices == [2.7]
+
+    # a broken power-law is continuous at the break
+    flux = apricot.BrokenPowerLawIronFlux([17.0, 18.5, 20.0], [1.0, 3.0])
+    np.testing.assert_allclose(flux.pdf(18.5 - 1e-9), flux.pdf(18.5 + 1e-9), rtol=1e-6)
+    assert flux.weight(21.0) == 0.0
+
+    # and ~87% of the energies are below the break
+    sampled = np.asarray([flux.get_particle().energy for _ in range(20000)])
+    below = np.log(10.0 ** 1.5) / (np.log(10.0 ** 1.5) + 0.5 * (1.0 - 1e-3))
+    np.testing.assert_allclose(np.mean(sampled < 18.5), below, atol=0.01)
+
+    # unweighted fluxes have a unit weight
+    assert apricot.UniformProtonFlux(18.0, 19.0).get_particle().weight == 1.0
+
+
+def test_CompositeFlux():
+    """
+    Check that composite fluxes sample the right composition.
+    """
+
+    # a fixed 3:1 mixture of protons and iron
+    flux = apricot.CompositeFlux(
+        [apricot.FixedProtonFlux(18.0), apricot.FixedIronFlux(19.0)], [3.0, 1.0]
+    )
+    assert len(flux) == 2
+    samples = [flux.get_particle() for _ in range(20000)]
+    assert all(isinstance(p, (apricot.Proton, apricot.Iron)) for p in samples)
+    iron = np.asarray([isinstance(p, apricot.Iron) for p in samples])
+    np.testing.assert_allclose(np.mean(iron), 0.25, atol=0.01)
+
+    # and each component keeps its own energies
+    energies = np.asarray([p.energy for p in samples])
+    np.testing.assert_allclose(energies[iron], 19.0)
+    np.testing.assert_allclose(energies[~iron], 18.0)
+
+    # a composition that changes from protons to iron with energy
+    flux = apricot.CompositeFlux(
+        apricot.UniformProtonFlux(18.0, 20.0),
+        [apricot.pdg.Proton, apricot.pdg.Iron],
+        [18.0, 20.0],
+        [[1.0, 0.0], [0.0, 1.0]],
+    )
+    np.testing.assert_allclose(flux.fraction(1, [18.0, 19.5, 21.0]), [0.0, 0.75, 1.0])
+
+    # so the mean energy of iron is above that of protons
+    samples = [flux.get_particle() for _ in range(20000)]
+    iron = np.asarray([p.energy for p in samples if isinstance(p, apricot.Iron)])
+    protons = np.asarray([p.energy for p in samples if isinstance(p, apricot.Proton)])
+    np.testing.assert_allclose(np.mean(iron), 18.0 + 4.0 / 3.0, atol=0.02)
+    np.testing.assert_allclose(np.mean(protons), 18.0 + 2.0 / 3.0, atol=0.02)
+
+    # and neutrino flavor ratios
+    spectrum = apricot.PowerLawMuonNeutrinoFlux(2.0, 17.0, 20.0)
+    flux = apricot.CompositeFlux.neutrinos(spectrum)
+    samples = [flux.get_particle() for _ in range(30000)]
+    for flavor in [apricot.ElectronNeutrino, apricot.MuonNeutrino, apricot.TauNeutrino]:
+        fraction = np.mean([isinstance(p, flavor) for p in samples])
+        np.testing.assert_allclose(fraction, 1.0 / 3.0, atol=0.01)
+
+    # whose weights include the probability of choosing their flavor
+    energies = np.asarray([p.energy for p in samples])
+    weights = np.asarray([p.weight for p in samples])
+    np.testing.assert_allclose(weights, 3.0 * spectrum.weight(energies), rtol=1e-9)
+
+    # a mixture of weighted fluxes reweights each component to its own integral
+    protons = apricot.PowerLawProtonFlux(2.0, 18.0, 19.0)
+    iron = apricot.PowerLawIronFlux(2.0, 18.0, 20.0)
+    flux = apricot.CompositeFlux([protons, iron], [3.0, 1.0])
+    samples = [flux.get_particle() for _ in range(20000)]
+    reweighted = np.asarray([10.0 ** (-2.0 * p.energy) * p.weight for p in samples])
+    iron = np.asarray([isinstance(p, apricot.Iron) for p in samples])
+    np.testing.assert_allclose(np.mean(reweighted * ~iron), 1e-18 - 1e-19, rtol=0.05)
+    np.testing.assert_allclose(np.mean(reweighted * iron), 1e-18 - 1e-20, rtol=0.05)
+
+    # as does an energy-dependent composition
+    flux = apricot.CompositeFlux(
+        apricot.PowerLawProtonFlux(2.0, 18.0, 20.0),
+        [apricot.pdg.Proton, apricot.pdg.Iron],
+        [18.0, 20.0],
+        [[3.0, 1.0], [1.0, 3.0]],
+    )
+    samples = [flux.get_particle() for _ in range(20000)]
+    reweighted = np.asarray([10.0 ** (-2.0 * p.energy) * p.weight for p in samples])
+    iron = np.asarray([isinstance(p, apricot.Iron) for p in samples])
+    np.testing.assert_allclose(np.mean(reweighted * ~iron), 1e-18 - 1e-20, rtol=0.05)
+    np.testing.assert_allclose(np.mean(reweighted * iron), 1e-18 - 1e-20, rtol=0.05)
@@ -211,3 +211,58 @@ def test_reflect_below_basic():
     np.testing.assert_allclose(
         3 * x + 4 * y - 5 * z, apricot.geometry.reflect_below(3 * x + 4 * y + 5 * z, z)
     )
+
+
+def test_batched_coordinates():
+    """
+    Check the batched spherical, geodetic, and ENU transforms.
+    """
+
+    # some random (lat, lon, height) coordinates
+    N = 10_000
+    geodetic = np.zeros((N, 3))
+    geodetic[:, 0] = np.random.uniform(-90.0, 90.0, size=N)
+    geodetic[:, 1] = np.random.uniform(-180.0, 180.0, size=N)
+    geodetic[:, 2] = np.random.uniform(-10.0, 50.0, size=N)
+
+    # convert them to geocentric and back again
+    locations = apricot.geometry.from_geodetic(geodetic)
+    np.testing.assert_allclose(
+        apricot.geometry.to_geodetic(locations), geodetic, atol=1e-9
+    )
+
+    # the spherical coordinates should match NumPy
+    spherical = apricot.geometry.to_spherical(locations)
+    radius = np.linalg.norm(locations, axis=1)
+    np.testing.assert_allclose(spherical[:, 0], radius)
+    np.testing.assert_allclose(spherical[:, 1], np.arccos(locations[:, 2] / radius))
+    np.testing.assert_allclose(
+        spherical[:, 2], np.arctan2(locations[:, 1], locations[:, 0])
+    )
+
+    # and converting back should give the original locations
+    np.testing.assert_allclose(
+        apricot.geometry.to_cartesian(spherical), locations, atol=1e-6
+    )
+
+    # C-ordered inputs should give the same answer
+    np.testing.assert_allclose(
+        apricot.geometry.to_spherical(np.ascontiguousarray(locations)), spherical
+    )
+
+    # a payload 37 km above the south pole
+    payload = np.asarray([0.0, 0.0, -6393.752])
+
+    # the ENU frame of the payload
+    enu = apricot.geometry.to_enu(locations, payload, geodetic=False)
+
+    # the "up" component is the projection onto the radial vector
+    np.testing.assert_allclose(enu[:, 2], -(locations[:, 2] - payload[2]))
+
+    # and the payload elevation should match the NumPy calculation
+    view = locations - payload
+    view /= np.linalg.norm(view, axis=1).reshape((-1, 1))
+    elevation = np.degrees(np.pi / 2.0 - np.arccos(view @ (payload / 6393.752)))
+    np.testing.assert_allclose(
+        apricot.geometry.payload_view(locations, payload)[:, 0], elevation, atol=1e-8
+    )
@@ -17,3 +17,155 @@ def test_create_particles():
         _ = apricot.ElectronNeutrino(E)
         _ = apricot.MuonNeutrino(E)
         _ = apricot.TauNeutrino(E)
+
+
+def test_cross_section_table():
+    """
+    Test the precomputed interaction length tables.
+    """
+
+    # the cross section submodule
+    CS = apricot.neutrino_cross_section
+
+    # energies inside and outside of the table
+    energies = np.linspace(11.0, 23.0, 1001)
+
+    # check every model
+    for model in [
+        CS.NeutrinoCrossSectionModel.ConnollyLower,
+        CS.NeutrinoCrossSectionModel.ConnollyMiddle,
+        CS.NeutrinoCrossSectionModel.ConnollyUpper,
+        CS.NeutrinoCrossSectionModel.Gorham,
+    ]:
+
+        # get the shared table for this model
+        table = CS.NeutrinoCrossSectionTable.get(model)
+        assert table.model == model
+
+        # evaluate the cross sections directly
+        CC = 10.0 ** CS.charged_current(model, energies)
+        NC = 10.0 ** CS.neutral_current(model, energies)
+
+        # and compare against the table
+        np.testing.assert_allclose(
+            table.interaction_length(energies), 1.0 / (6.0221415e23 * (CC + NC)), rtol=2e-4
+        )
+        np.testing.assert_allclose(table.charged_fraction(energies), CC / (CC + NC), atol=1e-6)
+
+
+def test_tabulated_cross_sections(tmp_path):
+    """
+    Test registering tabulated cross section models from a file.
+    """
+
+    # the cross section submodule
+    CS = apricot.neutrino_cross_section
+    middle = CS.NeutrinoCrossSectionModel.ConnollyMiddle
+
+    # tabulate the middle model every half decade
+    energies = np.arange(13.0, 21.5, 0.5)
+    CC = 10.0 ** CS.charged_current(middle, energies)
+    NC = 10.0 ** CS.neutral_current(middle, energies)
+
+    # and write it (with identical anti-neutrino cross sections) to a file
+    filename = str(tmp_path / "middle.dat")
+    np.savetxt(filename, np.column_stack([energies, CC, NC, CC, NC]), header="E CC NC CCbar NCbar")
+
+    # load and register the model
+    table = CS.NeutrinoCrossSectionTable.load("TabulatedMiddle", filename)
+    assert table.name == "TabulatedMiddle"
+    assert table.model is None
+    assert "TabulatedMiddle" in CS.NeutrinoCrossSectionTable.names()
+
+    # the spline passes through the knots
+    np.testing.assert_allclose(table.charged_current(energies), np.log10(CC), atol=1e-10)
+
+    # and matches the model that it was tabulated from
+    reference = CS.NeutrinoCrossSectionTable.get("ConnollyMiddle")
+    E = np.linspace(13.0, 21.0, 801)
+    np.testing.assert_allclose(
+        table.interaction_length(E), reference.interaction_length(E), rtol=5e-3
+    )
+
+    # the model can be selected by name for neutrino interactions
+    previous = apricot.Neutrino.cross_section_model
+    try:
+        apricot.Neutrino.cross_section_model = "TabulatedMiddle"
+        assert apricot.Neutrino.cross_section_model == "TabulatedMiddle"
+        apricot.Neutrino.cross_section_model = CS.NeutrinoCrossSectionModel.ConnollyUpper
+        assert apricot.Neutrino.cross_section_model == "ConnollyUpper"
+    finally:
+        apricot.Neutrino.cross_section_model = previous
+
+
+def test_batch_cross_sections():
+    """
+    Test that the batched cross sections and y-factors match the scalar ones.
+    """
+
+    # the cross section and y-factor submodules
+    CS = apricot.neutrino_cross_section
+    Y = apricot.neutrino_yfactor
+
+    # a range of energies
+    energies = np.linspace(12.0, 22.0, 101)
+
+    # check every cross section model
+    for model in [
+        CS.NeutrinoCrossSectionModel.ConnollyLower,
+        CS.NeutrinoCrossSectionModel.ConnollyMiddle,
+        CS.NeutrinoCrossSectionModel.ConnollyUpper,
+        CS.NeutrinoCrossSectionModel.Gorham,
+    ]:
+        np.testing.assert_allclose(
+            CS.charged_current(model, energies),
+            [CS.charged_current(model, E) for E in energies],
+        )
+        np.testing.assert_allclose(
+            CS.neutral_current(model, energies),
+            [CS.neutral_current(model, E) for E in energies],
+        )
+
+    # and every y-factor model
+    for model in [
+        apricot.NeutrinoYFactorModel.BDHM,
+        apricot.NeutrinoYFactorModel.Soyez,
+        apricot.NeutrinoYFactorModel.ALLM,
+    ]:
+        np.testing.assert_allclose(
+            Y.y_factor(energies, model), [Y.y_factor(E, model) for E in energies]
+        )
+
+
+def test_inelasticity_table():
+    """
+    Test sampling the inelasticity of neutrino interactions.
+    """
+
+    # the y-factor submodule
+    Y = apricot.neutrino_yfactor
+
+    # the energies of the table nodes
+    energies = np.linspace(15.0, 22.0, 71)
+
+    # check every y-factor model
+    for model in [
+        apricot.NeutrinoYFactorModel.BDHM,
+        apricot.NeutrinoYFactorModel.Soyez,
+        apricot.NeutrinoYFactorModel.ALLM,
+    ]:
+
+        # the tables reproduce <y> at every node
+        table = Y.InelasticityTable.get(model)
+        np.testing.assert_allclose(table.mean(energies), Y.y_factor(energies, model), atol=1e-5)
+
+        # and the samples are valid inelasticities with the right mean
+        y = table.sample(np.full(100_000, 18.5))
+        assert np.all((y >= 0.0) & (y < 1.0))
+        np.testing.assert_allclose(np.mean(y), Y.y_factor(18.5, model), rtol=0.02)
+
+    # the lepton from a neutrino interaction carries (1 - y) of its energy
+    neutrino = apricot.TauNeutrino(19.0)
+    for _ in range(100):
+        assert 0.0 <= neutrino.sample_inelasticity() < 1.0
+        assert neutrino.sample_lepton_energy() <= 19.0
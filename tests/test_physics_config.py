@@ -0,0 +1,70 @@
+"""
+Test the per-propagator physics model configuration.
+"""
+import apricot
+import numpy as np
+
+
+def test_physics_config():
+    """
+    Check that physics models can be set per propagator.
+    """
+
+    # a new configuration copies the global models
+    config = apricot.PhysicsConfig()
+    assert config.cross_section_model == apricot.Neutrino.cross_section_model
+    assert config.energy_loss_model == apricot.ChargedLepton.energy_loss_model
+
+    # and models can be replaced by name
+    config = apricot.PhysicsConfig(
+        cross_section_model="ConnollyUpper",
+        energy_loss_model=apricot.LeptonEnergyLossModel.BS,
+    )
+    assert config.cross_section_model == "ConnollyUpper"
+    assert config.energy_loss_model == apricot.LeptonEnergyLossModel.BS
+
+    # propagators use the global models by default
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    propagator = apricot.SimplePropagator(earth)
+    assert propagator.physics.cross_section_model == apricot.Neutrino.cross_section_model
+
+    # and setting their models leaves the global models untouched
+    previous = apricot.Neutrino.cross_section_model
+    propagator.physics = config
+    assert propagator.physics.cross_section_model == "ConnollyUpper"
+    assert apricot.Neutrino.cross_section_model == previous
+
+    # the global configuration follows the static properties
+    assert apricot.PhysicsConfig.global_config().cross_section_model == previous
+
+
+def test_concurrent_models():
+    """
+    Check that propagators with different models can run side-by-side.
+    """
+
+    # two propagators that only differ in their cross sections
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+    lower = apricot.SimplePropagator(earth)
+    lower.physics = apricot.PhysicsConfig(cross_section_model="ConnollyLower")
+    upper = apricot.SimplePropagator(earth)
+    upper.physics = apricot.PhysicsConfig(cross_section_model="ConnollyUpper")
+
+    # neutrinos that start at the surface of the Earth
+    source = apricot.SphericalCapSource(radius=apricot.SphericalEarth.polar_radius)
+    flux = apricot.FixedTauNeutrinoFlux(18.0)
+    detector = apricot.PerfectDetector()
+
+    # the depth of every interaction of each propagator
+    def depths(propagator):
+        events = propagator.propagate(source, flux, detector, 2000)
+        return np.asarray(
+            [
+                apricot.SphericalEarth.polar_radius - np.linalg.norm(event[0].location)
+                for event in events
+                if len(event) > 0
+            ]
+        )
+
+    # a larger cross section gives shallower interactions
+    assert np.mean(depths(upper)) < np.mean(depths(lower))
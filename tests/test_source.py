@@ -73,3 +73,38 @@ def test_spherical_cap_vectorized():
 
     # check that the radius is correct
     np.testing.assert_allclose(np.linalg.norm(origins, axis=1), radius)
+
+
+def test_spherical_cap_cone():
+    """
+    Check that a targeted spherical cap samples directions in a cone.
+    """
+
+    # the radius of the Earth we use
+    radius = 6400
+
+    # a payload above the South Pole
+    payload = np.asarray([0.0, 0.0, -(radius + 37.0)])
+
+    # an untargeted source samples all directions
+    assert apricot.SphericalCapSource(radius=radius).solid_angle() == 4 * np.pi
+
+    # create a SphericalCapSource that points at the payload
+    cone = np.radians(10.0)
+    source = apricot.SphericalCapSource(target=payload, cone=cone, radius=radius)
+    np.testing.assert_allclose(source.solid_angle(), 2 * np.pi * (1 - np.cos(cone)))
+
+    # sample some origins and directions
+    origins, directions = source.get_origins(1000)
+    np.testing.assert_allclose(np.linalg.norm(directions, axis=1), 1.0)
+    np.testing.assert_allclose(np.linalg.norm(origins, axis=1), radius)
+
+    # every direction is within the cone around the vector to the payload
+    views = payload - origins
+    views /= np.linalg.norm(views, axis=1)[:, None]
+    angles = np.arccos(np.clip(np.sum(views * directions, axis=1), -1.0, 1.0))
+    assert np.all(angles <= cone + 1e-9)
+
+    # and they are uniform in solid angle, so half are within this angle
+    half = np.arccos(0.5 * (1.0 + np.cos(cone)))
+    np.testing.assert_allclose(np.mean(angles < half), 0.5, atol=0.06)
@@ -0,0 +1,77 @@
+"""
+Check the binary tau decay tables.
+"""
+import os.path as op
+import apricot
+import numpy as np
+
+
+def test_weighted_decay_table(tmp_path):
+    """
+    Check that decays are sampled with their weights.
+    """
+
+    # four decays with increasing weights
+    states = [[0.1 * i, 0.0, 0.0, 1.0 - 0.1 * i, 0.0, 0.0] for i in range(4)]
+    weights = [1.0, 2.0, 3.0, 4.0]
+
+    # write and load the table
+    filename = op.join(str(tmp_path), "decays.bin")
+    apricot.TauDecayTable.write(filename, states, weights)
+    table = apricot.TauDecayTable(filename)
+    assert len(table) == 4
+
+    # sample many decays
+    apricot.seed(1)
+    samples = np.asarray([table.random_final_state().nu_tau for _ in range(40000)])
+
+    # and check the frequency of each decay
+    for i, weight in enumerate(weights):
+        frequency = np.mean(np.isclose(samples, 0.1 * i))
+        np.testing.assert_allclose(frequency, weight / np.sum(weights), atol=0.01)
+
+
+def test_binned_decay_table(tmp_path):
+    """
+    Check that decays are sampled from the bin of the tau.
+    """
+
+    # one decay in each energy and polarization bin
+    states = [[0.0, 0.0, 0.0, b, 0.0, 0.0] for b in range(4)]
+    energies = [17.0, 17.0, 19.0, 19.0]
+    polarizations = [-0.5, 0.5, -0.5, 0.5]
+    binning = apricot.TauDecayBinning(2, 16.0, 20.0, 2)
+
+    # write and load the table
+    filename = op.join(str(tmp_path), "binned.bin")
+    apricot.TauDecayTable.write(filename, states, [], energies, polarizations, binning)
+    table = apricot.TauDecayTable(filename)
+    assert table.binning.nenergies == 2
+    assert table.binning.npolarizations == 2
+
+    # and check that each bin gives its own decay
+    assert table.random_final_state(17.5, -1.0).hadronic == 0.0
+    assert table.random_final_state(17.5, 1.0).hadronic == 1.0
+    assert table.random_final_state(19.5, -1.0).hadronic == 2.0
+    assert table.random_final_state(19.5, 1.0).hadronic == 3.0
+
+
+def test_convert_text_table(tmp_path):
+    """
+    Check that NuTauSim text tables can be converted.
+    """
+
+    # a small NuTauSim table with its header line
+    text = op.join(str(tmp_path), "decays.dat")
+    with open(text, "w") as f:
+        f.write("2 6\n0.5 0.1 0.1 0.2 0.05 0.05\n0.4 0.0 0.0 0.6 0.0 0.0\n")
+
+    # convert it to a binary table
+    binary = op.join(str(tmp_path), "decays.bin")
+    apricot.TauDecayTable.convert(text, binary)
+
+    # and both tables have the same decays
+    assert len(apricot.TauDecayTable(text)) == 2
+    assert len(apricot.TauDecayTable(binary)) == 2
+    decay = apricot.TauDecayTable(binary).random_final_state()
+    assert np.isclose(decay.nu_tau, 0.5) or np.isclose(decay.nu_tau, 0.4)
@@ -0,0 +1,70 @@
+"""
+Check the tau exit tables and the table-driven propagator.
+"""
+import os.path as op
+import apricot
+import numpy as np
+
+
+def test_tau_exit_table(tmp_path):
+    """
+    Check that I can generate, save, and load tau exit tables.
+    """
+
+    # use a simple spherical Earth model
+    earth = apricot.SphericalEarth(apricot.SphericalEarth.polar_radius)
+
+    # generate a small table
+    apricot.seed(1)
+    table = apricot.TauExitTable(earth, 17.0, 20.0, 4, [1.0, 5.0, 20.0], 500)
+
+    # the exit probability is a probability
+    energies, angles = np.meshgrid(np.linspace(16.0, 21.0, 11), np.linspace(0.5, 30.0, 11))
+    probability = table.probability(energies, angles)
+    assert np.all(probability >= 0.0) and np.all(probability <= 1.0)
+
+    # and taus exit along short chords at high energies
+    assert table.probability(20.0, 1.0) > 0.0
+
+    # exiting taus have less energy than the neutrino
+    for _ in range(1000):
+        energy = table.sample(20.0, 1.0)
+        assert energy is None or energy < 20.0
+
+    # check that the table survives a round trip through a file
+    filename = op.join(str(tmp_path), "tauexit.bin")
+    table.save(filename)
+    loaded = apricot.TauExitTable(filename)
+    assert loaded.nenergies == table.nenergies
+    np.testing.assert_allclose(loaded.angles, table.angles)
+    np.testing.assert_allclose(
+        loaded.probability(energies, angles), table.probability(energies, angles)
+    )
+
+
+def test_tau_exit_propagator():
+    """
+    Check that the table-driven propagator only creates tau decays.
+    """
+
+    # use a simple spherical Earth model
+    Re = apricot.SphericalEarth.polar_radius
+    earth = apricot.SphericalEarth(Re)
+
+    # a small table at high energies
+    table = apricot.TauExitTable(earth, 19.0, 20.0, 2, [1.0, 10.0, 30.0], 500)
+
+    # throw tau neutrinos from a cap 100 km above the surface
+    source = apricot.SphericalCapSource(radius=Re + 100.0)
+    flux = apricot.FixedTauNeutrinoFlux(20.0)
+    detector = apricot.PerfectDetector()
+
+    # and propagate some particles
+    propagator = apricot.TauExitPropagator(earth, table)
+    interactions = propagator.propagate(source, flux, detector, 2000)
+
+    # every interaction is a tau decay above the surface
+    for event in interactions:
+        for interaction in event:
+            assert abs(interaction.pdgid) == 15
+            assert interaction.altitude > 0.0
@@ -62,3 +62,42 @@ def test_plot_shower_max():
 
     # and save the plot
     fig.savefig(f"{op.dirname(__file__)}/figures/uhecr_xmax.pdf")
+
+
+def test_sample_shower_max(tmp_path):
+    """
+    Check that Xmax is sampled with the mean and RMS of each species.
+    """
+
+    # the species and the RMS of their Xmax
+    species = [
+        (apricot.Proton, 57.0),
+        (apricot.Helium, 42.0),
+        (apricot.Nitrogen, 28.0),
+        (apricot.Iron, 20.0),
+        (apricot.MixedUHECR, 50.0),
+    ]
+
+    # sample many showers for each species
+    apricot.seed(1)
+    for particle, sigma in species:
+        xmax = particle.sample_Xmax(np.full(100000, 19.2))
+
+        # and check the moments of their distribution
+        np.testing.assert_allclose(np.mean(xmax), particle.get_Xmax(19.2), atol=1.0)
+        np.testing.assert_allclose(np.std(xmax), sigma, rtol=0.02)
+
+        # Gumbel distributions have a long tail to deep showers
+        assert np.mean(xmax) > np.median(xmax)
+
+    # build an empirical distribution from a file of showers
+    filename = op.join(str(tmp_path), "showers.dat")
+    with open(filename, "w") as f:
+        f.write("# energy Xmax\n19.0 700.0\n19.0 720.0\n19.0 740.0\n20.0 800.0\n")
+    distribution = apricot.XmaxDistribution(filename)
+
+    # and check that it is interpolated in energy
+    np.testing.assert_allclose(distribution.energies, [19.0, 20.0])
+    np.testing.assert_allclose(distribution.quantile(19.0, 0.5), 720.0)
+    np.testing.assert_allclose(distribution.quantile(19.5, 0.5), 760.0)
+    assert np.all(distribution.sample(np.full(1000, 20.0)) == 800.0)